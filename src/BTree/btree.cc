@@ -0,0 +1,944 @@
+#ifndef BTREE_CC
+#define BTREE_CC
+
+#include "btree.h"
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::btree() : root(nullptr), count(0) {}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::btree(const Compare& compare)
+    : root(nullptr), count(0), comp(compare) {}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::btree(std::initializer_list<T> init_list)
+    : btree(init_list.begin(), init_list.end()) {}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename InputIt, typename>
+btree<T, Compare, NodeBytes>::btree(InputIt first, InputIt last)
+    : root(nullptr), count(0) {
+  typedef typename std::iterator_traits<InputIt>::iterator_category category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    if (std::is_sorted(first, last, comp)) {
+      buildSorted(first, last);
+      return;
+    }
+  }
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::btree(const btree& other)
+    : root(nullptr), count(0), comp(other.comp) {
+  buildSorted(other.cbegin(), other.cend());
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::btree(btree&& other) noexcept
+    : root(other.root),
+      leaves(std::move(other.leaves)),
+      internals(std::move(other.internals)),
+      count(other.count),
+      comp(other.comp) {
+  other.root = nullptr;
+  other.count = 0;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::~btree() {
+  clear();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>& btree<T, Compare, NodeBytes>::operator=(
+    const btree& other) {
+  if (this != &other) {
+    btree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>& btree<T, Compare, NodeBytes>::operator=(
+    btree&& other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename ForwardIt>
+btree<T, Compare, NodeBytes> btree<T, Compare, NodeBytes>::from_sorted(
+    ForwardIt first, ForwardIt last, const Compare& compare) {
+  btree tree(compare);
+  tree.buildSorted(first, last);
+  return tree;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename ForwardIt>
+void btree<T, Compare, NodeBytes>::assign_sorted(ForwardIt first,
+                                                 ForwardIt last) {
+  btree tree(comp);
+  tree.buildSorted(first, last);
+  swap(tree);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Pred>
+std::size_t btree<T, Compare, NodeBytes>::partitionPoint(const T* keys,
+                                                         std::size_t n,
+                                                         Pred pred) {
+  if (n == 0) return 0;
+  const T* base = keys;
+  while (n > 1) {
+    std::size_t half = n / 2;
+    base = pred(base[half]) ? base + half : base;
+    n -= half;
+  }
+  return static_cast<std::size_t>(base - keys) + (pred(*base) ? 1 : 0);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key>
+typename btree<T, Compare, NodeBytes>::Position
+btree<T, Compare, NodeBytes>::lowerPosition(const Key& key) const {
+  Position result{nullptr, 0};
+  auto less = [this, &key](const T& item) { return comp(item, key); };
+  for (Node* node = root; node;) {
+    std::size_t i = partitionPoint(node->keys(), node->count, less);
+    if (i < node->count) result = {node, i};
+    node = node->leaf ? nullptr : child(node, i);
+  }
+  return result;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename Fn>
+void btree<T, Compare, NodeBytes>::lowerPositionsBatch(const Key* keys,
+                                                       size_t n,
+                                                       Fn fn) const {
+  Node* cursor[kBatchLanes];
+  Position result[kBatchLanes];
+  for (size_t base = 0; base < n; base += kBatchLanes) {
+    const Key* group = keys + base;
+    size_t lanes = std::min(kBatchLanes, n - base);
+    for (size_t i = 0; i < lanes; ++i) {
+      cursor[i] = root;
+      result[i] = {nullptr, 0};
+    }
+    for (bool moving = root != nullptr; moving;) {
+      moving = false;
+      for (size_t i = 0; i < lanes; ++i) {
+        Node* node = cursor[i];
+        if (!node) continue;
+        const Key& key = group[i];
+        std::size_t index =
+            partitionPoint(node->keys(), node->count,
+                           [this, &key](const T& item) {
+                             return comp(item, key);
+                           });
+        if (index < node->count) result[i] = {node, index};
+        node = node->leaf ? nullptr : child(node, index);
+        cursor[i] = node;
+        if (node) {
+          // Двоичный поиск трогает строки по всему узлу
+          prefetchForRead(node, sizeof(Node));
+          moving = true;
+        }
+      }
+    }
+    for (size_t i = 0; i < lanes; ++i) fn(base + i, result[i]);
+  }
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key>
+typename btree<T, Compare, NodeBytes>::Position
+btree<T, Compare, NodeBytes>::upperPosition(const Key& key) const {
+  Position result{nullptr, 0};
+  auto notGreater = [this, &key](const T& item) { return !comp(key, item); };
+  for (Node* node = root; node;) {
+    std::size_t i = partitionPoint(node->keys(), node->count, notGreater);
+    if (i < node->count) result = {node, i};
+    node = node->leaf ? nullptr : child(node, i);
+  }
+  return result;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key>
+typename btree<T, Compare, NodeBytes>::Position
+btree<T, Compare, NodeBytes>::findPosition(const Key& key) const {
+  Position pos = lowerPosition(key);
+  if (pos.node && comp(key, pos.node->keys()[pos.index])) return {nullptr, 0};
+  return pos;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::advance(Position& pos) {
+  Node* node = pos.node;
+  if (!node->leaf) {
+    node = child(node, pos.index + 1);
+    while (!node->leaf) node = child(node, 0);
+    pos = {node, 0};
+    return;
+  }
+  if (++pos.index < node->count) return;
+  while (node->parent && node->position == node->parent->count) {
+    node = node->parent;
+  }
+  pos = {node->parent, node->position};
+  if (!pos.node) pos.index = 0;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::Node*
+btree<T, Compare, NodeBytes>::newLeaf() {
+  return leaves.create(true);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::Internal*
+btree<T, Compare, NodeBytes>::newInternal() {
+  return internals.create();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::freeNode(Node* node) {
+  if (node->leaf)
+    leaves.destroy(node);
+  else
+    internals.destroy(static_cast<Internal*>(node));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::destroySubtree(Node* node) {
+  for (std::size_t i = 0; i < node->count; ++i) node->keys()[i].~T();
+  if (!node->leaf) {
+    for (std::size_t i = 0; i <= node->count; ++i) {
+      destroySubtree(child(node, i));
+    }
+  }
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::relocate(T& from, T* to) {
+  new (to) T(std::move(from));
+  from.~T();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::setChild(Internal* parent, std::size_t i,
+                                            Node* node) {
+  parent->children[i] = node;
+  node->parent = parent;
+  node->position = static_cast<unsigned char>(i);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::shiftRight(Node* node, std::size_t from) {
+  // Освобождает слот from; у внутреннего узла сдвигаются и дети после него
+  T* keys = node->keys();
+  for (std::size_t i = node->count; i > from; --i) {
+    relocate(keys[i - 1], &keys[i]);
+  }
+  if (!node->leaf) {
+    Internal* internal = static_cast<Internal*>(node);
+    for (std::size_t i = node->count + 1; i > from + 1; --i) {
+      setChild(internal, i, internal->children[i - 1]);
+    }
+  }
+  ++node->count;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::shiftLeft(Node* node, std::size_t from) {
+  // Закрывает пустой слот from и ребёнка from + 1
+  T* keys = node->keys();
+  for (std::size_t i = from + 1; i < node->count; ++i) {
+    relocate(keys[i], &keys[i - 1]);
+  }
+  if (!node->leaf) {
+    Internal* internal = static_cast<Internal*>(node);
+    for (std::size_t i = from + 1; i < node->count; ++i) {
+      setChild(internal, i, internal->children[i + 1]);
+    }
+  }
+  --node->count;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::splitChild(Internal* parent,
+                                              std::size_t i) {
+  // Полный ребёнок делится пополам, средний элемент поднимается в parent
+  Node* full = parent->children[i];
+  Node* sibling = full->leaf ? newLeaf() : newInternal();
+  T* keys = full->keys();
+  for (std::size_t j = kMinKeys + 1; j < kMaxKeys; ++j) {
+    relocate(keys[j], &sibling->keys()[j - kMinKeys - 1]);
+  }
+  if (!full->leaf) {
+    for (std::size_t j = kMinKeys + 1; j <= kMaxKeys; ++j) {
+      setChild(static_cast<Internal*>(sibling), j - kMinKeys - 1,
+               child(full, j));
+    }
+  }
+  sibling->count = kMinKeys;
+  full->count = kMinKeys;
+  shiftRight(parent, i);
+  relocate(keys[kMinKeys], &parent->keys()[i]);
+  setChild(parent, i + 1, sibling);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename V>
+typename btree<T, Compare, NodeBytes>::Position
+btree<T, Compare, NodeBytes>::emplace(V&& value) {
+  // Спуск с упреждающим расщеплением полных узлов: до листа доходим,
+  // когда в нём уже есть место. Новый элемент встаёт после равных
+  if (!root) root = newLeaf();
+  if (root->count == kMaxKeys) {
+    Internal* top = newInternal();
+    setChild(top, 0, root);
+    root = top;
+    splitChild(top, 0);
+  }
+  auto notGreater = [this, &value](const T& item) {
+    return !comp(value, item);
+  };
+  Node* node = root;
+  for (;;) {
+    std::size_t i = partitionPoint(node->keys(), node->count, notGreater);
+    if (node->leaf) {
+      shiftRight(node, i);
+      try {
+        new (&node->keys()[i]) T(std::forward<V>(value));
+      } catch (...) {
+        shiftLeft(node, i);
+        throw;
+      }
+      ++count;
+      return {node, i};
+    }
+    if (child(node, i)->count == kMaxKeys) {
+      splitChild(static_cast<Internal*>(node), i);
+      if (notGreater(node->keys()[i])) ++i;
+    }
+    node = child(node, i);
+  }
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::Position
+btree<T, Compare, NodeBytes>::erasePosition(Position pos) {
+  Node* node = pos.node;
+  Position next;
+  if (!node->leaf) {
+    // Элемент внутреннего узла заменяется следующим за ним из листа
+    Node* leaf = child(node, pos.index + 1);
+    while (!leaf->leaf) leaf = child(leaf, 0);
+    node->keys()[pos.index].~T();
+    relocate(leaf->keys()[0], &node->keys()[pos.index]);
+    shiftLeft(leaf, 0);
+    next = pos;
+    node = leaf;
+  } else {
+    node->keys()[pos.index].~T();
+    shiftLeft(node, pos.index);
+    next = pos;
+    if (next.index == node->count) {
+      // Удалён последний элемент листа: следующий - в предке
+      Node* up = node;
+      while (up->parent && up->position == up->parent->count) {
+        up = up->parent;
+      }
+      next = {up->parent, up->parent ? up->position : std::size_t(0)};
+    }
+  }
+  --count;
+  rebalance(node, next);
+  return next;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::rebalance(Node* node, Position& track) {
+  while (node != root && node->count < kMinKeys) {
+    Internal* parent = node->parent;
+    std::size_t i = node->position;
+    Node* left = i > 0 ? parent->children[i - 1] : nullptr;
+    Node* right = i < parent->count ? parent->children[i + 1] : nullptr;
+    if (left && left->count > kMinKeys) {
+      rotateRight(parent, i - 1, track);
+      return;
+    }
+    if (right && right->count > kMinKeys) {
+      rotateLeft(parent, i, track);
+      return;
+    }
+    mergeChildren(parent, left ? i - 1 : i, track);
+    node = parent;
+  }
+  if (root->count == 0) {
+    // Корень опустел: дерево стало ниже на уровень (или пустым)
+    Node* old = root;
+    root = root->leaf ? nullptr : child(root, 0);
+    if (root) root->parent = nullptr;
+    freeNode(old);
+  }
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::rotateRight(Internal* parent,
+                                               std::size_t i,
+                                               Position& track) {
+  // Последний элемент левого брата уходит в parent, разделитель - в правого
+  Node* left = parent->children[i];
+  Node* right = parent->children[i + 1];
+  std::size_t last = left->count - 1;
+  if (track.node == right) {
+    ++track.index;
+  } else if (track.node == parent && track.index == i) {
+    track = {right, 0};
+  } else if (track.node == left && track.index == last) {
+    track = {parent, i};
+  }
+  shiftRight(right, 0);
+  relocate(parent->keys()[i], &right->keys()[0]);
+  relocate(left->keys()[last], &parent->keys()[i]);
+  if (!left->leaf) {
+    Internal* target = static_cast<Internal*>(right);
+    // shiftRight сдвинул детей после слота 0, первого сдвигаем сами
+    setChild(target, 1, target->children[0]);
+    setChild(target, 0, child(left, last + 1));
+  }
+  left->count = static_cast<unsigned char>(last);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::rotateLeft(Internal* parent, std::size_t i,
+                                              Position& track) {
+  // Первый элемент правого брата уходит в parent, разделитель - в левого
+  Node* left = parent->children[i];
+  Node* right = parent->children[i + 1];
+  std::size_t end = left->count;
+  if (track.node == parent && track.index == i) {
+    track = {left, end};
+  } else if (track.node == right) {
+    if (track.index == 0)
+      track = {parent, i};
+    else
+      --track.index;
+  }
+  relocate(parent->keys()[i], &left->keys()[end]);
+  relocate(right->keys()[0], &parent->keys()[i]);
+  if (!left->leaf) {
+    setChild(static_cast<Internal*>(left), end + 1, child(right, 0));
+    // shiftLeft не трогает ребёнка 0: сдвигаем его вручную
+    setChild(static_cast<Internal*>(right), 0, child(right, 1));
+  }
+  ++left->count;
+  shiftLeft(right, 0);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::mergeChildren(Internal* parent,
+                                                 std::size_t i,
+                                                 Position& track) {
+  // Правый брат и разделитель переезжают в левого брата
+  Node* left = parent->children[i];
+  Node* right = parent->children[i + 1];
+  std::size_t end = left->count;
+  if (track.node == parent && track.index == i) {
+    track = {left, end};
+  } else if (track.node == right) {
+    track = {left, end + 1 + track.index};
+  } else if (track.node == parent && track.index > i) {
+    --track.index;
+  }
+  relocate(parent->keys()[i], &left->keys()[end]);
+  for (std::size_t j = 0; j < right->count; ++j) {
+    relocate(right->keys()[j], &left->keys()[end + 1 + j]);
+  }
+  if (!left->leaf) {
+    for (std::size_t j = 0; j <= right->count; ++j) {
+      setChild(static_cast<Internal*>(left), end + 1 + j, child(right, j));
+    }
+  }
+  left->count = static_cast<unsigned char>(end + 1 + right->count);
+  right->count = 0;
+  freeNode(right);
+  shiftLeft(parent, i);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename InputIt>
+void btree<T, Compare, NodeBytes>::buildSorted(InputIt first, InputIt last) {
+  Node* tail = nullptr;
+  for (; first != last; ++first) tail = appendBack(tail, *first);
+  fixRightEdge();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::Node*
+btree<T, Compare, NodeBytes>::appendBack(Node* tail, const T& value) {
+  // Полные узлы не делятся: value становится разделителем в ближайшем
+  // предке с местом, а справа от него начинается новая пустая ветка.
+  // Недозаполненный правый край выравнивает fixRightEdge
+  if (!tail) tail = root = newLeaf();
+  if (tail->count < kMaxKeys) {
+    new (&tail->keys()[tail->count]) T(value);
+    ++tail->count;
+    ++count;
+    return tail;
+  }
+  std::size_t levels = 1;
+  Node* node = tail;
+  while (node->parent && node->parent->count == kMaxKeys) {
+    node = node->parent;
+    ++levels;
+  }
+  Internal* parent = node->parent;
+  if (!parent) {
+    parent = newInternal();
+    setChild(parent, 0, root);
+    root = parent;
+  }
+  // Сначала выделяем ветку, потом копируем value: при исключении дерево
+  // остаётся целым
+  std::vector<Node*> branch;
+  try {
+    for (std::size_t i = 0; i < levels; ++i) {
+      branch.push_back(i + 1 == levels ? newLeaf() : newInternal());
+    }
+    new (&parent->keys()[parent->count]) T(value);
+  } catch (...) {
+    for (Node* fresh : branch) freeNode(fresh);
+    throw;
+  }
+  ++parent->count;
+  ++count;
+  setChild(parent, parent->count, branch[0]);
+  for (std::size_t i = 1; i < levels; ++i) {
+    setChild(static_cast<Internal*>(branch[i - 1]), 0, branch[i]);
+  }
+  return branch.back();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::fixRightEdge() {
+  // Левый брат узла правого края заполнен полностью, поэтому переноса
+  // недостающих элементов через разделитель хватает обоим
+  Position unused{nullptr, 0};
+  for (Node* node = root; node && !node->leaf;) {
+    Node* edge = child(node, node->count);
+    while (edge->count < kMinKeys) {
+      rotateRight(static_cast<Internal*>(node), node->count - 1, unused);
+    }
+    node = edge;
+  }
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::insert(const T& value) {
+  emplace(value);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+std::pair<typename btree<T, Compare, NodeBytes>::iterator, bool>
+btree<T, Compare, NodeBytes>::insertUnique(const T& value) {
+  Position existing = findPosition(value);
+  if (existing.node) return {iterator(existing), false};
+  return {iterator(emplace(value)), true};
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::insert(iterator, const T& value) {
+  // Спуск в 3-4 узла дешевле проверки соседей подсказки
+  return iterator(emplace(value));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+std::pair<typename btree<T, Compare, NodeBytes>::iterator, bool>
+btree<T, Compare, NodeBytes>::insertUnique(iterator, const T& value) {
+  return insertUnique(value);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::erase(const T& key) {
+  Position pos = findPosition(key);
+  if (pos.node) erasePosition(pos);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::erase(iterator pos) {
+  return iterator(erasePosition({pos.node, pos.index}));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::erase(iterator first, iterator last) {
+  // Удаление сдвигает элементы, и last перестаёт указывать куда нужно:
+  // считаем элементы заранее
+  std::size_t n = 0;
+  for (iterator it = first; it != last; ++it) ++n;
+  for (; n > 0; --n) first = erase(first);
+  return first;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+bool btree<T, Compare, NodeBytes>::contains(const T& value) const {
+  return findPosition(value).node != nullptr;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename C, typename>
+bool btree<T, Compare, NodeBytes>::contains(const Key& key) const {
+  return findPosition(key).node != nullptr;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::contains_batch(const T* keys, size_t n,
+                                                  bool* out) const {
+  lowerPositionsBatch(keys, n, [this, keys, out](size_t i, Position pos) {
+    out[i] = pos.node && !comp(keys[i], pos.node->keys()[pos.index]);
+  });
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename OutputIt>
+OutputIt btree<T, Compare, NodeBytes>::find_batch(const T* keys, size_t n,
+                                                  OutputIt out) const {
+  lowerPositionsBatch(keys, n, [this, keys, &out](size_t i, Position pos) {
+    if (pos.node && comp(keys[i], pos.node->keys()[pos.index])) {
+      pos = {nullptr, 0};
+    }
+    *out++ = iterator(pos);
+  });
+  return out;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename C, typename>
+void btree<T, Compare, NodeBytes>::contains_batch(const Key* keys, size_t n,
+                                                  bool* out) const {
+  lowerPositionsBatch(keys, n, [this, keys, out](size_t i, Position pos) {
+    out[i] = pos.node && !comp(keys[i], pos.node->keys()[pos.index]);
+  });
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename OutputIt, typename C, typename>
+OutputIt btree<T, Compare, NodeBytes>::find_batch(const Key* keys, size_t n,
+                                                  OutputIt out) const {
+  lowerPositionsBatch(keys, n, [this, keys, &out](size_t i, Position pos) {
+    if (pos.node && comp(keys[i], pos.node->keys()[pos.index])) {
+      pos = {nullptr, 0};
+    }
+    *out++ = iterator(pos);
+  });
+  return out;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+T btree<T, Compare, NodeBytes>::find(const T& value) {
+  Position pos = findPosition(value);
+  if (!pos.node) throw std::runtime_error("Element not found");
+  return pos.node->keys()[pos.index];
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::lookup(const T& key) const {
+  return iterator(findPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::lookup(iterator, const T& key) const {
+  return iterator(findPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename C, typename>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::lookup(const Key& key) const {
+  return iterator(findPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename C, typename>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::lookup(iterator, const Key& key) const {
+  return iterator(findPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::lower_bound(const T& key) const {
+  return iterator(lowerPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::upper_bound(const T& key) const {
+  return iterator(upperPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+std::pair<typename btree<T, Compare, NodeBytes>::iterator,
+          typename btree<T, Compare, NodeBytes>::iterator>
+btree<T, Compare, NodeBytes>::equal_range(const T& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename C, typename>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::lower_bound(const Key& key) const {
+  return iterator(lowerPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename C, typename>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::upper_bound(const Key& key) const {
+  return iterator(upperPosition(key));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename C, typename>
+std::pair<typename btree<T, Compare, NodeBytes>::iterator,
+          typename btree<T, Compare, NodeBytes>::iterator>
+btree<T, Compare, NodeBytes>::equal_range(const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Fn>
+void btree<T, Compare, NodeBytes>::for_each_in_range(const T& lo, const T& hi,
+                                                     Fn fn) const {
+  for (Position pos = lowerPosition(lo);
+       pos.node && comp(pos.node->keys()[pos.index], hi); advance(pos)) {
+    fn(pos.node->keys()[pos.index]);
+  }
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+template <typename Key, typename Fn, typename C, typename>
+void btree<T, Compare, NodeBytes>::for_each_in_range(const Key& lo,
+                                                     const Key& hi,
+                                                     Fn fn) const {
+  for (Position pos = lowerPosition(lo);
+       pos.node && comp(pos.node->keys()[pos.index], hi); advance(pos)) {
+    fn(pos.node->keys()[pos.index]);
+  }
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::node_type
+btree<T, Compare, NodeBytes>::extract(iterator pos) {
+  node_type handle(std::move(*pos));
+  erase(pos);
+  return handle;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::node_type
+btree<T, Compare, NodeBytes>::extract(const T& key) {
+  Position pos = findPosition(key);
+  if (!pos.node) return node_type();
+  return extract(iterator(pos));
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::insert(node_type&& handle) {
+  if (handle.empty()) return end();
+  iterator result(emplace(std::move(*handle.item)));
+  handle.item.reset();
+  return result;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+std::pair<typename btree<T, Compare, NodeBytes>::iterator, bool>
+btree<T, Compare, NodeBytes>::insertUnique(node_type&& handle) {
+  if (handle.empty()) return {end(), false};
+  Position existing = findPosition(*handle.item);
+  if (existing.node) return {iterator(existing), false};
+  iterator result(emplace(std::move(*handle.item)));
+  handle.item.reset();
+  return {result, true};
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::merge(btree& other) {
+  if (this == &other) return;
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    emplace(std::move(*it));
+  }
+  other.clear();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::mergeUnique(btree& other) {
+  if (this == &other || other.empty()) return;
+  std::vector<T> kept;
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    if (contains(*it))
+      kept.push_back(std::move(*it));
+    else
+      emplace(std::move(*it));
+  }
+  other.clear();
+  other.buildSorted(kept.begin(), kept.end());
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+bool btree<T, Compare, NodeBytes>::isBTree() const {
+  size_t seen = 0;
+  if (root && root->parent) return false;
+  return (!root || checkSubtree(root, nullptr, nullptr, seen) >= 0) &&
+         seen == count;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+int btree<T, Compare, NodeBytes>::checkSubtree(const Node* node, const T* lo,
+                                               const T* hi,
+                                               size_t& seen) const {
+  // Возвращает высоту поддерева или -1; lo и hi - разделители над ним
+  if (node->count > kMaxKeys) return -1;
+  if (node != root && node->count < kMinKeys) return -1;
+  if (node == root && node->count == 0) return -1;
+  const T* keys = node->keys();
+  for (std::size_t i = 0; i < node->count; ++i) {
+    if (lo && comp(keys[i], *lo)) return -1;
+    if (hi && comp(*hi, keys[i])) return -1;
+    if (i > 0 && comp(keys[i], keys[i - 1])) return -1;
+  }
+  seen += node->count;
+  if (node->leaf) return 0;
+  int height = -1;
+  for (std::size_t i = 0; i <= node->count; ++i) {
+    const Node* next = static_cast<const Internal*>(node)->children[i];
+    if (next->parent != node || next->position != i) return -1;
+    int h = checkSubtree(next, i > 0 ? &keys[i - 1] : lo,
+                         i < node->count ? &keys[i] : hi, seen);
+    if (h < 0 || (height >= 0 && h != height)) return -1;
+    height = h;
+  }
+  return height + 1;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::clear() {
+  if (root && !std::is_trivially_destructible<T>::value) destroySubtree(root);
+  root = nullptr;
+  count = 0;
+  leaves.release();
+  internals.release();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+bool btree<T, Compare, NodeBytes>::empty() const {
+  return count == 0;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+size_t btree<T, Compare, NodeBytes>::size() const {
+  return count;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+size_t btree<T, Compare, NodeBytes>::max_size() const {
+  return std::numeric_limits<size_t>::max();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::swap(btree& other) {
+  std::swap(root, other.root);
+  std::swap(count, other.count);
+  std::swap(comp, other.comp);
+  leaves.swap(other.leaves);
+  internals.swap(other.internals);
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+bool btree<T, Compare, NodeBytes>::operator==(const btree& other) const {
+  if (count != other.count) return false;
+  auto it = cbegin(), other_it = other.cbegin();
+  for (; it != cend(); ++it, ++other_it) {
+    if (!(*it == *other_it)) return false;
+  }
+  return true;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+T btree<T, Compare, NodeBytes>::GetMin() const {
+  if (!root) throw std::runtime_error("Tree is empty");
+  return *begin();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+T btree<T, Compare, NodeBytes>::GetMax() const {
+  if (!root) throw std::runtime_error("Tree is empty");
+  Node* node = root;
+  while (!node->leaf) node = child(node, node->count);
+  return node->keys()[node->count - 1];
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator&
+btree<T, Compare, NodeBytes>::iterator::operator++() {
+  if (!node) return *this;
+  Position pos{node, index};
+  advance(pos);
+  node = pos.node;
+  index = pos.index;
+  return *this;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::const_iterator&
+btree<T, Compare, NodeBytes>::const_iterator::operator++() {
+  if (!node) return *this;
+  Position pos{node, index};
+  advance(pos);
+  node = pos.node;
+  index = pos.index;
+  return *this;
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::begin() const {
+  Node* node = root;
+  while (node && !node->leaf) node = child(node, 0);
+  return iterator(Position{node, 0});
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::end() const {
+  return iterator();
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::const_iterator
+btree<T, Compare, NodeBytes>::cbegin() const {
+  return const_iterator(begin());
+}
+
+template <typename T, typename Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::const_iterator
+btree<T, Compare, NodeBytes>::cend() const {
+  return const_iterator();
+}
+
+#endif
@@ -0,0 +1,321 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../RBTree/Augmentation.h"
+#include "../RBTree/NodePool.h"
+#include "../RBTree/Prefetch.h"
+
+// B-дерево с интерфейсом RedBlackTree: в узле лежит до kMaxKeys элементов
+// подряд, поэтому поиск проходит 3-4 узла вместо ~25 разрозненных, а внутри
+// узла идёт двоичным поиском без ветвлений на результатах сравнений.
+// NodeBytes - примерный размер узла; элементов в узле от 3 до 127.
+//
+// Отличия от RedBlackTree: вставка и удаление делают недействительными
+// итераторы (элементы переезжают между узлами), node_type хранит сам
+// элемент, а не узел, подсказки в insert/lookup не используются.
+// Порядковые статистики, операции над множествами, join и split не
+// поддерживаются.
+template <typename T, typename Compare = std::less<T>,
+          std::size_t NodeBytes = 256>
+class btree {
+ private:
+  static constexpr std::size_t kHeaderBytes = 16;
+  static constexpr std::size_t kFitKeys =
+      NodeBytes > kHeaderBytes ? (NodeBytes - kHeaderBytes) / sizeof(T) : 0;
+  // Нечётное число: при расщеплении полного узла обе половины минимальны
+  static constexpr std::size_t kMaxKeys =
+      kFitKeys < 3     ? 3
+      : kFitKeys > 127 ? 127
+                       : kFitKeys - (kFitKeys % 2 == 0 ? 1 : 0);
+  static constexpr std::size_t kMinKeys = kMaxKeys / 2;
+
+  struct Internal;
+
+  struct Node {
+    Internal* parent;
+    unsigned char position;  // индекс узла среди детей parent
+    unsigned char count;
+    bool leaf;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type
+        slots[kMaxKeys];
+
+    explicit Node(bool leaf)
+        : parent(nullptr), position(0), count(0), leaf(leaf) {}
+
+    T* keys() { return std::launder(reinterpret_cast<T*>(slots)); }
+    const T* keys() const {
+      return std::launder(reinterpret_cast<const T*>(slots));
+    }
+  };
+
+  struct Internal : Node {
+    Node* children[kMaxKeys + 1];
+
+    Internal() : Node(false) {}
+  };
+
+  // Элемент внутри дерева: узел и индекс в нём
+  struct Position {
+    Node* node;
+    std::size_t index;
+  };
+
+  Node* root;
+  NodePool<Node> leaves;
+  NodePool<Internal> internals;
+  size_t count;
+  Compare comp;
+
+  static Node*& child(Node* node, std::size_t i) {
+    return static_cast<Internal*>(node)->children[i];
+  }
+  // Первый индекс, на котором pred ложен. Вместо ветвления на каждом
+  // сравнении - выбор указателя, который компилятор делает через cmov
+  template <typename Pred>
+  static std::size_t partitionPoint(const T* keys, std::size_t n, Pred pred);
+  template <typename Key>
+  Position lowerPosition(const Key& key) const;
+  // lowerPosition для каждого из n ключей, fn(i, pos) - по порядку ключей
+  template <typename Key, typename Fn>
+  void lowerPositionsBatch(const Key* keys, size_t n, Fn fn) const;
+  template <typename Key>
+  Position upperPosition(const Key& key) const;
+  template <typename Key>
+  Position findPosition(const Key& key) const;
+  static void advance(Position& pos);
+
+  Node* newLeaf();
+  Internal* newInternal();
+  void freeNode(Node* node);
+  void destroySubtree(Node* node);
+  static void relocate(T& from, T* to);
+  static void setChild(Internal* parent, std::size_t i, Node* node);
+  static void shiftRight(Node* node, std::size_t from);
+  static void shiftLeft(Node* node, std::size_t from);
+
+  void splitChild(Internal* parent, std::size_t i);
+  template <typename V>
+  Position emplace(V&& value);
+  Position erasePosition(Position pos);
+  // Восстанавливает заполненность узлов от node вверх; track - позиция,
+  // которую надо сохранить, пока элементы переезжают
+  void rebalance(Node* node, Position& track);
+  static void rotateRight(Internal* parent, std::size_t i, Position& track);
+  static void rotateLeft(Internal* parent, std::size_t i, Position& track);
+  void mergeChildren(Internal* parent, std::size_t i, Position& track);
+
+  // Сборка пустого дерева из упорядоченной последовательности за O(n):
+  // элементы дописываются в правый край, затем правый край выравнивается
+  template <typename InputIt>
+  void buildSorted(InputIt first, InputIt last);
+  Node* appendBack(Node* tail, const T& value);
+  void fixRightEdge();
+  int checkSubtree(const Node* node, const T* lo, const T* hi,
+                   size_t& seen) const;
+
+ public:
+  class iterator;
+  class const_iterator;
+
+  // Вынутый элемент: сам объект, перемещённый из дерева
+  class node_type {
+   private:
+    mutable std::optional<T> item;
+
+    friend class btree;
+
+    explicit node_type(T&& value) : item(std::move(value)) {}
+
+   public:
+    node_type() = default;
+    node_type(node_type&& other) noexcept : item(std::move(other.item)) {
+      other.item.reset();
+    }
+    node_type& operator=(node_type&& other) noexcept {
+      if (this != &other) {
+        item = std::move(other.item);
+        other.item.reset();
+      }
+      return *this;
+    }
+    node_type(const node_type&) = delete;
+    node_type& operator=(const node_type&) = delete;
+
+    bool empty() const { return !item; }
+    explicit operator bool() const { return item.has_value(); }
+    T& value() const { return *item; }
+  };
+
+  btree();
+  explicit btree(const Compare& compare);
+  btree(std::initializer_list<T> init_list);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree(InputIt first, InputIt last);
+  btree(const btree& other);
+  btree(btree&& other) noexcept;
+  ~btree();
+
+  btree& operator=(const btree& other);
+  btree& operator=(btree&& other) noexcept;
+
+  template <typename ForwardIt>
+  static btree from_sorted(ForwardIt first, ForwardIt last,
+                           const Compare& compare = Compare());
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
+
+  void insert(const T& value);
+  std::pair<iterator, bool> insertUnique(const T& value);
+  iterator insert(iterator hint, const T& value);
+  std::pair<iterator, bool> insertUnique(iterator hint, const T& value);
+  void erase(const T& key);
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  bool contains(const T& value) const;
+  T find(const T& value);
+  iterator lookup(const T& key) const;
+  iterator lookup(iterator hint, const T& key) const;
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lookup(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lookup(iterator hint, const Key& key) const;
+
+  // Пакетный поиск, как в RedBlackTree: спуски kBatchLanes ключей идут
+  // вперемешку, следующий узел каждого запрашивается заранее целиком
+  void contains_batch(const T* keys, size_t n, bool* out) const;
+  template <typename OutputIt>
+  OutputIt find_batch(const T* keys, size_t n, OutputIt out) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  void contains_batch(const Key* keys, size_t n, bool* out) const;
+  template <typename Key, typename OutputIt, typename C = Compare,
+            typename = typename C::is_transparent>
+  OutputIt find_batch(const Key* keys, size_t n, OutputIt out) const;
+
+  iterator lower_bound(const T& key) const;
+  iterator upper_bound(const T& key) const;
+  std::pair<iterator, iterator> equal_range(const T& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const Key& key) const;
+
+  template <typename Fn>
+  void for_each_in_range(const T& lo, const T& hi, Fn fn) const;
+  template <typename Key, typename Fn, typename C = Compare,
+            typename = typename C::is_transparent>
+  void for_each_in_range(const Key& lo, const Key& hi, Fn fn) const;
+
+  // Элемент переезжает без копирования; insertUnique(handle) при
+  // совпадении ключа оставляет элемент в handle
+  node_type extract(iterator pos);
+  node_type extract(const T& key);
+  iterator insert(node_type&& handle);
+  std::pair<iterator, bool> insertUnique(node_type&& handle);
+  void merge(btree& other);
+  void mergeUnique(btree& other);
+
+  // Проверяет упорядоченность, заполненность узлов, одинаковую глубину
+  // листьев и связи с родителями
+  bool isBTree() const;
+
+  void clear();
+  bool empty() const;
+  size_t size() const;
+  size_t max_size() const;
+  const Compare& value_comp() const { return comp; }
+  void swap(btree& other);
+  bool operator==(const btree& other) const;
+  T GetMin() const;
+  T GetMax() const;
+
+  class iterator {
+   private:
+    Node* node;
+    std::size_t index;
+
+    friend class btree;
+    friend class const_iterator;
+
+    iterator(Position pos) : node(pos.node), index(pos.index) {}
+
+   public:
+    iterator() : node(nullptr), index(0) {}
+    T& operator*() const { return node->keys()[index]; }
+    T* operator->() const { return &node->keys()[index]; }
+    iterator& operator++();
+    bool operator==(const iterator& other) const {
+      return node == other.node && index == other.index;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+  };
+
+  iterator begin() const;
+  iterator end() const;
+
+  class const_iterator {
+   private:
+    Node* node;
+    std::size_t index;
+
+   public:
+    const_iterator() : node(nullptr), index(0) {}
+    const_iterator(const iterator& it) : node(it.node), index(it.index) {}
+    const T& operator*() const { return node->keys()[index]; }
+    const T* operator->() const { return &node->keys()[index]; }
+    const_iterator& operator++();
+    bool operator==(const const_iterator& other) const {
+      return node == other.node && index == other.index;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+  };
+
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+};
+
+// Выбирает btree как дерево s21_set, s21_multiset и s21_map:
+// s21::s21_set<int, std::less<int>, NoAugmentation, BTreeBackend<>>
+template <std::size_t NodeBytes = 256>
+struct BTreeBackend {
+  template <typename T, typename Compare, typename Augment>
+  struct select {
+    static_assert(std::is_same<Augment, NoAugmentation>::value,
+                  "btree does not support augmentation");
+    typedef btree<T, Compare, NodeBytes> type;
+  };
+
+  template <typename T, typename Compare, typename Augment>
+  using tree = typename select<T, Compare, Augment>::type;
+};
+
+#include "btree.cc"
+
+#endif  // BTREE_H
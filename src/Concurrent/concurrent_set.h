@@ -0,0 +1,232 @@
+#ifndef CONCURRENT_SET_H
+#define CONCURRENT_SET_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../Persistent/persistent_set.h"
+#include "../RBTree/Hardware.h"
+
+namespace s21 {
+
+namespace detail {
+
+// Номер ячейки читателя для текущего потока: потоки получают ячейки по
+// кругу, так что до kReaderSlots потоков ни одна ячейка не делится
+inline std::size_t reader_slot_index() {
+  static std::atomic<std::size_t> next{0};
+  thread_local std::size_t index =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+}  // namespace detail
+
+// Упорядоченное множество для нагрузки "много читателей, редкие записи"
+// по схеме RCU. Текущая версия - неизменяемый persistent_set, на который
+// указывает атомарный указатель. Читатель не берёт блокировок и не трогает
+// общих счётчиков ссылок: он отмечается в своей ячейке (у каждого потока
+// своя кеш-линия), читает опубликованную версию и снимает отметку.
+// Писатель строит новую версию копированием пути за O(log n), публикует
+// её одной атомарной записью, а старые версии откладывает. Отложенные
+// версии удаляются после периода ожидания - когда все читатели, которые
+// могли их видеть, вышли. Узлы, общие со свежей версией, при этом живут.
+//
+// Писатели сериализуются мьютексом, читателей он не касается.
+// Удалять множество можно только когда читателей не осталось.
+template <typename T, typename Compare = std::less<T>>
+class concurrent_set {
+ public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+  typedef persistent_set<T, Compare> snapshot_type;
+
+  concurrent_set() : concurrent_set(snapshot_type()) {}
+  explicit concurrent_set(snapshot_type initial);
+  ~concurrent_set();
+
+  concurrent_set(const concurrent_set&) = delete;
+  concurrent_set& operator=(const concurrent_set&) = delete;
+
+  // Чтение: без блокировок, из любого числа потоков
+  bool contains(const T& value) const;
+  size_type size() const;
+  bool empty() const { return size() == 0; }
+  // Вызывает fn(const snapshot_type&) на текущей версии и возвращает
+  // результат; все чтения внутри fn видят одну и ту же версию. Ссылку
+  // нельзя сохранять после выхода из fn. Внутри fn нельзя вызывать
+  // insert, erase, update и synchronize этого же множества: период
+  // ожидания ждал бы выхода самого вызывающего читателя, и поток завис бы
+  // навсегда. Чтобы писать по прочитанному, возьмите snapshot()
+  template <typename Fn>
+  auto read(Fn fn) const -> decltype(fn(std::declval<const snapshot_type&>()));
+  // Копия текущей версии, которую можно держать сколько угодно; стоит
+  // одного атомарного увеличения счётчика ссылок корня
+  snapshot_type snapshot() const;
+
+  // Запись: каждая публикует новую версию. Возвращают false, если
+  // множество не изменилось
+  bool insert(const T& value);
+  bool erase(const T& value);
+  // Несколько изменений одной публикацией: fn получает текущую версию и
+  // возвращает следующую
+  template <typename Fn>
+  void update(Fn fn);
+
+  // Дожидается выхода читателей старых версий и удаляет их. Вызывается
+  // сам, когда отложенных версий набирается kRetireBatch
+  void synchronize();
+
+ private:
+  static constexpr std::size_t kReaderSlots = 64;
+  static constexpr std::size_t kRetireBatch = 32;
+
+  // Счётчики читателей внутри чтения по чётности фазы. Пока писатель
+  // ждёт старую фазу, новые читатели отмечаются в другом счётчике и
+  // ожидание не затягивают
+  struct alignas(detail::kCacheLine) ReaderSlot {
+    std::atomic<std::size_t> active[2] = {{0}, {0}};
+  };
+
+  class ReadGuard {
+   public:
+    explicit ReadGuard(const concurrent_set& set)
+        : slot_(set.slots_[detail::reader_slot_index() % kReaderSlots]) {
+      // Фаза могла смениться между чтением и отметкой: тогда писатель,
+      // возможно, уже не ждёт этот счётчик, и отметка переносится
+      for (;;) {
+        std::size_t phase = set.phase_.load(std::memory_order_seq_cst);
+        counter_ = &slot_.active[phase & 1];
+        counter_->fetch_add(1, std::memory_order_seq_cst);
+        if (set.phase_.load(std::memory_order_seq_cst) == phase) break;
+        counter_->fetch_sub(1, std::memory_order_release);
+      }
+    }
+    ~ReadGuard() { counter_->fetch_sub(1, std::memory_order_release); }
+
+   private:
+    ReaderSlot& slot_;
+    std::atomic<std::size_t>* counter_;
+  };
+
+  // Публикует next и откладывает прежнюю версию; вызывается под write_mutex_
+  void publish(const snapshot_type* next);
+  // Период ожидания и удаление отложенных версий; под write_mutex_
+  void reclaim();
+  const snapshot_type* load() const {
+    return current_.load(std::memory_order_seq_cst);
+  }
+
+  std::atomic<const snapshot_type*> current_;
+  alignas(detail::kCacheLine) std::atomic<std::size_t> phase_;
+  mutable ReaderSlot slots_[kReaderSlots];
+  std::mutex write_mutex_;
+  std::vector<const snapshot_type*> retired_;  // только под write_mutex_
+};
+
+template <typename T, typename Compare>
+concurrent_set<T, Compare>::concurrent_set(snapshot_type initial)
+    : current_(new snapshot_type(std::move(initial))), phase_(0) {}
+
+template <typename T, typename Compare>
+concurrent_set<T, Compare>::~concurrent_set() {
+  delete current_.load(std::memory_order_relaxed);
+  for (const snapshot_type* version : retired_) delete version;
+}
+
+template <typename T, typename Compare>
+bool concurrent_set<T, Compare>::contains(const T& value) const {
+  ReadGuard guard(*this);
+  return load()->contains(value);
+}
+
+template <typename T, typename Compare>
+typename concurrent_set<T, Compare>::size_type
+concurrent_set<T, Compare>::size() const {
+  ReadGuard guard(*this);
+  return load()->size();
+}
+
+template <typename T, typename Compare>
+template <typename Fn>
+auto concurrent_set<T, Compare>::read(Fn fn) const
+    -> decltype(fn(std::declval<const snapshot_type&>())) {
+  ReadGuard guard(*this);
+  return fn(*load());
+}
+
+template <typename T, typename Compare>
+typename concurrent_set<T, Compare>::snapshot_type
+concurrent_set<T, Compare>::snapshot() const {
+  ReadGuard guard(*this);
+  return *load();
+}
+
+template <typename T, typename Compare>
+bool concurrent_set<T, Compare>::insert(const T& value) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const snapshot_type* current = current_.load(std::memory_order_relaxed);
+  snapshot_type next = current->insert(value);
+  if (next.size() == current->size()) return false;
+  publish(new snapshot_type(std::move(next)));
+  return true;
+}
+
+template <typename T, typename Compare>
+bool concurrent_set<T, Compare>::erase(const T& value) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const snapshot_type* current = current_.load(std::memory_order_relaxed);
+  snapshot_type next = current->erase(value);
+  if (next.size() == current->size()) return false;
+  publish(new snapshot_type(std::move(next)));
+  return true;
+}
+
+template <typename T, typename Compare>
+template <typename Fn>
+void concurrent_set<T, Compare>::update(Fn fn) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const snapshot_type* current = current_.load(std::memory_order_relaxed);
+  publish(new snapshot_type(fn(*current)));
+}
+
+template <typename T, typename Compare>
+void concurrent_set<T, Compare>::synchronize() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  reclaim();
+}
+
+template <typename T, typename Compare>
+void concurrent_set<T, Compare>::reclaim() {
+  // Все отложенные версии уже заменены. Читатель, отметившийся в новой
+  // фазе, видит только свежие версии; остаётся дождаться старой фазы
+  std::size_t old_phase = phase_.fetch_add(1, std::memory_order_seq_cst) & 1;
+  for (ReaderSlot& slot : slots_) {
+    for (int spins = 0;
+         slot.active[old_phase].load(std::memory_order_seq_cst) != 0;
+         ++spins) {
+      if (spins < 64) {
+        detail::cpu_relax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+  for (const snapshot_type* version : retired_) delete version;
+  retired_.clear();
+}
+
+template <typename T, typename Compare>
+void concurrent_set<T, Compare>::publish(const snapshot_type* next) {
+  retired_.push_back(current_.exchange(next, std::memory_order_seq_cst));
+  if (retired_.size() >= kRetireBatch) reclaim();
+}
+
+}  // namespace s21
+
+#endif  // CONCURRENT_SET_H
@@ -0,0 +1,627 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Словарь на двух отсортированных std::vector с интерфейсом s21_map:
+// ключи лежат отдельно от значений, поэтому двоичный поиск читает только
+// плотный массив ключей. Как и flat_set, рассчитан на таблицы, которые
+// собирают один раз и потом много читают: вставка одной пары стоит O(n),
+// любое изменение делает итераторы недействительными.
+//
+// Пары в памяти нет, поэтому итератор при разыменовании возвращает
+// reference - пару ссылок first/second, а не value_type&.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class flat_map {
+  static_assert(!std::is_same<Value, bool>::value,
+                "std::vector<bool> has no contiguous storage");
+
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<const Key, Value> value_type;
+  typedef Compare key_compare;
+  typedef std::size_t size_type;
+  typedef std::vector<Key> key_container_type;
+  typedef std::vector<Value> mapped_container_type;
+
+  // Содержимое словаря, отданное extract_sequence
+  struct containers {
+    key_container_type keys;
+    mapped_container_type values;
+  };
+
+ private:
+  template <typename Mapped>
+  class basic_iterator {
+   public:
+    // Разыменование даёт прокси по значению, а не value_type&, поэтому
+    // по правилам стандарта это только итератор ввода, хотя ++ и --
+    // работают как у указателя
+    typedef std::input_iterator_tag iterator_category;
+    typedef std::pair<const Key, Value> value_type;
+    typedef std::ptrdiff_t difference_type;
+    struct reference {
+      const Key& first;
+      Mapped& second;
+    };
+    // operator-> должен вернуть что-то с operator->, а пары нет
+    struct pointer {
+      reference item;
+      const reference* operator->() const { return &item; }
+    };
+
+    basic_iterator() : key_(nullptr), value_(nullptr) {}
+    // iterator превращается в const_iterator
+    template <typename Other, typename = typename std::enable_if<
+                                  std::is_same<const Other, Mapped>::value &&
+                                  !std::is_same<Other, Mapped>::value>::type>
+    basic_iterator(const basic_iterator<Other>& other)
+        : key_(other.key_), value_(other.value_) {}
+
+    reference operator*() const { return {*key_, *value_}; }
+    pointer operator->() const { return {**this}; }
+    basic_iterator& operator++() {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+    basic_iterator& operator--() {
+      --key_;
+      --value_;
+      return *this;
+    }
+    bool operator==(const basic_iterator& other) const {
+      return key_ == other.key_;
+    }
+    bool operator!=(const basic_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    const Key* key_;
+    Mapped* value_;
+
+    friend class flat_map;
+    template <typename>
+    friend class basic_iterator;
+
+    basic_iterator(const Key* key, Mapped* value) : key_(key), value_(value) {}
+  };
+
+ public:
+  typedef basic_iterator<Value> iterator;
+  typedef basic_iterator<const Value> const_iterator;
+
+  flat_map() : comp_() {}
+  explicit flat_map(const Compare& comp) : comp_(comp) {}
+  flat_map(std::initializer_list<value_type> items,
+           const Compare& comp = Compare());
+  // Диапазон пар; из пар с равными ключами остаётся первая
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_map(InputIt first, InputIt last, const Compare& comp = Compare());
+
+  iterator begin() { return at_index(0); }
+  iterator end() { return at_index(keys_.size()); }
+  const_iterator begin() const { return at_index(0); }
+  const_iterator end() const { return at_index(keys_.size()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const { return keys_.empty(); }
+  size_type size() const { return keys_.size(); }
+  size_type max_size() const {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+  size_type capacity() const { return keys_.capacity(); }
+  void reserve(size_type n);
+  void shrink_to_fit();
+  void clear();
+  const Compare& key_comp() const { return comp_; }
+
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(const Key& key, const Value& value);
+  // Если ключ ложится прямо перед hint, двоичный поиск не нужен
+  iterator insert(const_iterator hint, const value_type& value);
+  // Дописывает пары в конец, упорядочивает их и сливает с имеющимися за
+  // O(n + m log m). Пары с уже имеющимися ключами пропускаются
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+
+  Value& at(const Key& key);
+  const Value& at(const Key& key) const;
+  Value& operator[](const Key& key);
+
+  size_type erase(const Key& key);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  // Переносит пары other с новыми ключами за O(n + m); остальные
+  // остаются в other
+  void merge(flat_map& other);
+
+  // Отдаёт массивы ключей и значений целиком, словарь остаётся пустым
+  containers extract_sequence();
+  // Забирает массивы без копирования; ключи должны строго возрастать
+  void replace(key_container_type&& keys, mapped_container_type&& values);
+
+  bool contains(const Key& key) const;
+  iterator find(const Key& key);
+  const_iterator find(const Key& key) const;
+  iterator lower_bound(const Key& key);
+  const_iterator lower_bound(const Key& key) const;
+  iterator upper_bound(const Key& key);
+  const_iterator upper_bound(const Key& key) const;
+  std::pair<iterator, iterator> equal_range(const Key& key);
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const;
+
+  // Гетерогенный поиск для прозрачного Compare (например, std::less<>)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const;
+
+  // Вызывает fn(reference) для пар с ключами из [lo, hi) по порядку
+  template <typename Fn>
+  void for_each_in_range(const Key& lo, const Key& hi, Fn fn);
+  template <typename Fn>
+  void for_each_in_range(const Key& lo, const Key& hi, Fn fn) const;
+
+  // k-я по порядку пара за O(1), число ключей меньше key и число ключей
+  // в [lo, hi) за O(log n)
+  iterator select(size_type k);
+  const_iterator select(size_type k) const;
+  size_type rank(const Key& key) const;
+  size_type count_range(const Key& lo, const Key& hi) const;
+
+  void swap(flat_map& other);
+  bool operator==(const flat_map& other) const {
+    return keys_ == other.keys_ && values_ == other.values_;
+  }
+  bool operator!=(const flat_map& other) const { return !(*this == other); }
+
+ private:
+  iterator at_index(size_type i) {
+    return iterator(keys_.data() + i, values_.data() + i);
+  }
+  const_iterator at_index(size_type i) const {
+    return const_iterator(keys_.data() + i, values_.data() + i);
+  }
+  size_type index_of(const_iterator it) const {
+    return static_cast<size_type>(it.key_ - keys_.data());
+  }
+  // Двоичный поиск по массиву ключей без ветвления на результате
+  // сравнения (см. flat_set::lower_index)
+  template <typename K>
+  size_type lower_index(const K& key) const;
+  template <typename K>
+  size_type upper_index(const K& key) const;
+  template <typename K>
+  size_type find_index(const K& key) const;
+  template <typename K, typename V>
+  std::pair<iterator, bool> insert_at(size_type pos, K&& key, V&& value);
+  // Упорядочивает пары с позиции old_size и сливает их с головой,
+  // выбрасывая повторные ключи
+  void merge_tail(size_type old_size);
+
+  key_container_type keys_;
+  mapped_container_type values_;
+  Compare comp_;
+};
+
+template <typename Key, typename Value, typename Compare>
+flat_map<Key, Value, Compare>::flat_map(std::initializer_list<value_type> items,
+                                        const Compare& comp)
+    : comp_(comp) {
+  insert(items.begin(), items.end());
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename InputIt, typename>
+flat_map<Key, Value, Compare>::flat_map(InputIt first, InputIt last,
+                                        const Compare& comp)
+    : comp_(comp) {
+  insert(first, last);
+}
+
+template <typename Key, typename Value, typename Compare>
+void flat_map<Key, Value, Compare>::reserve(size_type n) {
+  keys_.reserve(n);
+  values_.reserve(n);
+}
+
+template <typename Key, typename Value, typename Compare>
+void flat_map<Key, Value, Compare>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+  values_.shrink_to_fit();
+}
+
+template <typename Key, typename Value, typename Compare>
+void flat_map<Key, Value, Compare>::clear() {
+  keys_.clear();
+  values_.clear();
+}
+
+template <typename Key, typename Value, typename Compare>
+std::pair<typename flat_map<Key, Value, Compare>::iterator, bool>
+flat_map<Key, Value, Compare>::insert(const value_type& value) {
+  return insert(value.first, value.second);
+}
+
+template <typename Key, typename Value, typename Compare>
+std::pair<typename flat_map<Key, Value, Compare>::iterator, bool>
+flat_map<Key, Value, Compare>::insert(const Key& key, const Value& value) {
+  return insert_at(lower_index(key), key, value);
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::insert(const_iterator hint,
+                                      const value_type& value) {
+  size_type pos = index_of(hint);
+  if ((pos == keys_.size() || comp_(value.first, keys_[pos])) &&
+      (pos == 0 || comp_(keys_[pos - 1], value.first))) {
+    return insert_at(pos, value.first, value.second).first;
+  }
+  return insert(value).first;
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename InputIt>
+void flat_map<Key, Value, Compare>::insert(InputIt first, InputIt last) {
+  size_type old_size = keys_.size();
+  typedef typename std::iterator_traits<InputIt>::iterator_category category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    reserve(old_size + static_cast<size_type>(std::distance(first, last)));
+  }
+  // При исключении хвост отрезается: массивы остаются одной длины, а
+  // голова - упорядоченной
+  try {
+    for (; first != last; ++first) {
+      keys_.push_back(first->first);
+      values_.push_back(first->second);
+    }
+    merge_tail(old_size);
+  } catch (...) {
+    keys_.erase(keys_.begin() + old_size, keys_.end());
+    values_.erase(values_.begin() + old_size, values_.end());
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename Compare>
+Value& flat_map<Key, Value, Compare>::at(const Key& key) {
+  size_type pos = find_index(key);
+  if (pos == keys_.size()) throw std::out_of_range("Key not found");
+  return values_[pos];
+}
+
+template <typename Key, typename Value, typename Compare>
+const Value& flat_map<Key, Value, Compare>::at(const Key& key) const {
+  size_type pos = find_index(key);
+  if (pos == keys_.size()) throw std::out_of_range("Key not found");
+  return values_[pos];
+}
+
+template <typename Key, typename Value, typename Compare>
+Value& flat_map<Key, Value, Compare>::operator[](const Key& key) {
+  size_type pos = lower_index(key);
+  insert_at(pos, key, Value());
+  return values_[pos];
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::size_type
+flat_map<Key, Value, Compare>::erase(const Key& key) {
+  size_type pos = find_index(key);
+  if (pos == keys_.size()) return 0;
+  erase(at_index(pos));
+  return 1;
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::erase(const_iterator pos) {
+  return erase(pos, std::next(pos));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::erase(const_iterator first,
+                                     const_iterator last) {
+  size_type from = index_of(first), to = index_of(last);
+  keys_.erase(keys_.begin() + from, keys_.begin() + to);
+  values_.erase(values_.begin() + from, values_.begin() + to);
+  return at_index(from);
+}
+
+template <typename Key, typename Value, typename Compare>
+void flat_map<Key, Value, Compare>::merge(flat_map& other) {
+  flat_map merged(comp_), kept(comp_);
+  merged.reserve(size() + other.size());
+  size_type mine = 0, theirs = 0;
+  auto take = [](flat_map& to, flat_map& from, size_type& i) {
+    to.keys_.push_back(std::move(from.keys_[i]));
+    to.values_.push_back(std::move(from.values_[i]));
+    ++i;
+  };
+  while (theirs < other.size()) {
+    if (mine == size() || comp_(other.keys_[theirs], keys_[mine])) {
+      take(merged, other, theirs);
+    } else {
+      if (!comp_(keys_[mine], other.keys_[theirs])) {
+        take(kept, other, theirs);
+      }
+      take(merged, *this, mine);
+    }
+  }
+  while (mine < size()) take(merged, *this, mine);
+  keys_.swap(merged.keys_);
+  values_.swap(merged.values_);
+  other.keys_.swap(kept.keys_);
+  other.values_.swap(kept.values_);
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::containers
+flat_map<Key, Value, Compare>::extract_sequence() {
+  containers result{std::move(keys_), std::move(values_)};
+  clear();
+  return result;
+}
+
+template <typename Key, typename Value, typename Compare>
+void flat_map<Key, Value, Compare>::replace(key_container_type&& keys,
+                                            mapped_container_type&& values) {
+  if (keys.size() != values.size()) {
+    throw std::invalid_argument("replace: keys and values differ in size");
+  }
+  auto unordered = std::adjacent_find(keys.begin(), keys.end(),
+                                      [this](const Key& a, const Key& b) {
+                                        return !comp_(a, b);
+                                      });
+  if (unordered != keys.end()) {
+    throw std::invalid_argument("replace: keys are not strictly sorted");
+  }
+  keys_ = std::move(keys);
+  values_ = std::move(values);
+}
+
+template <typename Key, typename Value, typename Compare>
+bool flat_map<Key, Value, Compare>::contains(const Key& key) const {
+  return find_index(key) != keys_.size();
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::find(const Key& key) {
+  return at_index(find_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::const_iterator
+flat_map<Key, Value, Compare>::find(const Key& key) const {
+  return at_index(find_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::lower_bound(const Key& key) {
+  return at_index(lower_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::const_iterator
+flat_map<Key, Value, Compare>::lower_bound(const Key& key) const {
+  return at_index(lower_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::upper_bound(const Key& key) {
+  return at_index(upper_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::const_iterator
+flat_map<Key, Value, Compare>::upper_bound(const Key& key) const {
+  return at_index(upper_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+std::pair<typename flat_map<Key, Value, Compare>::iterator,
+          typename flat_map<Key, Value, Compare>::iterator>
+flat_map<Key, Value, Compare>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename Value, typename Compare>
+std::pair<typename flat_map<Key, Value, Compare>::const_iterator,
+          typename flat_map<Key, Value, Compare>::const_iterator>
+flat_map<Key, Value, Compare>::equal_range(const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K, typename C, typename>
+bool flat_map<Key, Value, Compare>::contains(const K& key) const {
+  return find_index(key) != keys_.size();
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K, typename C, typename>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::find(const K& key) {
+  return at_index(find_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K, typename C, typename>
+typename flat_map<Key, Value, Compare>::const_iterator
+flat_map<Key, Value, Compare>::find(const K& key) const {
+  return at_index(find_index(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename Fn>
+void flat_map<Key, Value, Compare>::for_each_in_range(const Key& lo,
+                                                      const Key& hi, Fn fn) {
+  for (auto it = lower_bound(lo); it != end() && comp_(it->first, hi); ++it) {
+    fn(*it);
+  }
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename Fn>
+void flat_map<Key, Value, Compare>::for_each_in_range(const Key& lo,
+                                                      const Key& hi,
+                                                      Fn fn) const {
+  for (auto it = lower_bound(lo); it != end() && comp_(it->first, hi); ++it) {
+    fn(*it);
+  }
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::iterator
+flat_map<Key, Value, Compare>::select(size_type k) {
+  if (k >= keys_.size()) throw std::out_of_range("select: index out of range");
+  return at_index(k);
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::const_iterator
+flat_map<Key, Value, Compare>::select(size_type k) const {
+  if (k >= keys_.size()) throw std::out_of_range("select: index out of range");
+  return at_index(k);
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::size_type
+flat_map<Key, Value, Compare>::rank(const Key& key) const {
+  return lower_index(key);
+}
+
+template <typename Key, typename Value, typename Compare>
+typename flat_map<Key, Value, Compare>::size_type
+flat_map<Key, Value, Compare>::count_range(const Key& lo,
+                                           const Key& hi) const {
+  if (!comp_(lo, hi)) return 0;
+  return lower_index(hi) - lower_index(lo);
+}
+
+template <typename Key, typename Value, typename Compare>
+void flat_map<Key, Value, Compare>::swap(flat_map& other) {
+  using std::swap;
+  swap(keys_, other.keys_);
+  swap(values_, other.values_);
+  swap(comp_, other.comp_);
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+typename flat_map<Key, Value, Compare>::size_type
+flat_map<Key, Value, Compare>::lower_index(const K& key) const {
+  const Key* base = keys_.data();
+  size_type n = keys_.size();
+  while (n > 1) {
+    size_type half = n / 2;
+    base = comp_(base[half - 1], key) ? base + half : base;
+    n -= half;
+  }
+  if (n == 1 && comp_(*base, key)) ++base;
+  return static_cast<size_type>(base - keys_.data());
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+typename flat_map<Key, Value, Compare>::size_type
+flat_map<Key, Value, Compare>::upper_index(const K& key) const {
+  const Key* base = keys_.data();
+  size_type n = keys_.size();
+  while (n > 1) {
+    size_type half = n / 2;
+    base = comp_(key, base[half - 1]) ? base : base + half;
+    n -= half;
+  }
+  if (n == 1 && !comp_(key, *base)) ++base;
+  return static_cast<size_type>(base - keys_.data());
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K>
+typename flat_map<Key, Value, Compare>::size_type
+flat_map<Key, Value, Compare>::find_index(const K& key) const {
+  size_type pos = lower_index(key);
+  if (pos < keys_.size() && comp_(key, keys_[pos])) return keys_.size();
+  return pos;
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename K, typename V>
+std::pair<typename flat_map<Key, Value, Compare>::iterator, bool>
+flat_map<Key, Value, Compare>::insert_at(size_type pos, K&& key, V&& value) {
+  if (pos < keys_.size() && !comp_(key, keys_[pos])) {
+    return {at_index(pos), false};
+  }
+  keys_.insert(keys_.begin() + pos, std::forward<K>(key));
+  values_.insert(values_.begin() + pos, std::forward<V>(value));
+  return {at_index(pos), true};
+}
+
+template <typename Key, typename Value, typename Compare>
+void flat_map<Key, Value, Compare>::merge_tail(size_type old_size) {
+  size_type total = keys_.size();
+  // Хвост строго возрастает и продолжает голову - данные пришли
+  // упорядоченными, переставлять нечего
+  size_type i = old_size;
+  while (i < total && (i == 0 || comp_(keys_[i - 1], keys_[i]))) ++i;
+  if (i == total) return;
+
+  // Ключи и значения лежат в разных массивах, поэтому сортируется
+  // перестановка индексов хвоста; устойчиво, чтобы из равных ключей
+  // осталась первая пара
+  std::vector<size_type> order(total - old_size);
+  std::iota(order.begin(), order.end(), old_size);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_type a, size_type b) {
+                     return comp_(keys_[a], keys_[b]);
+                   });
+  flat_map merged(comp_);
+  merged.reserve(total);
+  auto take = [this, &merged](size_type from) {
+    if (!merged.empty() && !comp_(merged.keys_.back(), keys_[from])) return;
+    // Бросающее перемещение заменяется копией: при исключении исходные
+    // массивы остаются целыми
+    merged.keys_.push_back(std::move_if_noexcept(keys_[from]));
+    merged.values_.push_back(std::move_if_noexcept(values_[from]));
+  };
+  size_type head = 0;
+  for (size_type from : order) {
+    while (head < old_size && !comp_(keys_[from], keys_[head])) take(head++);
+    take(from);
+  }
+  while (head < old_size) take(head++);
+  keys_.swap(merged.keys_);
+  values_.swap(merged.values_);
+}
+
+}  // namespace s21
+
+#endif  // FLAT_MAP_H
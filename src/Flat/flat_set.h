@@ -0,0 +1,396 @@
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Упорядоченное множество на отсортированном std::vector с интерфейсом
+// s21_set. Элементы лежат подряд без узлов и указателей, поиск - двоичный
+// по массиву. Вставка и удаление одного элемента стоят O(n), поэтому
+// контейнер рассчитан на данные, которые собирают один раз (лучше всего
+// пачкой через insert(first, last)) и потом много читают. Любое изменение
+// делает итераторы недействительными.
+template <typename T, typename Compare = std::less<T>>
+class flat_set {
+ public:
+  typedef T key_type;
+  typedef T value_type;
+  typedef Compare key_compare;
+  typedef Compare value_compare;
+  typedef std::size_t size_type;
+  typedef std::vector<T> sequence_type;
+  // Элементы упорядочены, поэтому менять их через итератор нельзя
+  typedef typename sequence_type::const_iterator iterator;
+  typedef typename sequence_type::const_iterator const_iterator;
+
+  flat_set() : comp_() {}
+  explicit flat_set(const Compare& comp) : comp_(comp) {}
+  flat_set(std::initializer_list<T> init_list,
+           const Compare& comp = Compare());
+  // Повторные элементы диапазона пропускаются, остаётся первый
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_set(InputIt first, InputIt last, const Compare& comp = Compare());
+
+  iterator begin() const { return items_.cbegin(); }
+  iterator end() const { return items_.cend(); }
+  const_iterator cbegin() const { return items_.cbegin(); }
+  const_iterator cend() const { return items_.cend(); }
+
+  bool empty() const { return items_.empty(); }
+  size_type size() const { return items_.size(); }
+  size_type max_size() const { return items_.max_size(); }
+  size_type capacity() const { return items_.capacity(); }
+  void reserve(size_type n) { items_.reserve(n); }
+  void shrink_to_fit() { items_.shrink_to_fit(); }
+  void clear() { items_.clear(); }
+  const Compare& value_comp() const { return comp_; }
+
+  std::pair<iterator, bool> insert(const T& value);
+  std::pair<iterator, bool> insert(T&& value);
+  // Если value ложится прямо перед hint, двоичный поиск не нужен
+  iterator insert(const_iterator hint, const T& value);
+  // Дописывает диапазон в конец, сортирует его и сливает с имеющимися
+  // элементами за O(n + m log m) вместо m сдвигов массива. Равные
+  // элементы не заменяются
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+
+  size_type erase(const T& value);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  // Переносит элементы other, которых здесь нет, за O(n + m); равные
+  // остаются в other
+  void merge(flat_set& other);
+
+  // Отдаёт массив элементов целиком, множество остаётся пустым
+  sequence_type extract_sequence();
+  // Забирает строго возрастающий массив без копирования и сортировки
+  void replace(sequence_type&& sequence);
+
+  bool contains(const T& value) const;
+  iterator find(const T& value) const;
+  iterator lower_bound(const T& value) const;
+  iterator upper_bound(const T& value) const;
+  std::pair<iterator, iterator> equal_range(const T& value) const;
+
+  // Гетерогенный поиск для прозрачного Compare (например, std::less<>)
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const Key& key) const;
+
+  // Вызывает fn(const T&) для элементов из [lo, hi) по порядку
+  template <typename Fn>
+  void for_each_in_range(const T& lo, const T& hi, Fn fn) const;
+
+  // Порядковые статистики массив даёт даром: select за O(1), rank и
+  // count_range за O(log n)
+  iterator select(size_type k) const;
+  size_type rank(const T& value) const;
+  size_type count_range(const T& lo, const T& hi) const;
+
+  void swap(flat_set& other);
+  bool operator==(const flat_set& other) const {
+    return items_ == other.items_;
+  }
+  bool operator!=(const flat_set& other) const { return !(*this == other); }
+
+ private:
+  // Первый индекс, где элемент не меньше key (upper - больше key). Шаг
+  // поиска выбирает базу без ветвления, компилятор делает это через cmov
+  template <typename Key>
+  size_type lower_index(const Key& key) const;
+  template <typename Key>
+  size_type upper_index(const Key& key) const;
+  // Упорядочивает хвост массива с позиции old_size и сливает его с
+  // головой, выбрасывая повторы
+  void merge_tail(size_type old_size);
+
+  sequence_type items_;
+  Compare comp_;
+};
+
+template <typename T, typename Compare>
+flat_set<T, Compare>::flat_set(std::initializer_list<T> init_list,
+                               const Compare& comp)
+    : items_(init_list), comp_(comp) {
+  merge_tail(0);
+}
+
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+flat_set<T, Compare>::flat_set(InputIt first, InputIt last,
+                               const Compare& comp)
+    : items_(first, last), comp_(comp) {
+  merge_tail(0);
+}
+
+template <typename T, typename Compare>
+std::pair<typename flat_set<T, Compare>::iterator, bool>
+flat_set<T, Compare>::insert(const T& value) {
+  size_type pos = lower_index(value);
+  if (pos < items_.size() && !comp_(value, items_[pos])) {
+    return {begin() + pos, false};
+  }
+  return {items_.insert(begin() + pos, value), true};
+}
+
+template <typename T, typename Compare>
+std::pair<typename flat_set<T, Compare>::iterator, bool>
+flat_set<T, Compare>::insert(T&& value) {
+  size_type pos = lower_index(value);
+  if (pos < items_.size() && !comp_(value, items_[pos])) {
+    return {begin() + pos, false};
+  }
+  return {items_.insert(begin() + pos, std::move(value)), true};
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::insert(
+    const_iterator hint, const T& value) {
+  size_type pos = static_cast<size_type>(hint - begin());
+  if ((pos == items_.size() || comp_(value, items_[pos])) &&
+      (pos == 0 || comp_(items_[pos - 1], value))) {
+    return items_.insert(hint, value);
+  }
+  return insert(value).first;
+}
+
+template <typename T, typename Compare>
+template <typename InputIt>
+void flat_set<T, Compare>::insert(InputIt first, InputIt last) {
+  size_type old_size = items_.size();
+  items_.insert(items_.end(), first, last);
+  merge_tail(old_size);
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::size_type flat_set<T, Compare>::erase(
+    const T& value) {
+  size_type pos = lower_index(value);
+  if (pos == items_.size() || comp_(value, items_[pos])) return 0;
+  items_.erase(begin() + pos);
+  return 1;
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::erase(
+    const_iterator pos) {
+  return items_.erase(pos);
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::erase(
+    const_iterator first, const_iterator last) {
+  return items_.erase(first, last);
+}
+
+template <typename T, typename Compare>
+void flat_set<T, Compare>::merge(flat_set& other) {
+  sequence_type merged, kept;
+  merged.reserve(items_.size() + other.items_.size());
+  auto mine = items_.begin(), theirs = other.items_.begin();
+  while (theirs != other.items_.end()) {
+    if (mine == items_.end() || comp_(*theirs, *mine)) {
+      merged.push_back(std::move(*theirs++));
+    } else {
+      if (!comp_(*mine, *theirs)) kept.push_back(std::move(*theirs++));
+      merged.push_back(std::move(*mine++));
+    }
+  }
+  std::move(mine, items_.end(), std::back_inserter(merged));
+  items_.swap(merged);
+  other.items_.swap(kept);
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::sequence_type
+flat_set<T, Compare>::extract_sequence() {
+  sequence_type sequence = std::move(items_);
+  items_.clear();
+  return sequence;
+}
+
+template <typename T, typename Compare>
+void flat_set<T, Compare>::replace(sequence_type&& sequence) {
+  auto unordered =
+      std::adjacent_find(sequence.begin(), sequence.end(),
+                         [this](const T& a, const T& b) {
+                           return !comp_(a, b);
+                         });
+  if (unordered != sequence.end()) {
+    throw std::invalid_argument("replace: sequence is not strictly sorted");
+  }
+  items_ = std::move(sequence);
+}
+
+template <typename T, typename Compare>
+bool flat_set<T, Compare>::contains(const T& value) const {
+  return find(value) != end();
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::find(
+    const T& value) const {
+  size_type pos = lower_index(value);
+  if (pos == items_.size() || comp_(value, items_[pos])) return end();
+  return begin() + pos;
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::lower_bound(
+    const T& value) const {
+  return begin() + lower_index(value);
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::upper_bound(
+    const T& value) const {
+  return begin() + upper_index(value);
+}
+
+template <typename T, typename Compare>
+std::pair<typename flat_set<T, Compare>::iterator,
+          typename flat_set<T, Compare>::iterator>
+flat_set<T, Compare>::equal_range(const T& value) const {
+  return {lower_bound(value), upper_bound(value)};
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+bool flat_set<T, Compare>::contains(const Key& key) const {
+  return find(key) != end();
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::find(
+    const Key& key) const {
+  size_type pos = lower_index(key);
+  if (pos == items_.size() || comp_(key, items_[pos])) return end();
+  return begin() + pos;
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::lower_bound(
+    const Key& key) const {
+  return begin() + lower_index(key);
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::upper_bound(
+    const Key& key) const {
+  return begin() + upper_index(key);
+}
+
+template <typename T, typename Compare>
+template <typename Fn>
+void flat_set<T, Compare>::for_each_in_range(const T& lo, const T& hi,
+                                             Fn fn) const {
+  for (size_type i = lower_index(lo); i < items_.size(); ++i) {
+    if (!comp_(items_[i], hi)) break;
+    fn(items_[i]);
+  }
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::iterator flat_set<T, Compare>::select(
+    size_type k) const {
+  if (k >= items_.size()) throw std::out_of_range("select: index out of range");
+  return begin() + k;
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::size_type flat_set<T, Compare>::rank(
+    const T& value) const {
+  return lower_index(value);
+}
+
+template <typename T, typename Compare>
+typename flat_set<T, Compare>::size_type flat_set<T, Compare>::count_range(
+    const T& lo, const T& hi) const {
+  if (!comp_(lo, hi)) return 0;
+  return lower_index(hi) - lower_index(lo);
+}
+
+template <typename T, typename Compare>
+void flat_set<T, Compare>::swap(flat_set& other) {
+  using std::swap;
+  swap(items_, other.items_);
+  swap(comp_, other.comp_);
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename flat_set<T, Compare>::size_type flat_set<T, Compare>::lower_index(
+    const Key& key) const {
+  const T* base = items_.data();
+  size_type n = items_.size();
+  while (n > 1) {
+    size_type half = n / 2;
+    base = comp_(base[half - 1], key) ? base + half : base;
+    n -= half;
+  }
+  if (n == 1 && comp_(*base, key)) ++base;
+  return static_cast<size_type>(base - items_.data());
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename flat_set<T, Compare>::size_type flat_set<T, Compare>::upper_index(
+    const Key& key) const {
+  const T* base = items_.data();
+  size_type n = items_.size();
+  while (n > 1) {
+    size_type half = n / 2;
+    base = comp_(key, base[half - 1]) ? base : base + half;
+    n -= half;
+  }
+  if (n == 1 && !comp_(key, *base)) ++base;
+  return static_cast<size_type>(base - items_.data());
+}
+
+template <typename T, typename Compare>
+void flat_set<T, Compare>::merge_tail(size_type old_size) {
+  auto middle = items_.begin() + old_size;
+  if (middle == items_.end()) return;
+  // Упорядоченный хвост, который продолжает голову, - частый случай
+  // сборки из готовых данных: обходится без сортировки и слияния
+  if (!std::is_sorted(middle, items_.end(), comp_)) {
+    std::stable_sort(middle, items_.end(), comp_);
+  }
+  if (old_size > 0 && !comp_(*(middle - 1), *middle)) {
+    std::inplace_merge(items_.begin(), middle, items_.end(), comp_);
+  }
+  // Слияние устойчиво, поэтому из равных остаётся прежний элемент или
+  // первый из вставленных
+  items_.erase(std::unique(items_.begin(), items_.end(),
+                           [this](const T& a, const T& b) {
+                             return !comp_(a, b);
+                           }),
+               items_.end());
+}
+
+}  // namespace s21
+
+#endif  // FLAT_SET_H
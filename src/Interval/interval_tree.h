@@ -0,0 +1,157 @@
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../RBTree/RedBlackTree.h"
+
+namespace s21 {
+
+// Замкнутый интервал [low, high]
+template <typename K>
+struct interval {
+  K low;
+  K high;
+
+  bool operator==(const interval& other) const {
+    return low == other.low && high == other.high;
+  }
+  bool operator!=(const interval& other) const { return !(*this == other); }
+};
+
+// Словарь интервал -> значение с поиском пересечений: красно-чёрное
+// дерево по левым концам, в каждом узле которого хранится наибольший
+// правый конец поддерева (MaxEndpoint). Запрос не заходит в поддеревья,
+// где все интервалы кончаются до него, и правее первого интервала,
+// который начинается после него, поэтому стоит O(log n) плюс
+// O(log n) на каждый найденный интервал, а не O(n), как перебор всех
+// правил. Одинаковые интервалы допустимы и хранятся в порядке вставки.
+// Compare сравнивает концы и создаётся по умолчанию.
+template <typename K, typename V, typename Compare = std::less<K>>
+class interval_tree {
+ public:
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef interval<K> interval_type;
+  typedef std::pair<const interval<K>, V> value_type;
+  typedef std::size_t size_type;
+
+ private:
+  // Порядок по левому концу, при равных - по правому; умеет сравнивать
+  // элемент и с голым интервалом
+  struct IntervalCompare {
+    typedef void is_transparent;
+
+    Compare comp;
+
+    bool operator()(const interval<K>& a, const interval<K>& b) const {
+      if (comp(a.low, b.low)) return true;
+      if (comp(b.low, a.low)) return false;
+      return comp(a.high, b.high);
+    }
+    bool operator()(const value_type& a, const value_type& b) const {
+      return (*this)(a.first, b.first);
+    }
+    bool operator()(const value_type& a, const interval<K>& b) const {
+      return (*this)(a.first, b);
+    }
+    bool operator()(const interval<K>& a, const value_type& b) const {
+      return (*this)(a, b.first);
+    }
+  };
+
+  typedef RedBlackTree<value_type, IntervalCompare, MaxEndpoint<K, Compare>>
+      tree_type;
+
+ public:
+  typedef typename tree_type::iterator iterator;
+  typedef typename tree_type::const_iterator const_iterator;
+
+  interval_tree() = default;
+  interval_tree(std::initializer_list<value_type> items);
+
+  iterator begin() const { return tree_.begin(); }
+  iterator end() const { return tree_.end(); }
+  const_iterator cbegin() const { return tree_.cbegin(); }
+  const_iterator cend() const { return tree_.cend(); }
+
+  bool empty() const { return tree_.empty(); }
+  size_type size() const { return tree_.size(); }
+  void clear() { tree_.clear(); }
+
+  // Интервал с high < low - std::invalid_argument
+  iterator insert(const interval<K>& range, const V& value);
+  iterator insert(const value_type& item) {
+    return insert(item.first, item.second);
+  }
+  iterator erase(iterator pos) { return tree_.erase(pos); }
+  // Удаляет все записи с таким интервалом, возвращает их число
+  size_type erase(const interval<K>& range);
+  // Первая запись с таким интервалом или end()
+  iterator find(const interval<K>& range) const { return tree_.lookup(range); }
+
+  // fn(value_type&) для каждой записи, пересекающей range, по возрастанию
+  // левых концов; без копирования значений
+  template <typename Fn>
+  void for_each_overlap(const interval<K>& range, Fn fn) const {
+    tree_.for_each_overlap(range.low, range.high, fn);
+  }
+  // Записи, чьи интервалы содержат point
+  std::vector<value_type> overlaps(const K& point) const {
+    return overlaps(interval<K>{point, point});
+  }
+  // Записи, чьи интервалы пересекаются с range
+  std::vector<value_type> overlaps(const interval<K>& range) const;
+
+  bool isRedBlackTree() const { return tree_.isRedBlackTree(); }
+
+ private:
+  tree_type tree_;
+};
+
+template <typename K, typename V, typename Compare>
+interval_tree<K, V, Compare>::interval_tree(
+    std::initializer_list<value_type> items) {
+  for (const value_type& item : items) insert(item);
+}
+
+template <typename K, typename V, typename Compare>
+typename interval_tree<K, V, Compare>::iterator
+interval_tree<K, V, Compare>::insert(const interval<K>& range,
+                                     const V& value) {
+  if (Compare()(range.high, range.low)) {
+    throw std::invalid_argument("Interval end is less than its start");
+  }
+  // Вставка после всех равных: одинаковые интервалы - в порядке вставки
+  return tree_.insert(tree_.end(), value_type(range, value));
+}
+
+template <typename K, typename V, typename Compare>
+typename interval_tree<K, V, Compare>::size_type
+interval_tree<K, V, Compare>::erase(const interval<K>& range) {
+  auto found = tree_.equal_range(range);
+  size_type erased = 0;
+  for (auto it = found.first; it != found.second; ++it) ++erased;
+  tree_.erase(found.first, found.second);
+  return erased;
+}
+
+template <typename K, typename V, typename Compare>
+std::vector<typename interval_tree<K, V, Compare>::value_type>
+interval_tree<K, V, Compare>::overlaps(const interval<K>& range) const {
+  std::vector<value_type> result;
+  for_each_overlap(range,
+                   [&result](const value_type& item) {
+                     result.push_back(item);
+                   });
+  return result;
+}
+
+}  // namespace s21
+
+#endif  // INTERVAL_TREE_H
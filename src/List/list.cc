@@ -147,6 +147,14 @@ const T &List<T>::front() const {
     throw std::out_of_range("List is empty");
 }
 
+template <typename T>
+T &List<T>::front() {
+  if (head != nullptr)
+    return head->data;
+  else
+    throw std::out_of_range("List is empty");
+}
+
 template <typename T>
 const T &List<T>::back() const {
   if (tail != nullptr)
@@ -200,11 +208,11 @@ void List<T>::pop_back() {
 template <typename T>
 void List<T>::push_front(T data) {
   if (head == nullptr) {
-    addFirstNode(data);
+    addFirstNode(std::move(data));
     return;
   }
 
-  Node *newNode = new Node(data);
+  Node *newNode = new Node(std::move(data));
   newNode->next = head;
   newNode->previous = nullptr;
   head->previous = newNode;
@@ -215,10 +223,10 @@ void List<T>::push_front(T data) {
 template <typename T>
 void List<T>::push_back(T data) {
   if (head == nullptr) {
-    addFirstNode(data);
+    addFirstNode(std::move(data));
     return;
   }
-  Node *newNode = new Node(data);
+  Node *newNode = new Node(std::move(data));
   newNode->previous = tail;
   tail->next = newNode;
   tail = newNode;
@@ -284,7 +292,7 @@ void List<T>::merge(List &other) {
 
 template <typename T>
 void List<T>::addFirstNode(T data) {
-  head = new Node(data);
+  head = new Node(std::move(data));
   tail = head;
   Size = 1;
 }
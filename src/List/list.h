@@ -5,6 +5,7 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <utility>
 
 template <typename T>
 class vector;
@@ -34,7 +35,7 @@ class List {
     T data;
     Node *next;
     Node *previous;
-    Node(T val) : data(val), next(nullptr), previous(nullptr) {}
+    Node(T val) : data(std::move(val)), next(nullptr), previous(nullptr) {}
   };
 
   // Iterators
@@ -135,6 +136,7 @@ class List {
  public:
   // Accessors
   const T &front() const;  // access the first element
+  T &front();              // the first element, e.g. to move it out
   const T &back() const;   // access the last element
 
   // Operators
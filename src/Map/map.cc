@@ -3,282 +3,493 @@
 
 #include "map.h"
 
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::insert(std::shared_ptr<Node>& node,
-                                         const KeyType& key,
-                                         const ValueType& value) {
-  auto z = std::make_shared<Node>(key, value);
-  std::shared_ptr<Node> y = nullptr;
-  auto x = node;
-  while (x) {
-    y = x;
-    if (z->key < x->key)
-      x = x->left;
-    else
-      x = x->right;
-  }
-  z->parent = y;
-  if (!y)
-    node = z;
-  else if (z->key < y->key)
-    y->left = z;
-  else
-    y->right = z;
-  fixInsert(z);
-}
-
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::fixInsert(std::shared_ptr<Node> z) {
-  while (z->parent && z->parent->color == Color::RED) {
-    if (z->parent == z->parent->parent->left) {
-      auto y = z->parent->parent->right;
-      if (y && y->color == Color::RED) {
-        z->parent->color = Color::BLACK;
-        y->color = Color::BLACK;
-        z->parent->parent->color = Color::RED;
-        z = z->parent->parent;
-      } else {
-        z->parent->color = Color::BLACK;
-        z->parent->parent->color = Color::RED;
-      }
-    } else {
-      auto y = z->parent->parent->left;
-      if (z == z->parent->left) {
-        z = z->parent;
-      }
-      z->parent->color = Color::BLACK;
-      z->parent->parent->color = Color::RED;
-      leftRotate(z->parent->parent);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::s21_map() : tree() {}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::s21_map(
+    const Compare& comp)
+    : tree(KeyCompare{comp}) {}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::s21_map(
+    std::initializer_list<value_type> items)
+    : s21_map(items.begin(), items.end()) {}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename InputIt, typename>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::s21_map(InputIt first,
+                                                                InputIt last)
+    : tree() {
+  typedef typename std::iterator_traits<InputIt>::iterator_category category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    const Compare& comp = tree.value_comp().comp;
+    auto unordered = [&comp](const auto& a, const auto& b) {
+      return !comp(a.first, b.first);
+    };
+    if (std::adjacent_find(first, last, unordered) == last) {
+      tree.assign_sorted(first, last);
+      return;
     }
   }
-  root->color = Color::BLACK;
-}
-
-template <typename KeyType, typename ValueType>
-std::shared_ptr<typename s21_map<KeyType, ValueType>::Node>
-s21_map<KeyType, ValueType>::find(std::shared_ptr<Node> node,
-                                  const KeyType& key) const {
-  if (!node || node->key == key) return node;
-  if (key < node->key) return find(node->left, key);
-  return find(node->right, key);
-}
-
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::leftRotate(std::shared_ptr<Node> x) {
-  auto y = x->right;
-  x->right = y->left;
-  if (y->left) y->left->parent = x;
-  y->parent = x->parent;
-  if (!x->parent)
-    root = y;
-  else if (x == x->parent->left)
-    x->parent->left = y;
-  else
-    x->parent->right = y;
-  y->left = x;
-  x->parent = y;
-}
-
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::rightRotate(std::shared_ptr<Node> y) {
-  auto x = y->left;
-  y->left = x->right;
-  if (x->right) x->right->parent = y;
-  x->parent = y->parent;
-  if (!y->parent)
-    root = x;
-  else if (y == y->parent->left)
-    y->parent->left = x;
-  else
-    y->parent->right = x;
-  x->right = y;
-  y->parent = x;
-}
-
-template <typename KeyType, typename ValueType>
-size_t s21_map<KeyType, ValueType>::getSize(
-    const std::shared_ptr<Node>& node) const {
-  if (!node) return 0;
-  return getSize(node->left) + getSize(node->right) + 1;
-}
-
-template <typename KeyType, typename ValueType>
-std::shared_ptr<typename s21_map<KeyType, ValueType>::Node>
-s21_map<KeyType, ValueType>::minimum(std::shared_ptr<Node> node) const {
-  while (node->left) node = node->left;
-  return node;
-}
-
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::transplant(std::shared_ptr<Node> u,
-                                             std::shared_ptr<Node> v) {
-  if (!u->parent)
-    root = v;
-  else if (u == u->parent->left)
-    u->parent->left = v;
-  else
-    u->parent->right = v;
-  if (v) v->parent = u->parent;
-}
-
-template <typename KeyType, typename ValueType>
-bool s21_map<KeyType, ValueType>::isEqual(
-    const std::shared_ptr<Node>& node1,
-    const std::shared_ptr<Node>& node2) const {
-  if (!node1 && !node2) return true;
-  if (!node1 || !node2) return false;
-  return node1->key == node2->key && node1->value == node2->value &&
-         isEqual(node1->left, node2->left) &&
-         isEqual(node1->right, node2->right);
-}
-
-template <typename KeyType, typename ValueType>
-int s21_map<KeyType, ValueType>::isRedBlackTreeHelper(
-    std::shared_ptr<Node> node) const {
-  if (node == nullptr) {
-    return 0;
+  for (; first != last; ++first) tree.insertUnique(*first);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename ForwardIt>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::assign_sorted(
+    ForwardIt first, ForwardIt last) {
+  tree.assign_sorted(first, last);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::s21_map(
+    s21_map&& other) noexcept
+    : tree(std::move(other.tree)) {}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>&
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::operator=(
+    s21_map&& other) noexcept {
+  if (this != &other) {
+    tree = std::move(other.tree);
   }
+  return *this;
+}
 
-  int leftCount = isRedBlackTreeHelper(node->left);
-  int rightCount = isRedBlackTreeHelper(node->right);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+bool s21_map<KeyType, ValueType, Compare, Augment,
+             Backend>::isRedBlackTree() const {
+  return !tree.empty() && tree.isRedBlackTree();
+}
 
-  if ((node->color == Color::RED) &&
-      ((node->left != nullptr && node->left->color != Color::BLACK) ||
-       (node->right != nullptr && node->right->color != Color::BLACK))) {
-    return -1;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+s21::static_ordered_map<KeyType, ValueType, Compare>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::freeze() const {
+  std::vector<std::pair<KeyType, ValueType>> items;
+  items.reserve(tree.size());
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it) {
+    items.emplace_back(it->first, it->second);
   }
+  return s21::static_ordered_map<KeyType, ValueType, Compare>(
+      std::make_move_iterator(items.begin()),
+      std::make_move_iterator(items.end()), tree.value_comp().comp);
+}
 
-  if (leftCount != -1 && rightCount != -1 && leftCount != rightCount) {
-    return -1;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::save(
+    std::ostream& out) const {
+  static_assert(std::is_trivially_copyable<KeyType>::value &&
+                    std::is_trivially_copyable<ValueType>::value,
+                "snapshots need trivially copyable keys and values");
+  s21::detail::snapshot_header header = s21::detail::make_snapshot_header(
+      s21::detail::snapshot_kind::map, sizeof(KeyType), sizeof(ValueType),
+      tree.size());
+  s21::detail::snapshot_writer writer(out, header);
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it) {
+    writer.write(it->first);
+  }
+  writer.pad_to(header.values_offset);
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it) {
+    writer.write(it->second);
   }
+  writer.finish();
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::load(
+    std::istream& in) {
+  static_assert(std::is_trivially_copyable<KeyType>::value &&
+                    std::is_trivially_copyable<ValueType>::value,
+                "snapshots need trivially copyable keys and values");
+  s21::detail::snapshot_reader reader(in, s21::detail::snapshot_kind::map,
+                                      sizeof(KeyType), sizeof(ValueType));
+  std::vector<KeyType> keys;
+  std::vector<ValueType> values;
+  reader.read_array(keys);
+  reader.skip_to(s21::detail::snapshot_values_offset(reader.count(),
+                                                     sizeof(KeyType)));
+  reader.read_array(values);
+  reader.finish();
+  const Compare& comp = tree.value_comp().comp;
+  for (size_t i = 1; i < keys.size(); ++i) {
+    if (!comp(keys[i - 1], keys[i])) {
+      throw std::runtime_error("Snapshot: keys are not strictly increasing");
+    }
+  }
+  std::vector<value_type> items;
+  items.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    items.emplace_back(keys[i], values[i]);
+  }
+  tree.assign_sorted(items.begin(), items.end());
+}
 
-  return (node->color == Color::BLACK) ? leftCount + 1 : leftCount;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+std::pair<
+    typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator,
+    bool>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::insert(
+    const value_type& value) {
+  auto result = tree.insertUnique(value);
+  return {iterator(result.first), result.second};
 }
 
-template <typename KeyType, typename ValueType>
-s21_map<KeyType, ValueType>::s21_map() : root(nullptr) {}
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+std::pair<
+    typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator,
+    bool>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::insert(
+    const KeyType& key, const ValueType& value) {
+  return insert(value_type(key, value));
+}
 
-template <typename KeyType, typename ValueType>
-std::shared_ptr<typename s21_map<KeyType, ValueType>::Node>
-s21_map<KeyType, ValueType>::getRoot() const {
-  return root;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::insert(
+    iterator hint, const value_type& value) {
+  return iterator(tree.insertUnique(hint.iter, value).first);
 }
 
-template <typename KeyType, typename ValueType>
-bool s21_map<KeyType, ValueType>::isRedBlackTree() const {
-  if (root == nullptr || root->color != Color::BLACK) {
-    return false;
-  }
-  return isRedBlackTreeHelper(root) != -1;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::find(
+    iterator hint, const KeyType& key) {
+  return iterator(tree.lookup(hint.iter, key));
 }
 
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::insert(const KeyType& key,
-                                         const ValueType& value) {
-  insert(root, key, value);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::node_type
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::extract(
+    const KeyType& key) {
+  auto it = tree.lookup(key);
+  if (it == tree.end()) return node_type();
+  return tree.extract(it);
 }
 
-template <typename KeyType, typename ValueType>
-const ValueType& s21_map<KeyType, ValueType>::at(const KeyType& key) const {
-  auto node = find(root, key);
-  if (!node) throw std::out_of_range("Key not found");
-  return node->value;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::node_type
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::extract(iterator pos) {
+  return tree.extract(pos.iter);
 }
 
-template <typename KeyType, typename ValueType>
-ValueType& s21_map<KeyType, ValueType>::operator[](const KeyType& key) {
-  auto node = find(root, key);
-  if (!node) {
-    insert(key, ValueType());
-    node = find(root, key);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+std::pair<
+    typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator,
+    bool>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::insert(
+    node_type&& node) {
+  auto result = tree.insertUnique(std::move(node));
+  return {iterator(result.first), result.second};
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::merge(
+    s21_map& other) {
+  tree.mergeUnique(other.tree);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+const ValueType& s21_map<KeyType, ValueType, Compare, Augment, Backend>::at(
+    const KeyType& key) const {
+  auto it = tree.lookup(key);
+  if (it == tree.end()) throw std::out_of_range("Key not found");
+  return it->second;
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+ValueType& s21_map<KeyType, ValueType, Compare, Augment, Backend>::operator[](
+    const KeyType& key) {
+  auto it = tree.lookup(key);
+  if (it == tree.end()) {
+    it = tree.insertUnique(value_type(key, ValueType())).first;
   }
-  return node->value;
+  return it->second;
 }
 
-template <typename KeyType, typename ValueType>
-size_t s21_map<KeyType, ValueType>::size() const {
-  return getSize(root);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+size_t s21_map<KeyType, ValueType, Compare, Augment, Backend>::size() const {
+  return tree.size();
 }
 
-template <typename KeyType, typename ValueType>
-bool s21_map<KeyType, ValueType>::contains(const KeyType& key) const {
-  return find(root, key) != nullptr;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+bool s21_map<KeyType, ValueType, Compare, Augment, Backend>::contains(
+    const KeyType& key) const {
+  return tree.lookup(key) != tree.end();
 }
 
-template <typename KeyType, typename ValueType>
-bool s21_map<KeyType, ValueType>::empty() const {
-  return root == nullptr;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::find(
+    const KeyType& key) {
+  return iterator(tree.lookup(key));
 }
 
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::clear() {
-  root = nullptr;
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::const_iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::find(
+    const KeyType& key) const {
+  typename tree_type::const_iterator it = tree.lookup(key);
+  return const_iterator(it);
 }
 
-template <typename KeyType, typename ValueType>
-void s21_map<KeyType, ValueType>::erase(const KeyType& key) {
-  auto z = find(root, key);
-  if (!z) return;
-  auto y = z;
-  std::shared_ptr<Node> x;
-  if (!z->left) {
-    x = z->right;
-    transplant(z, z->right);
-  } else if (!z->right) {
-    x = z->left;
-    transplant(z, z->left);
-  }
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::contains_batch(
+    const KeyType* keys, size_t n, bool* out) const {
+  tree.contains_batch(keys, n, out);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename OutputIt>
+OutputIt s21_map<KeyType, ValueType, Compare, Augment, Backend>::find_batch(
+    const KeyType* keys, size_t n, OutputIt out) {
+  return tree.find_batch(keys, n, out);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename Key, typename C, typename>
+bool s21_map<KeyType, ValueType, Compare, Augment, Backend>::contains(
+    const Key& key) const {
+  return tree.lookup(key) != tree.end();
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename Key, typename C, typename>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::find(const Key& key) {
+  return iterator(tree.lookup(key));
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename Key, typename C, typename>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::const_iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::find(
+    const Key& key) const {
+  typename tree_type::const_iterator it = tree.lookup(key);
+  return const_iterator(it);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::lower_bound(
+    const KeyType& key) {
+  return iterator(tree.lower_bound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::const_iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::lower_bound(
+    const KeyType& key) const {
+  typename tree_type::const_iterator it = tree.lower_bound(key);
+  return const_iterator(it);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::upper_bound(
+    const KeyType& key) {
+  return iterator(tree.upper_bound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::const_iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::upper_bound(
+    const KeyType& key) const {
+  typename tree_type::const_iterator it = tree.upper_bound(key);
+  return const_iterator(it);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+std::pair<
+    typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator,
+    typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::equal_range(
+    const KeyType& key) {
+  auto range = tree.equal_range(key);
+  return {iterator(range.first), iterator(range.second)};
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+std::pair<typename s21_map<KeyType, ValueType, Compare, Augment,
+                           Backend>::const_iterator,
+          typename s21_map<KeyType, ValueType, Compare, Augment,
+                           Backend>::const_iterator>
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::equal_range(
+    const KeyType& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename Fn>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::for_each_in_range(
+    const KeyType& lo, const KeyType& hi, Fn fn) {
+  tree.for_each_in_range(lo, hi, fn);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+template <typename Fn>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::for_each_in_range(
+    const KeyType& lo, const KeyType& hi, Fn fn) const {
+  tree.for_each_in_range(lo, hi,
+                         [&fn](const value_type& item) { fn(item); });
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::select(size_t k) {
+  return iterator(tree.select(k));
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::const_iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::select(size_t k) const {
+  typename tree_type::const_iterator it = tree.select(k);
+  return const_iterator(it);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+size_t s21_map<KeyType, ValueType, Compare, Augment, Backend>::rank(
+    const KeyType& key) const {
+  return tree.rank(key);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+size_t s21_map<KeyType, ValueType, Compare, Augment, Backend>::count_range(
+    const KeyType& lo, const KeyType& hi) const {
+  if (!tree.value_comp().comp(lo, hi)) return 0;
+  return tree.rank(hi) - tree.rank(lo);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+bool s21_map<KeyType, ValueType, Compare, Augment, Backend>::empty() const {
+  return tree.empty();
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::clear() {
+  tree.clear();
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+void s21_map<KeyType, ValueType, Compare, Augment, Backend>::erase(
+    const KeyType& key) {
+  auto it = tree.lookup(key);
+  if (it != tree.end()) tree.erase(it);
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::erase(iterator pos) {
+  return iterator(tree.erase(pos.iter));
+}
+
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::erase(iterator first,
+                                                              iterator last) {
+  return iterator(tree.erase(first.iter, last.iter));
 }
 
-template <typename KeyType, typename ValueType>
-bool s21_map<KeyType, ValueType>::operator==(const s21_map& other) const {
-  return isEqual(root, other.root);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+bool s21_map<KeyType, ValueType, Compare, Augment, Backend>::operator==(
+    const s21_map& other) const {
+  return tree == other.tree;
 }
 
-template <typename KeyType, typename ValueType>
-bool s21_map<KeyType, ValueType>::operator!=(const s21_map& other) const {
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+bool s21_map<KeyType, ValueType, Compare, Augment, Backend>::operator!=(
+    const s21_map& other) const {
   return !(*this == other);
 }
 
-template <typename KeyType, typename ValueType>
-typename s21_map<KeyType, ValueType>::iterator
-s21_map<KeyType, ValueType>::begin() {
-  if (!root) return iterator(nullptr, root);
-  auto current = root;
-  while (current->left) current = current->left;
-  return iterator(current, root);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::begin() {
+  return iterator(tree.begin());
 }
 
-template <typename KeyType, typename ValueType>
-typename s21_map<KeyType, ValueType>::iterator
-s21_map<KeyType, ValueType>::end() {
-  return iterator(nullptr, root);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::end() {
+  return iterator(tree.end());
 }
 
-template <typename KeyType, typename ValueType>
-typename s21_map<KeyType, ValueType>::const_iterator
-s21_map<KeyType, ValueType>::begin() const {
-  if (!root) return const_iterator(nullptr, root);
-  auto current = root;
-  while (current->left) current = current->left;
-  return const_iterator(current, root);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::const_iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::begin() const {
+  return const_iterator(tree.cbegin());
 }
 
-template <typename KeyType, typename ValueType>
-typename s21_map<KeyType, ValueType>::const_iterator
-s21_map<KeyType, ValueType>::end() const {
-  return const_iterator(nullptr, root);
+template <typename KeyType, typename ValueType, typename Compare,
+          typename Augment, typename Backend>
+typename s21_map<KeyType, ValueType, Compare, Augment, Backend>::const_iterator
+s21_map<KeyType, ValueType, Compare, Augment, Backend>::end() const {
+  return const_iterator(tree.cend());
 }
 
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare, typename Augment,
+          typename Backend>
 template <class... Args>
-vector<std::pair<typename s21_map<Key, T>::iterator, bool>>
-s21_map<Key, T>::insert_many(Args&&... args) {
-  vector<std::pair<typename s21_map<Key, T>::iterator, bool>> vec;
+vector<std::pair<typename s21_map<Key, T, Compare, Augment, Backend>::iterator,
+                 bool>>
+s21_map<Key, T, Compare, Augment, Backend>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> vec;
   for (const auto& arg : {args...}) {
     vec.push_back(insert(arg));
   }
   return vec;
 }
 
-#endif
\ No newline at end of file
+#endif
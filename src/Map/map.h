@@ -5,88 +5,207 @@
 #include <stdexcept>
 #include <utility>
 
+#include "../RBTree/RedBlackTree.h"
+#include "../Snapshot/snapshot.h"
+#include "../Static/static_ordered_map.h"
 #include "../Vector/vector.h"
 
-template <typename KeyType, typename ValueType>
+template <typename KeyType, typename ValueType,
+          typename Compare = std::less<KeyType>,
+          typename Augment = NoAugmentation,
+          typename Backend = RedBlackTreeBackend>
 class s21_map {
+ public:
+  typedef KeyType key_type;
+  typedef ValueType mapped_type;
+  typedef std::pair<const KeyType, ValueType> value_type;
+  typedef Compare key_compare;
+  typedef size_t size_type;
+
  private:
-  enum class Color { RED, BLACK };
-
-  struct Node {
-    KeyType key;
-    ValueType value;
-    Color color;
-    std::shared_ptr<Node> left, right, parent;
-
-    Node(const KeyType& key, const ValueType& value)
-        : key(key),
-          value(value),
-          color(Color::RED),
-          left(nullptr),
-          right(nullptr),
-          parent(nullptr) {}
+  // Сравнивает элементы только по ключу; умеет сравнивать элемент и с
+  // голым ключом (или с любым типом, который принимает Compare), чтобы
+  // поиск не строил временную пару
+  struct KeyCompare {
+    typedef void is_transparent;
+
+    Compare comp;
+
+    bool operator()(const value_type& a, const value_type& b) const {
+      return comp(a.first, b.first);
+    }
+    template <typename Key>
+    bool operator()(const value_type& a, const Key& key) const {
+      return comp(a.first, key);
+    }
+    template <typename Key>
+    bool operator()(const Key& key, const value_type& b) const {
+      return comp(key, b.first);
+    }
   };
 
-  std::shared_ptr<Node> root;
+  // Дерево выбирает Backend: RedBlackTreeBackend, BTreeBackend<> или
+  // CompactRedBlackTreeBackend
+  typedef typename Backend::template tree<value_type, KeyCompare, Augment>
+      tree_type;
 
-  void insert(std::shared_ptr<Node>& node, const KeyType& key,
-              const ValueType& value);
-  void fixInsert(std::shared_ptr<Node> z);
-  std::shared_ptr<Node> find(std::shared_ptr<Node> node,
-                             const KeyType& key) const;
-  size_t getSize(const std::shared_ptr<Node>& node) const;
-  std::shared_ptr<Node> minimum(std::shared_ptr<Node> node) const;
-  void transplant(std::shared_ptr<Node> u, std::shared_ptr<Node> v);
-  bool isEqual(const std::shared_ptr<Node>& node1,
-               const std::shared_ptr<Node>& node2) const;
-  int isRedBlackTreeHelper(std::shared_ptr<Node> node) const;
+  // Балансировка, удаление и арена узлов - общие с RedBlackTree
+  tree_type tree;
 
  public:
+  // Вынутая пара: переносится в другой map без копирования
+  typedef typename tree_type::node_type node_type;
+
   s21_map();
-  std::shared_ptr<Node> getRoot() const;
+  explicit s21_map(const Compare& comp);
+  s21_map(const s21_map& other) = default;
+  s21_map(s21_map&& other) noexcept;
+  s21_map& operator=(const s21_map& other) = default;
+  s21_map& operator=(s21_map&& other) noexcept;
+  s21_map(std::initializer_list<value_type> items);
+  // Если ключи диапазона строго возрастают, дерево собирается за O(n);
+  // иначе пары вставляются по одной, повторные ключи пропускаются
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  s21_map(InputIt first, InputIt last);
+  // Заменяет содержимое парами со строго возрастающими ключами за O(n)
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
   bool isRedBlackTree() const;
-  void insert(const KeyType& key, const ValueType& value);
+  // Неизменяемый снимок за O(n) для таблиц, которые после сборки только
+  // читают: ключи в раскладке Эйтцингера, без узлов и указателей
+  s21::static_ordered_map<KeyType, ValueType, Compare> freeze() const;
+  // Двоичный снимок для тривиально копируемых ключей и значений: массив
+  // ключей, затем массив значений (его же открывает s21::map_view без
+  // копирования). load при ошибке бросает std::runtime_error и не меняет
+  // словарь
+  void save(std::ostream& out) const;
+  void load(std::istream& in);
+
+  class iterator;
+  class const_iterator;
+
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(const KeyType& key, const ValueType& value);
+  // Вставка и поиск от подсказки: для ключей, приходящих почти по
+  // возрастанию (hint - end() или последняя вставленная пара), без спуска
+  // от корня. Если ключ уже есть, insert возвращает его пару
+  iterator insert(iterator hint, const value_type& value);
+  iterator find(iterator hint, const KeyType& key);
+
+  // Перенос пар между map без копирования и выделений. Если ключ уже
+  // есть, insert оставляет пару в node, а merge - в other
+  node_type extract(const KeyType& key);
+  node_type extract(iterator pos);
+  std::pair<iterator, bool> insert(node_type&& node);
+  void merge(s21_map& other);
   const ValueType& at(const KeyType& key) const;
   ValueType& operator[](const KeyType& key);
   size_t size() const;
   bool contains(const KeyType& key) const;
+  iterator find(const KeyType& key);
+  const_iterator find(const KeyType& key) const;
+  // Пакетная проверка n ключей, например проба соединения: спуски идут
+  // вперемешку, и промахи кеша разных ключей перекрываются. out[i] - есть
+  // ли keys[i]; find_batch пишет в out итератор на каждый ключ или end()
+  void contains_batch(const KeyType* keys, size_t n, bool* out) const;
+  template <typename OutputIt>
+  OutputIt find_batch(const KeyType* keys, size_t n, OutputIt out);
+
+  // Гетерогенный поиск для прозрачного Compare (например, std::less<>):
+  // s21_map<std::string, V, std::less<>> можно искать по std::string_view
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key& key);
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const Key& key) const;
+
+  // Границы по ключу за O(log n): первая пара с ключом не меньше key,
+  // первая с ключом больше key и пара из них
+  iterator lower_bound(const KeyType& key);
+  const_iterator lower_bound(const KeyType& key) const;
+  iterator upper_bound(const KeyType& key);
+  const_iterator upper_bound(const KeyType& key) const;
+  std::pair<iterator, iterator> equal_range(const KeyType& key);
+  std::pair<const_iterator, const_iterator> equal_range(
+      const KeyType& key) const;
+  // Вызывает fn(value_type&) для пар с ключами из [lo, hi) по порядку
+  template <typename Fn>
+  void for_each_in_range(const KeyType& lo, const KeyType& hi, Fn fn);
+  template <typename Fn>
+  void for_each_in_range(const KeyType& lo, const KeyType& hi, Fn fn) const;
+
+  // Порядковые статистики по ключам, нужен Augment = OrderStatistics:
+  // k-я по порядку пара (с нуля), число ключей меньше key и число ключей
+  // в [lo, hi) - всё за O(log n)
+  iterator select(size_t k);
+  const_iterator select(size_t k) const;
+  size_t rank(const KeyType& key) const;
+  size_t count_range(const KeyType& lo, const KeyType& hi) const;
+
   bool empty() const;
   void clear();
   void erase(const KeyType& key);
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
   bool operator==(const s21_map& other) const;
   bool operator!=(const s21_map& other) const;
-  void rightRotate(std::shared_ptr<Node> x);
-  void leftRotate(std::shared_ptr<Node> x);
-
-  class iterator;
 
   template <typename... Args>
-  vector<std::pair<typename s21_map<KeyType, ValueType>::iterator, bool>>
-  insert_many(Args&&... args);
+  vector<std::pair<typename s21_map::iterator, bool>> insert_many(
+      Args&&... args);
 
   class iterator {
    private:
-    std::shared_ptr<Node> current;
-    std::shared_ptr<Node> root;
+    typename tree_type::iterator iter;
 
-   public:
-    iterator(std::shared_ptr<Node> curr, std::shared_ptr<Node> rt)
-        : current(curr), root(rt) {}
+    friend class s21_map;
+    friend class const_iterator;
 
-    iterator& operator++() { return *this; }
+   public:
+    iterator(typename tree_type::iterator it = {}) : iter(it) {}
 
-    bool operator==(const iterator& other) const {
-      return current == other.current;
+    iterator& operator++() {
+      ++iter;
+      return *this;
     }
 
+    bool operator==(const iterator& other) const { return iter == other.iter; }
+
     bool operator!=(const iterator& other) const { return !(*this == other); }
 
-    std::pair<const KeyType&, ValueType&> operator*() const {
-      return {current->key, current->value};
-    }
+    value_type& operator*() const { return *iter; }
+    value_type* operator->() const { return &*iter; }
   };
 
-  class const_iterator;
+  class const_iterator {
+   private:
+    typename tree_type::const_iterator iter;
+
+   public:
+    const_iterator(typename tree_type::const_iterator it = {}) : iter(it) {}
+    const_iterator(const iterator& it) : iter(it.iter) {}
+
+    const_iterator& operator++() {
+      ++iter;
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return iter == other.iter;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+    const value_type& operator*() const { return *iter; }
+    const value_type* operator->() const { return &*iter; }
+  };
 
   iterator begin();
   iterator end();
@@ -5,51 +5,78 @@
 
 namespace s21 {
 
-template <typename T>
-s21_multiset<T>::s21_multiset() {}
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_multiset<T, Compare, Augment, Backend>::s21_multiset() {}
 
-template <typename T>
-void s21_multiset<T>::insert(const T& value) {
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::insert(const T& value) {
   tree.insert(value);
 }
 
-template <typename T>
-void s21_multiset<T>::erase(const T& value) {
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::erase(const T& value) {
   tree.erase(value);
 }
 
-template <typename T>
-bool s21_multiset<T>::contains(const T& value) const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_multiset<T, Compare, Augment, Backend>::contains(
+    const T& value) const {
   return tree.contains(value);
 }
 
-template <typename T>
-void s21_multiset<T>::clear() {
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::clear() {
   tree.clear();
 }
 
-template <typename T>
-bool s21_multiset<T>::empty() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_multiset<T, Compare, Augment, Backend>::empty() const {
   return tree.empty();
 }
 
-template <typename T>
-size_t s21_multiset<T>::size() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_multiset<T, Compare, Augment, Backend>::size() const {
   return tree.size();
 }
 
-template <typename T>
-size_t s21_multiset<T>::max_size() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_multiset<T, Compare, Augment, Backend>::max_size() const {
   return tree.max_size();
 }
 
-template <typename T>
-typename RedBlackTree<T>::iterator s21_multiset<T>::find(const T& value) {
-  return tree.find(value);
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator
+s21_multiset<T, Compare, Augment, Backend>::find(const T& value) {
+  return tree.lookup(value);
 }
 
-template <typename T>
-bool s21_multiset<T>::operator==(const s21_multiset& other) const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::node_type
+s21_multiset<T, Compare, Augment, Backend>::extract(const T& value) {
+  return tree.extract(value);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::node_type
+s21_multiset<T, Compare, Augment, Backend>::extract(
+    typename tree_type::iterator pos) {
+  return tree.extract(pos);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator
+s21_multiset<T, Compare, Augment, Backend>::insert(node_type&& node) {
+  return tree.insert(std::move(node));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::merge(s21_multiset& other) {
+  tree.merge(other.tree);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_multiset<T, Compare, Augment, Backend>::operator==(
+    const s21_multiset& other) const {
   // Сравниваем размеры множеств
   if (size() != other.size()) {
     return false;
@@ -68,59 +95,193 @@ bool s21_multiset<T>::operator==(const s21_multiset& other) const {
   return (it1 == end() && it2 == other.end());
 }
 
-template <typename T>
-bool s21_multiset<T>::operator!=(const s21_multiset& other) const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_multiset<T, Compare, Augment, Backend>::operator!=(
+    const s21_multiset& other) const {
   return !(*this == other);
 }
 
-template <typename T>
-typename RedBlackTree<T>::iterator s21_multiset<T>::begin() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator
+s21_multiset<T, Compare, Augment, Backend>::begin()
+    const {
   return tree.begin();
 }
 
-template <typename T>
-typename RedBlackTree<T>::iterator s21_multiset<T>::end() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator
+s21_multiset<T, Compare, Augment, Backend>::end()
+    const {
   return tree.end();
 }
 
-template <typename T>
-s21_multiset<T>::s21_multiset(const s21_multiset& other) : tree(other.tree) {}
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator
+s21_multiset<T, Compare, Augment, Backend>::select(size_t k) const {
+  return tree.select(k);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_multiset<T, Compare, Augment, Backend>::rank(const T& value) const {
+  return tree.rank(value);
+}
 
-template <typename T>
-s21_multiset<T>::s21_multiset(s21_multiset&& other) noexcept
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_multiset<T, Compare, Augment, Backend>::count_range(
+    const T& lo, const T& hi) const {
+  return tree.count_range(lo, hi);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_multiset<T, Compare, Augment, Backend>::s21_multiset(
+    const s21_multiset& other)
+    : tree(other.tree) {}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_multiset<T, Compare, Augment, Backend>::s21_multiset(
+    s21_multiset&& other) noexcept
     : tree(std::move(other.tree)) {}
 
-template <typename T>
-s21_multiset<T>& s21_multiset<T>::operator=(const s21_multiset& other) {
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_multiset<T, Compare, Augment, Backend>&
+s21_multiset<T, Compare, Augment, Backend>::operator=(
+    const s21_multiset& other) {
   if (this != &other) {
     tree = other.tree;
   }
   return *this;
 }
 
-template <typename T>
-s21_multiset<T>& s21_multiset<T>::operator=(s21_multiset&& other) noexcept {
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_multiset<T, Compare, Augment, Backend>&
+s21_multiset<T, Compare, Augment, Backend>::operator=(
+    s21_multiset&& other) noexcept {
   if (this != &other) {
     tree = std::move(other.tree);
   }
   return *this;
 }
 
-template <typename T>
+template <typename T, typename Compare, typename Augment, typename Backend>
 template <typename... Args>
-vector<std::pair<typename s21_multiset<T>::iterator, bool>>
-s21_multiset<T>::insert_many(Args&&... args) {
-  vector<std::pair<typename s21_multiset<T>::iterator, bool>> results;
+vector<std::pair<
+    typename s21_multiset<T, Compare, Augment, Backend>::iterator, bool>>
+s21_multiset<T, Compare, Augment, Backend>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> results;
 
   ((void)results.emplace_back(tree.insert(std::forward<Args>(args))), ...);
 
   return results;
 }
 
-template <typename T>
-s21_multiset<T>::s21_multiset(std::initializer_list<T> init_list)
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_multiset<T, Compare, Augment, Backend>::s21_multiset(
+    std::initializer_list<T> init_list)
     : tree(init_list) {}
 
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename InputIt, typename>
+s21_multiset<T, Compare, Augment, Backend>::s21_multiset(InputIt first,
+                                                         InputIt last)
+    : tree(first, last) {}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename ForwardIt>
+void s21_multiset<T, Compare, Augment, Backend>::assign_sorted(ForwardIt first,
+                                                               ForwardIt last) {
+  tree.assign_sorted(first, last);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::save(std::ostream& out) const {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "snapshots need a trivially copyable T");
+  detail::save_tree_snapshot<T>(out, detail::snapshot_kind::multiset, tree);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::load(std::istream& in) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "snapshots need a trivially copyable T");
+  detail::load_tree_snapshot<T>(in, detail::snapshot_kind::multiset, tree);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator
+s21_multiset<T, Compare, Augment, Backend>::lower_bound(const T& value) const {
+  return tree.lower_bound(value);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator
+s21_multiset<T, Compare, Augment, Backend>::upper_bound(const T& value) const {
+  return tree.upper_bound(value);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+std::pair<
+    typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator,
+    typename s21_multiset<T, Compare, Augment, Backend>::tree_type::iterator>
+s21_multiset<T, Compare, Augment, Backend>::equal_range(const T& value) const {
+  return tree.equal_range(value);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Fn>
+void s21_multiset<T, Compare, Augment, Backend>::for_each_in_range(
+    const T& lo, const T& hi, Fn fn) const {
+  tree.for_each_in_range(lo, hi, [&fn](const T& value) { fn(value); });
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::set_union(s21_multiset other) {
+  tree.set_union(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::set_intersection(
+    s21_multiset other) {
+  tree.set_intersection(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::set_difference(
+    s21_multiset other) {
+  tree.set_difference(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Executor>
+void s21_multiset<T, Compare, Augment, Backend>::set_union(s21_multiset other,
+                                                           Executor& executor) {
+  tree.set_union(std::move(other.tree), executor);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Executor>
+void s21_multiset<T, Compare, Augment, Backend>::set_intersection(
+    s21_multiset other, Executor& executor) {
+  tree.set_intersection(std::move(other.tree), executor);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Executor>
+void s21_multiset<T, Compare, Augment, Backend>::set_difference(
+    s21_multiset other, Executor& executor) {
+  tree.set_difference(std::move(other.tree), executor);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_multiset<T, Compare, Augment, Backend>::join(s21_multiset other) {
+  tree.join(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_multiset<T, Compare, Augment, Backend>
+s21_multiset<T, Compare, Augment, Backend>::split(const T& key) {
+  return s21_multiset(tree.split(key));
+}
+
 }  // namespace s21
 
 #endif
\ No newline at end of file
@@ -5,14 +5,28 @@
 #include <stdexcept>
 
 #include "../RBTree/RedBlackTree.h"
+#include "../Snapshot/snapshot.h"
 #include "../Vector/vector.h"
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Compare = std::less<T>,
+          typename Augment = NoAugmentation,
+          typename Backend = RedBlackTreeBackend>
 class s21_multiset {
  private:
-  RedBlackTree<T> tree;
+  // Дерево выбирает Backend: RedBlackTreeBackend, BTreeBackend<> или
+  // CompactRedBlackTreeBackend
+  typedef typename Backend::template tree<T, Compare, Augment> tree_type;
+
+  tree_type tree;
+
+ public:
+  // Вынутый узел: переносится в другое мультимножество без копирования
+  typedef typename tree_type::node_type node_type;
+
+ private:
+  explicit s21_multiset(tree_type&& other) : tree(std::move(other)) {}
 
  public:
   // Объявление класса итератора
@@ -34,15 +48,40 @@ class s21_multiset {
 
   size_t max_size() const;
 
-  typename RedBlackTree<T>::iterator find(const T& value);
+  typename tree_type::iterator find(const T& value);
+
+  // Перенос узлов между мультимножествами без копирования и выделений:
+  // extract по значению вынимает первый из равных элементов, merge
+  // забирает все узлы other
+  node_type extract(const T& value);
+  node_type extract(typename tree_type::iterator pos);
+  typename tree_type::iterator insert(node_type&& node);
+  void merge(s21_multiset& other);
 
   bool operator==(const s21_multiset& other) const;
 
   bool operator!=(const s21_multiset& other) const;
 
-  typename RedBlackTree<T>::iterator begin() const;
+  typename tree_type::iterator begin() const;
+
+  typename tree_type::iterator end() const;
 
-  typename RedBlackTree<T>::iterator end() const;
+  // Границы за O(log n): первый элемент не меньше value, первый больше
+  // value и пара из них
+  typename tree_type::iterator lower_bound(const T& value) const;
+  typename tree_type::iterator upper_bound(const T& value) const;
+  std::pair<typename tree_type::iterator, typename tree_type::iterator>
+  equal_range(const T& value) const;
+  // Вызывает fn(const T&) для элементов из [lo, hi) по порядку
+  template <typename Fn>
+  void for_each_in_range(const T& lo, const T& hi, Fn fn) const;
+
+  // Порядковые статистики, нужен Augment = OrderStatistics. Равные
+  // элементы считаются по отдельности: rank(value) - число элементов
+  // меньше value, count_range(lo, hi) - число элементов в [lo, hi)
+  typename tree_type::iterator select(size_t k) const;
+  size_t rank(const T& value) const;
+  size_t count_range(const T& lo, const T& hi) const;
 
   s21_multiset(const s21_multiset& other);
 
@@ -53,20 +92,52 @@ class s21_multiset {
   s21_multiset& operator=(s21_multiset&& other) noexcept;
 
   template <typename... Args>
-  vector<std::pair<typename s21_multiset<T>::iterator, bool>> insert_many(
+  vector<std::pair<typename s21_multiset::iterator, bool>> insert_many(
       Args&&... args);
 
   s21_multiset(std::initializer_list<T> init_list);
+
+  // Упорядоченный диапазон собирается за O(n), без поворотов
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  s21_multiset(InputIt first, InputIt last);
+
+  // Заменяет содержимое упорядоченной последовательностью за O(n)
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
+
+  // Двоичный снимок (см. Snapshot/snapshot.h) для тривиально копируемых
+  // T; load при ошибке бросает std::runtime_error и не меняет контейнер
+  void save(std::ostream& out) const;
+  void load(std::istream& in);
+
+  // Объединение, пересечение и разность за O(m log(n/m + 1)): узлы other
+  // переходят в это множество без копирования. С executor (например,
+  // s21::task_scheduler) крупные поддеревья обрабатываются параллельно
+  void set_union(s21_multiset other);
+  void set_intersection(s21_multiset other);
+  void set_difference(s21_multiset other);
+  template <typename Executor>
+  void set_union(s21_multiset other, Executor& executor);
+  template <typename Executor>
+  void set_intersection(s21_multiset other, Executor& executor);
+  template <typename Executor>
+  void set_difference(s21_multiset other, Executor& executor);
+
+  // Дописывает other, все элементы которого не меньше наших, за O(log n)
+  void join(s21_multiset other);
+  // Оставляет элементы меньше key, остальные возвращает
+  s21_multiset split(const T& key);
 };
 
 // Определение класса итератора внутри класса s21_multiset
-template <typename T>
-class s21_multiset<T>::iterator {
+template <typename T, typename Compare, typename Augment, typename Backend>
+class s21_multiset<T, Compare, Augment, Backend>::iterator {
  private:
-  typename RedBlackTree<T>::iterator iter;
+  typename tree_type::iterator iter;
 
  public:
-  iterator(typename RedBlackTree<T>::iterator it) : iter(it) {}
+  iterator(typename tree_type::iterator it) : iter(it) {}
 
   T& operator*() const { return *iter; }
 
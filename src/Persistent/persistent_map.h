@@ -0,0 +1,176 @@
+#ifndef PERSISTENT_MAP_H
+#define PERSISTENT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "persistent_tree.h"
+
+namespace s21 {
+
+// Неизменяемый словарь с интерфейсом чтения s21_map. Каждое изменение
+// возвращает новую версию за O(log n), а прежняя остаётся согласованным
+// снимком: сервис конфигурации отдаёт читателям копию текущей версии
+// (O(1)) и собирает следующую, не копируя словарь целиком.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class persistent_map {
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<const Key, Value> value_type;
+  typedef Compare key_compare;
+  typedef std::size_t size_type;
+
+ private:
+  // Сравнивает пары по ключу и умеет сравнивать пару с голым ключом
+  struct KeyCompare {
+    Compare comp;
+
+    bool operator()(const value_type& a, const value_type& b) const {
+      return comp(a.first, b.first);
+    }
+    bool operator()(const value_type& a, const Key& key) const {
+      return comp(a.first, key);
+    }
+    bool operator()(const Key& key, const value_type& b) const {
+      return comp(key, b.first);
+    }
+  };
+
+  typedef persistent_tree<value_type, KeyCompare> tree_type;
+
+  explicit persistent_map(tree_type&& tree) : tree_(std::move(tree)) {}
+
+ public:
+  typedef typename tree_type::const_iterator const_iterator;
+  typedef const_iterator iterator;
+
+  persistent_map() = default;
+  explicit persistent_map(const Compare& comp) : tree_(KeyCompare{comp}) {}
+  persistent_map(std::initializer_list<value_type> items,
+                 const Compare& comp = Compare());
+  // Пары упорядочиваются и дерево строится сразу целиком; из пар с
+  // равными ключами остаётся первая
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  persistent_map(InputIt first, InputIt last, const Compare& comp = Compare());
+
+  // Версия с новой парой; если ключ уже есть, возвращается та же версия
+  persistent_map insert(const value_type& value) const {
+    return persistent_map(tree_.insert(value, false));
+  }
+  persistent_map insert(const Key& key, const Value& value) const {
+    return insert(value_type(key, value));
+  }
+  // Версия, в которой key сопоставлен value, даже если ключ уже был
+  persistent_map insert_or_assign(const Key& key, const Value& value) const {
+    return persistent_map(tree_.insert(value_type(key, value), true));
+  }
+  persistent_map erase(const Key& key) const {
+    return persistent_map(tree_.erase(key));
+  }
+
+  const Value& at(const Key& key) const;
+  bool contains(const Key& key) const { return tree_.find(key); }
+  const_iterator find(const Key& key) const;
+  const_iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  }
+  const_iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  // Вызывает fn(const value_type&) для пар с ключами из [lo, hi)
+  template <typename Fn>
+  void for_each_in_range(const Key& lo, const Key& hi, Fn fn) const;
+
+  // k-я по порядку пара (с нуля) и число ключей меньше key
+  const_iterator select(size_type k) const { return tree_.select(k); }
+  size_type rank(const Key& key) const { return tree_.rank(key); }
+
+  const_iterator begin() const { return tree_.begin(); }
+  const_iterator end() const { return tree_.end(); }
+  bool empty() const { return tree_.empty(); }
+  size_type size() const { return tree_.size(); }
+  bool is_balanced() const { return tree_.is_balanced(); }
+
+  bool operator==(const persistent_map& other) const;
+  bool operator!=(const persistent_map& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  tree_type tree_;
+};
+
+template <typename Key, typename Value, typename Compare>
+persistent_map<Key, Value, Compare>::persistent_map(
+    std::initializer_list<value_type> items, const Compare& comp)
+    : persistent_map(items.begin(), items.end(), comp) {}
+
+template <typename Key, typename Value, typename Compare>
+template <typename InputIt, typename>
+persistent_map<Key, Value, Compare>::persistent_map(InputIt first,
+                                                    InputIt last,
+                                                    const Compare& comp) {
+  // value_type с константным ключом не переставить, сортируются копии
+  std::vector<std::pair<Key, Value>> items(first, last);
+  auto less = [&comp](const std::pair<Key, Value>& a,
+                      const std::pair<Key, Value>& b) {
+    return comp(a.first, b.first);
+  };
+  std::stable_sort(items.begin(), items.end(), less);
+  items.erase(std::unique(items.begin(), items.end(),
+                          [&less](const std::pair<Key, Value>& a,
+                                  const std::pair<Key, Value>& b) {
+                            return !less(a, b);
+                          }),
+              items.end());
+  tree_ = tree_type::from_sorted(items.begin(), items.end(), KeyCompare{comp});
+}
+
+template <typename Key, typename Value, typename Compare>
+const Value& persistent_map<Key, Value, Compare>::at(const Key& key) const {
+  const value_type* item = tree_.find(key);
+  if (!item) throw std::out_of_range("Key not found");
+  return item->second;
+}
+
+template <typename Key, typename Value, typename Compare>
+typename persistent_map<Key, Value, Compare>::const_iterator
+persistent_map<Key, Value, Compare>::find(const Key& key) const {
+  const_iterator it = lower_bound(key);
+  if (it != end() && tree_.value_comp()(key, *it)) return end();
+  return it;
+}
+
+template <typename Key, typename Value, typename Compare>
+template <typename Fn>
+void persistent_map<Key, Value, Compare>::for_each_in_range(const Key& lo,
+                                                            const Key& hi,
+                                                            Fn fn) const {
+  for (auto it = lower_bound(lo); it != end(); ++it) {
+    if (!tree_.value_comp()(*it, hi)) break;
+    fn(*it);
+  }
+}
+
+template <typename Key, typename Value, typename Compare>
+bool persistent_map<Key, Value, Compare>::operator==(
+    const persistent_map& other) const {
+  if (tree_.same_version(other.tree_)) return true;
+  return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+}  // namespace s21
+
+#endif  // PERSISTENT_MAP_H
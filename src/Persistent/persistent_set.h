@@ -0,0 +1,135 @@
+#ifndef PERSISTENT_SET_H
+#define PERSISTENT_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "persistent_tree.h"
+
+namespace s21 {
+
+// Неизменяемое упорядоченное множество с интерфейсом чтения s21_set.
+// insert и erase не меняют множество, а возвращают новую версию за
+// O(log n); копирование версии стоит O(1). Читатель держит свою копию и
+// видит согласованный снимок, сколько бы версий ни выпустил писатель.
+// Опубликовать новую версию для других потоков можно, например, через
+// std::atomic_store на std::shared_ptr<const persistent_set>.
+template <typename T, typename Compare = std::less<T>>
+class persistent_set {
+ private:
+  typedef persistent_tree<T, Compare> tree_type;
+
+  explicit persistent_set(tree_type&& tree) : tree_(std::move(tree)) {}
+
+ public:
+  typedef T key_type;
+  typedef T value_type;
+  typedef Compare key_compare;
+  typedef std::size_t size_type;
+  typedef typename tree_type::const_iterator const_iterator;
+  typedef const_iterator iterator;
+
+  persistent_set() = default;
+  explicit persistent_set(const Compare& comp) : tree_(comp) {}
+  persistent_set(std::initializer_list<T> init_list,
+                 const Compare& comp = Compare());
+  // Элементы упорядочиваются и дерево строится сразу целиком за
+  // O(n log n), без n промежуточных версий; из равных остаётся первый
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  persistent_set(InputIt first, InputIt last, const Compare& comp = Compare());
+
+  persistent_set insert(const T& value) const {
+    return persistent_set(tree_.insert(value, false));
+  }
+  persistent_set erase(const T& value) const {
+    return persistent_set(tree_.erase(value));
+  }
+
+  bool contains(const T& value) const { return tree_.find(value); }
+  const_iterator find(const T& value) const;
+  const_iterator lower_bound(const T& value) const {
+    return tree_.lower_bound(value);
+  }
+  const_iterator upper_bound(const T& value) const {
+    return tree_.upper_bound(value);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const T& value) const {
+    return {lower_bound(value), upper_bound(value)};
+  }
+  // Вызывает fn(const T&) для элементов из [lo, hi) по порядку
+  template <typename Fn>
+  void for_each_in_range(const T& lo, const T& hi, Fn fn) const;
+
+  // k-й по порядку элемент (с нуля) и число элементов меньше value
+  const_iterator select(size_type k) const { return tree_.select(k); }
+  size_type rank(const T& value) const { return tree_.rank(value); }
+
+  const_iterator begin() const { return tree_.begin(); }
+  const_iterator end() const { return tree_.end(); }
+  bool empty() const { return tree_.empty(); }
+  size_type size() const { return tree_.size(); }
+  bool is_balanced() const { return tree_.is_balanced(); }
+
+  bool operator==(const persistent_set& other) const;
+  bool operator!=(const persistent_set& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  tree_type tree_;
+};
+
+template <typename T, typename Compare>
+persistent_set<T, Compare>::persistent_set(std::initializer_list<T> init_list,
+                                           const Compare& comp)
+    : persistent_set(init_list.begin(), init_list.end(), comp) {}
+
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+persistent_set<T, Compare>::persistent_set(InputIt first, InputIt last,
+                                           const Compare& comp) {
+  std::vector<T> items(first, last);
+  std::stable_sort(items.begin(), items.end(), comp);
+  items.erase(std::unique(items.begin(), items.end(),
+                          [&comp](const T& a, const T& b) {
+                            return !comp(a, b);
+                          }),
+              items.end());
+  tree_ = tree_type::from_sorted(items.begin(), items.end(), comp);
+}
+
+template <typename T, typename Compare>
+typename persistent_set<T, Compare>::const_iterator
+persistent_set<T, Compare>::find(const T& value) const {
+  const_iterator it = lower_bound(value);
+  if (it != end() && tree_.value_comp()(value, *it)) return end();
+  return it;
+}
+
+template <typename T, typename Compare>
+template <typename Fn>
+void persistent_set<T, Compare>::for_each_in_range(const T& lo, const T& hi,
+                                                   Fn fn) const {
+  for (auto it = lower_bound(lo); it != end(); ++it) {
+    if (!tree_.value_comp()(*it, hi)) break;
+    fn(*it);
+  }
+}
+
+template <typename T, typename Compare>
+bool persistent_set<T, Compare>::operator==(
+    const persistent_set& other) const {
+  if (tree_.same_version(other.tree_)) return true;
+  return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+}  // namespace s21
+
+#endif  // PERSISTENT_SET_H
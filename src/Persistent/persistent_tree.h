@@ -0,0 +1,398 @@
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Неизменяемое сбалансированное дерево - основа persistent_set и
+// persistent_map. Изменение копирует только путь от корня до места
+// правки (O(log n) узлов), остальные поддеревья новая версия делит со
+// старой. Узлы не меняются после создания и принадлежат shared_ptr, поэтому
+// старая версия остаётся целой, пока её кто-то держит, а читать её можно
+// из любых потоков без блокировок.
+//
+// Балансировка AVL, а не красно-чёрная: при копировании пути повороты
+// всё равно строят новые узлы, а у AVL перебалансировка после удаления
+// локальна и обходится без указателей на родителя. В узле хранится
+// размер поддерева, так что select и rank тоже стоят O(log n).
+template <typename T, typename Compare>
+class persistent_tree {
+ private:
+  struct Node;
+  typedef std::shared_ptr<const Node> Link;
+
+  struct Node {
+    T value;
+    Link left;
+    Link right;
+    std::size_t size;
+    unsigned char height;
+
+    Node(const Link& l, const T& v, const Link& r)
+        : value(v),
+          left(l),
+          right(r),
+          size(size_of(l) + size_of(r) + 1),
+          height(static_cast<unsigned char>(
+              std::max(height_of(l), height_of(r)) + 1)) {}
+  };
+
+ public:
+  class const_iterator;
+
+  persistent_tree() : root_(), comp_() {}
+  explicit persistent_tree(const Compare& comp) : root_(), comp_(comp) {}
+
+  // Строит идеально сбалансированное дерево из строго возрастающей
+  // последовательности за O(n)
+  template <typename ForwardIt>
+  static persistent_tree from_sorted(ForwardIt first, ForwardIt last,
+                                     const Compare& comp);
+
+  // Новая версия с value. Если равный элемент уже есть, при replace он
+  // заменяется на value, иначе возвращается та же версия
+  persistent_tree insert(const T& value, bool replace) const;
+  template <typename Key>
+  persistent_tree erase(const Key& key) const;
+
+  template <typename Key>
+  const T* find(const Key& key) const;
+  template <typename Key>
+  const_iterator lower_bound(const Key& key) const;
+  template <typename Key>
+  const_iterator upper_bound(const Key& key) const;
+  const_iterator select(std::size_t k) const;
+  template <typename Key>
+  std::size_t rank(const Key& key) const;
+
+  const_iterator begin() const;
+  const_iterator end() const { return const_iterator(); }
+  std::size_t size() const { return size_of(root_); }
+  bool empty() const { return !root_; }
+  const Compare& value_comp() const { return comp_; }
+  // Версии с общим корнем заведомо равны, сравнивать элементы не нужно
+  bool same_version(const persistent_tree& other) const {
+    return root_ == other.root_;
+  }
+
+  // Проверяет упорядоченность, высоты, размеры и баланс каждого узла
+  bool is_balanced() const;
+
+  // Итератор держит путь от корня до текущего узла: общие поддеревья
+  // не позволяют хранить в узле указатель на родителя. Действителен, пока
+  // жива версия, из которой получен
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    const_iterator() = default;
+
+    const T& operator*() const { return path_.back()->value; }
+    const T* operator->() const { return &path_.back()->value; }
+    const_iterator& operator++();
+    bool operator==(const const_iterator& other) const {
+      return path_.empty() ? other.path_.empty()
+                           : !other.path_.empty() &&
+                                 path_.back() == other.path_.back();
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    // Текущий узел и предки, к которым обход ещё вернётся (те, от
+    // которых путь ушёл влево)
+    std::vector<const Node*> path_;
+
+    friend class persistent_tree;
+  };
+
+ private:
+  static std::size_t size_of(const Link& node) {
+    return node ? node->size : 0;
+  }
+  static int height_of(const Link& node) { return node ? node->height : 0; }
+  static Link make(const Link& left, const T& value, const Link& right) {
+    return std::make_shared<const Node>(left, value, right);
+  }
+  // Собирает узел из поддеревьев, высоты которых различаются не больше
+  // чем на 2, с одним или двумя поворотами
+  static Link balance(const Link& left, const T& value, const Link& right);
+  template <typename ForwardIt>
+  static Link build(ForwardIt& first, std::size_t n);
+
+  Link insert_into(const Link& node, const T& value, bool replace,
+                   bool& changed) const;
+  template <typename Key>
+  Link erase_from(const Link& node, const Key& key, bool& changed) const;
+  static Link remove_min(const Link& node, const T*& minimum);
+  static void push_left_spine(const_iterator& it, const Node* node);
+  bool check(const Node* node, const T* lo, const T* hi) const;
+
+  persistent_tree(const Link& root, const Compare& comp)
+      : root_(root), comp_(comp) {}
+
+  Link root_;
+  Compare comp_;
+};
+
+template <typename T, typename Compare>
+template <typename ForwardIt>
+persistent_tree<T, Compare> persistent_tree<T, Compare>::from_sorted(
+    ForwardIt first, ForwardIt last, const Compare& comp) {
+  std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+  return persistent_tree(build(first, n), comp);
+}
+
+template <typename T, typename Compare>
+persistent_tree<T, Compare> persistent_tree<T, Compare>::insert(
+    const T& value, bool replace) const {
+  bool changed = false;
+  Link root = insert_into(root_, value, replace, changed);
+  return changed ? persistent_tree(root, comp_) : *this;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+persistent_tree<T, Compare> persistent_tree<T, Compare>::erase(
+    const Key& key) const {
+  bool changed = false;
+  Link root = erase_from(root_, key, changed);
+  return changed ? persistent_tree(root, comp_) : *this;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+const T* persistent_tree<T, Compare>::find(const Key& key) const {
+  const Node* node = root_.get();
+  while (node) {
+    if (comp_(key, node->value)) {
+      node = node->left.get();
+    } else if (comp_(node->value, key)) {
+      node = node->right.get();
+    } else {
+      return &node->value;
+    }
+  }
+  return nullptr;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename persistent_tree<T, Compare>::const_iterator
+persistent_tree<T, Compare>::lower_bound(const Key& key) const {
+  const_iterator it;
+  for (const Node* node = root_.get(); node;) {
+    if (comp_(node->value, key)) {
+      node = node->right.get();
+    } else {
+      it.path_.push_back(node);
+      node = node->left.get();
+    }
+  }
+  return it;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename persistent_tree<T, Compare>::const_iterator
+persistent_tree<T, Compare>::upper_bound(const Key& key) const {
+  const_iterator it;
+  for (const Node* node = root_.get(); node;) {
+    if (comp_(key, node->value)) {
+      it.path_.push_back(node);
+      node = node->left.get();
+    } else {
+      node = node->right.get();
+    }
+  }
+  return it;
+}
+
+template <typename T, typename Compare>
+typename persistent_tree<T, Compare>::const_iterator
+persistent_tree<T, Compare>::select(std::size_t k) const {
+  if (k >= size()) throw std::out_of_range("select: index out of range");
+  const_iterator it;
+  const Node* node = root_.get();
+  for (;;) {
+    std::size_t left = size_of(node->left);
+    if (k == left) break;
+    if (k < left) {
+      it.path_.push_back(node);
+      node = node->left.get();
+    } else {
+      k -= left + 1;
+      node = node->right.get();
+    }
+  }
+  it.path_.push_back(node);
+  return it;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+std::size_t persistent_tree<T, Compare>::rank(const Key& key) const {
+  std::size_t less = 0;
+  for (const Node* node = root_.get(); node;) {
+    if (comp_(node->value, key)) {
+      less += size_of(node->left) + 1;
+      node = node->right.get();
+    } else {
+      node = node->left.get();
+    }
+  }
+  return less;
+}
+
+template <typename T, typename Compare>
+typename persistent_tree<T, Compare>::const_iterator
+persistent_tree<T, Compare>::begin() const {
+  const_iterator it;
+  push_left_spine(it, root_.get());
+  return it;
+}
+
+template <typename T, typename Compare>
+bool persistent_tree<T, Compare>::is_balanced() const {
+  return check(root_.get(), nullptr, nullptr);
+}
+
+template <typename T, typename Compare>
+typename persistent_tree<T, Compare>::const_iterator&
+persistent_tree<T, Compare>::const_iterator::operator++() {
+  const Node* node = path_.back();
+  path_.pop_back();
+  push_left_spine(*this, node->right.get());
+  return *this;
+}
+
+template <typename T, typename Compare>
+typename persistent_tree<T, Compare>::Link
+persistent_tree<T, Compare>::balance(const Link& left, const T& value,
+                                     const Link& right) {
+  int lh = height_of(left), rh = height_of(right);
+  if (lh > rh + 1) {
+    if (height_of(left->left) >= height_of(left->right)) {
+      return make(left->left, left->value, make(left->right, value, right));
+    }
+    const Link& middle = left->right;
+    return make(make(left->left, left->value, middle->left), middle->value,
+                make(middle->right, value, right));
+  }
+  if (rh > lh + 1) {
+    if (height_of(right->right) >= height_of(right->left)) {
+      return make(make(left, value, right->left), right->value, right->right);
+    }
+    const Link& middle = right->left;
+    return make(make(left, value, middle->left), middle->value,
+                make(middle->right, right->value, right->right));
+  }
+  return make(left, value, right);
+}
+
+template <typename T, typename Compare>
+template <typename ForwardIt>
+typename persistent_tree<T, Compare>::Link persistent_tree<T, Compare>::build(
+    ForwardIt& first, std::size_t n) {
+  if (n == 0) return Link();
+  Link left = build(first, n / 2);
+  ForwardIt middle = first++;
+  Link right = build(first, n - n / 2 - 1);
+  return make(left, *middle, right);
+}
+
+template <typename T, typename Compare>
+typename persistent_tree<T, Compare>::Link
+persistent_tree<T, Compare>::insert_into(const Link& node, const T& value,
+                                         bool replace, bool& changed) const {
+  if (!node) {
+    changed = true;
+    return make(Link(), value, Link());
+  }
+  if (comp_(value, node->value)) {
+    Link left = insert_into(node->left, value, replace, changed);
+    return changed ? balance(left, node->value, node->right) : node;
+  }
+  if (comp_(node->value, value)) {
+    Link right = insert_into(node->right, value, replace, changed);
+    return changed ? balance(node->left, node->value, right) : node;
+  }
+  if (!replace) return node;
+  changed = true;
+  return make(node->left, value, node->right);
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename persistent_tree<T, Compare>::Link
+persistent_tree<T, Compare>::erase_from(const Link& node, const Key& key,
+                                        bool& changed) const {
+  if (!node) return node;
+  if (comp_(key, node->value)) {
+    Link left = erase_from(node->left, key, changed);
+    return changed ? balance(left, node->value, node->right) : node;
+  }
+  if (comp_(node->value, key)) {
+    Link right = erase_from(node->right, key, changed);
+    return changed ? balance(node->left, node->value, right) : node;
+  }
+  changed = true;
+  if (!node->left) return node->right;
+  if (!node->right) return node->left;
+  // Место узла занимает наименьший элемент правого поддерева; старый
+  // узел жив, пока жива исходная версия, поэтому указатель на него
+  // действителен до конца balance
+  const T* minimum = nullptr;
+  Link right = remove_min(node->right, minimum);
+  return balance(node->left, *minimum, right);
+}
+
+template <typename T, typename Compare>
+typename persistent_tree<T, Compare>::Link
+persistent_tree<T, Compare>::remove_min(const Link& node,
+                                        const T*& minimum) {
+  if (!node->left) {
+    minimum = &node->value;
+    return node->right;
+  }
+  Link left = remove_min(node->left, minimum);
+  return balance(left, node->value, node->right);
+}
+
+template <typename T, typename Compare>
+void persistent_tree<T, Compare>::push_left_spine(const_iterator& it,
+                                                  const Node* node) {
+  for (; node; node = node->left.get()) it.path_.push_back(node);
+}
+
+template <typename T, typename Compare>
+bool persistent_tree<T, Compare>::check(const Node* node, const T* lo,
+                                        const T* hi) const {
+  if (!node) return true;
+  if (lo && !comp_(*lo, node->value)) return false;
+  if (hi && !comp_(node->value, *hi)) return false;
+  int lh = height_of(node->left), rh = height_of(node->right);
+  if (lh - rh > 1 || rh - lh > 1) return false;
+  if (node->height != std::max(lh, rh) + 1) return false;
+  if (node->size != size_of(node->left) + size_of(node->right) + 1) {
+    return false;
+  }
+  return check(node->left.get(), lo, &node->value) &&
+         check(node->right.get(), &node->value, hi);
+}
+
+}  // namespace s21
+
+#endif  // PERSISTENT_TREE_H
@@ -0,0 +1,264 @@
+#ifndef INDEXED_PRIORITY_QUEUE_H
+#define INDEXED_PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Индексированная очередь с приоритетом: рядом с d-арной кучей хранится
+// индекс «ключ -> позиция в куче», поэтому contains работает за O(1), а
+// decrease_key/increase_key/erase - за O(log n) без поиска элемента.
+// В отличие от priority_queue, на вершине лежит наименьший приоритет по
+// Compare - это то, что нужно алгоритмам вроде Дейкстры и Прима.
+template <typename Key, typename Priority,
+          typename Compare = std::less<Priority>,
+          typename Hash = std::hash<Key>, std::size_t Arity = 4>
+class indexed_priority_queue {
+  static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+ public:
+  typedef Key key_type;
+  typedef Priority priority_type;
+  typedef std::pair<Key, Priority> value_type;
+  typedef std::size_t size_type;
+
+  indexed_priority_queue() {}
+  explicit indexed_priority_queue(const Compare& comp) : comp_(comp) {}
+
+  bool empty() const { return heap_.empty(); }
+  size_type size() const { return heap_.size(); }
+  bool contains(const Key& key) const { return index_.count(key) != 0; }
+  const Priority& priority(const Key& key) const;
+
+  const value_type& top() const;
+  const Key& top_key() const { return top().first; }
+  const Priority& top_priority() const { return top().second; }
+
+  void push(const Key& key, const Priority& priority);
+  value_type pop();
+  bool erase(const Key& key);
+
+  // Новый приоритет не должен быть больше (меньше) текущего по Compare
+  void decrease_key(const Key& key, const Priority& priority);
+  void increase_key(const Key& key, const Priority& priority);
+  // Ставит приоритет в любую сторону; добавляет ключ, если его не было
+  void push_or_update(const Key& key, const Priority& priority);
+
+  void reserve(size_type n);
+  void clear();
+
+ private:
+  static size_type parent(size_type i) { return (i - 1) / Arity; }
+  static size_type first_child(size_type i) { return i * Arity + 1; }
+
+  size_type position(const Key& key) const;
+  void place(size_type i, value_type&& entry);
+  void sift_up(size_type i);
+  void sift_down(size_type i);
+  void remove_at(size_type i);
+
+  std::vector<value_type> heap_;
+  std::unordered_map<Key, size_type, Hash> index_;
+  Compare comp_;
+};
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+typename indexed_priority_queue<Key, Priority, Compare, Hash,
+                                Arity>::size_type
+indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::position(
+    const Key& key) const {
+  auto it = index_.find(key);
+  if (it == index_.end()) throw std::out_of_range("Key not found");
+  return it->second;
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+const Priority&
+indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::priority(
+    const Key& key) const {
+  return heap_[position(key)].second;
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+const typename indexed_priority_queue<Key, Priority, Compare, Hash,
+                                      Arity>::value_type&
+indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::top() const {
+  if (empty()) throw std::out_of_range("Priority queue is empty");
+  return heap_.front();
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::push(
+    const Key& key, const Priority& priority) {
+  if (contains(key)) throw std::invalid_argument("Key is already in the queue");
+  // Сначала куча, потом индекс: если бросит любой из шагов, в индексе не
+  // останется ключа без элемента
+  heap_.emplace_back(key, priority);
+  try {
+    index_.emplace(key, heap_.size() - 1);
+  } catch (...) {
+    heap_.pop_back();
+    throw;
+  }
+  sift_up(heap_.size() - 1);
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+typename indexed_priority_queue<Key, Priority, Compare, Hash,
+                                Arity>::value_type
+indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::pop() {
+  if (empty()) throw std::out_of_range("Priority queue is empty");
+  value_type result = std::move(heap_.front());
+  index_.erase(result.first);
+  if (heap_.size() > 1) {
+    place(0, std::move(heap_.back()));
+    heap_.pop_back();
+    sift_down(0);
+  } else {
+    heap_.pop_back();
+  }
+  return result;
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+bool indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::erase(
+    const Key& key) {
+  auto it = index_.find(key);
+  if (it == index_.end()) return false;
+  size_type i = it->second;
+  index_.erase(it);
+  remove_at(i);
+  return true;
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::decrease_key(
+    const Key& key, const Priority& priority) {
+  size_type i = position(key);
+  if (comp_(heap_[i].second, priority))
+    throw std::invalid_argument("New priority is greater than the current");
+  heap_[i].second = priority;
+  sift_up(i);
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::increase_key(
+    const Key& key, const Priority& priority) {
+  size_type i = position(key);
+  if (comp_(priority, heap_[i].second))
+    throw std::invalid_argument("New priority is less than the current");
+  heap_[i].second = priority;
+  sift_down(i);
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash,
+                            Arity>::push_or_update(const Key& key,
+                                                   const Priority& priority) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    push(key, priority);
+    return;
+  }
+  size_type i = it->second;
+  bool up = comp_(priority, heap_[i].second);
+  heap_[i].second = priority;
+  if (up)
+    sift_up(i);
+  else
+    sift_down(i);
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::reserve(
+    size_type n) {
+  heap_.reserve(n);
+  index_.reserve(n);
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::clear() {
+  heap_.clear();
+  index_.clear();
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::place(
+    size_type i, value_type&& entry) {
+  heap_[i] = std::move(entry);
+  index_[heap_[i].first] = i;
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::sift_up(
+    size_type i) {
+  value_type entry = std::move(heap_[i]);
+  while (i > 0) {
+    size_type p = parent(i);
+    if (!comp_(entry.second, heap_[p].second)) break;
+    place(i, std::move(heap_[p]));
+    i = p;
+  }
+  place(i, std::move(entry));
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::sift_down(
+    size_type i) {
+  size_type n = heap_.size();
+  value_type entry = std::move(heap_[i]);
+  for (;;) {
+    size_type child = first_child(i);
+    if (child >= n) break;
+    size_type last = child + Arity < n ? child + Arity : n;
+    size_type best = child;
+    for (size_type c = child + 1; c < last; ++c) {
+      if (comp_(heap_[c].second, heap_[best].second)) best = c;
+    }
+    if (!comp_(heap_[best].second, entry.second)) break;
+    place(i, std::move(heap_[best]));
+    i = best;
+  }
+  place(i, std::move(entry));
+}
+
+template <typename Key, typename Priority, typename Compare, typename Hash,
+          std::size_t Arity>
+void indexed_priority_queue<Key, Priority, Compare, Hash, Arity>::remove_at(
+    size_type i) {
+  size_type last = heap_.size() - 1;
+  if (i == last) {
+    heap_.pop_back();
+    return;
+  }
+  bool up = comp_(heap_[last].second, heap_[i].second);
+  place(i, std::move(heap_[last]));
+  heap_.pop_back();
+  if (up)
+    sift_up(i);
+  else
+    sift_down(i);
+}
+
+}  // namespace s21
+
+#endif  // INDEXED_PRIORITY_QUEUE_H
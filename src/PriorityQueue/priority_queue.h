@@ -0,0 +1,180 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Очередь с приоритетом на d-арной куче. Элементы лежат подряд в
+// std::vector (наш vector построен на списке и непрерывности не даёт).
+// При Arity = 4 все потомки узла обычно попадают в одну кеш-линию, а
+// высота кучи вдвое меньше, чем у двоичной. Как и std::priority_queue,
+// на вершине находится наибольший элемент по Compare.
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class priority_queue {
+  static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+ public:
+  typedef T value_type;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef Compare value_compare;
+
+  priority_queue() : comp_() {}
+  explicit priority_queue(const Compare& comp) : comp_(comp) {}
+  template <typename InputIt>
+  priority_queue(InputIt first, InputIt last, const Compare& comp = Compare());
+  priority_queue(std::initializer_list<T> init_list,
+                 const Compare& comp = Compare());
+
+  const_reference top() const;
+  bool empty() const { return heap_.empty(); }
+  size_type size() const { return heap_.size(); }
+
+  void push(const T& value);
+  void push(T&& value);
+  template <typename... Args>
+  void emplace(Args&&... args);
+  template <typename InputIt>
+  void push_range(InputIt first, InputIt last);
+  T pop();
+
+  void reserve(size_type n) { heap_.reserve(n); }
+  void clear() { heap_.clear(); }
+  void swap(priority_queue& other);
+
+ private:
+  static size_type parent(size_type i) { return (i - 1) / Arity; }
+  static size_type first_child(size_type i) { return i * Arity + 1; }
+
+  void sift_up(size_type i);
+  void sift_down(size_type i);
+  void heapify();
+
+  std::vector<T> heap_;
+  Compare comp_;
+};
+
+template <typename T, typename Compare, std::size_t Arity>
+template <typename InputIt>
+priority_queue<T, Compare, Arity>::priority_queue(InputIt first, InputIt last,
+                                                  const Compare& comp)
+    : heap_(first, last), comp_(comp) {
+  heapify();
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+priority_queue<T, Compare, Arity>::priority_queue(
+    std::initializer_list<T> init_list, const Compare& comp)
+    : heap_(init_list), comp_(comp) {
+  heapify();
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+typename priority_queue<T, Compare, Arity>::const_reference
+priority_queue<T, Compare, Arity>::top() const {
+  if (empty()) throw std::out_of_range("Priority queue is empty");
+  return heap_.front();
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::push(const T& value) {
+  heap_.push_back(value);
+  sift_up(heap_.size() - 1);
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::push(T&& value) {
+  heap_.push_back(std::move(value));
+  sift_up(heap_.size() - 1);
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+template <typename... Args>
+void priority_queue<T, Compare, Arity>::emplace(Args&&... args) {
+  heap_.emplace_back(std::forward<Args>(args)...);
+  sift_up(heap_.size() - 1);
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+template <typename InputIt>
+void priority_queue<T, Compare, Arity>::push_range(InputIt first,
+                                                   InputIt last) {
+  size_type old_size = heap_.size();
+  heap_.insert(heap_.end(), first, last);
+  size_type added = heap_.size() - old_size;
+  // Если добавили много, дешевле перестроить кучу целиком за O(n)
+  if (added > old_size / 2) {
+    heapify();
+  } else {
+    for (size_type i = old_size; i < heap_.size(); ++i) sift_up(i);
+  }
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+T priority_queue<T, Compare, Arity>::pop() {
+  if (empty()) throw std::out_of_range("Priority queue is empty");
+  T value = std::move(heap_.front());
+  if (heap_.size() > 1) {
+    heap_.front() = std::move(heap_.back());
+    heap_.pop_back();
+    sift_down(0);
+  } else {
+    heap_.pop_back();
+  }
+  return value;
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::swap(priority_queue& other) {
+  using std::swap;
+  swap(heap_, other.heap_);
+  swap(comp_, other.comp_);
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::sift_up(size_type i) {
+  T value = std::move(heap_[i]);
+  while (i > 0) {
+    size_type p = parent(i);
+    if (!comp_(heap_[p], value)) break;
+    heap_[i] = std::move(heap_[p]);
+    i = p;
+  }
+  heap_[i] = std::move(value);
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::sift_down(size_type i) {
+  size_type n = heap_.size();
+  T value = std::move(heap_[i]);
+  for (;;) {
+    size_type child = first_child(i);
+    if (child >= n) break;
+    size_type last = child + Arity < n ? child + Arity : n;
+    size_type best = child;
+    for (size_type c = child + 1; c < last; ++c) {
+      if (comp_(heap_[best], heap_[c])) best = c;
+    }
+    if (!comp_(value, heap_[best])) break;
+    heap_[i] = std::move(heap_[best]);
+    i = best;
+  }
+  heap_[i] = std::move(value);
+}
+
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::heapify() {
+  if (heap_.size() < 2) return;
+  for (size_type i = parent(heap_.size() - 1) + 1; i-- > 0;) sift_down(i);
+}
+
+}  // namespace s21
+
+#endif  // PRIORITY_QUEUE_H
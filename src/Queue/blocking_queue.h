@@ -0,0 +1,188 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "queue.h"
+
+namespace s21 {
+
+// Потокобезопасная очередь поверх Queue<T> с ограничением ёмкости.
+// push блокируется, пока очередь заполнена (обратное давление на
+// производителей), pop_wait/pop_for ждут появления элемента, а drain
+// забирает сразу пачку элементов за один захват мьютекса.
+// После close() новые элементы не принимаются, а потребители дочитывают
+// остаток и получают false.
+template <typename T>
+class blocking_queue {
+ public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+
+  explicit blocking_queue(
+      size_type capacity = std::numeric_limits<size_type>::max());
+
+  blocking_queue(const blocking_queue&) = delete;
+  blocking_queue& operator=(const blocking_queue&) = delete;
+
+  // false, если очередь закрыта; rvalue перемещается без копии, так что
+  // подходят и move-only типы вроде std::unique_ptr
+  bool push(const T& value) { return push_impl(value); }
+  bool push(T&& value) { return push_impl(std::move(value)); }
+  bool try_push(const T& value) { return try_push_impl(value); }
+  bool try_push(T&& value) { return try_push_impl(std::move(value)); }
+
+  bool pop_wait(T& value);  // false, если очередь закрыта и пуста
+  template <typename Rep, typename Period>
+  bool pop_for(T& value, const std::chrono::duration<Rep, Period>& timeout);
+  bool try_pop(T& value);
+
+  // Ждёт хотя бы один элемент и дописывает в out до max_n элементов
+  // (out - любой контейнер с push_back). Возвращает число забранных,
+  // 0 - только если очередь закрыта и пуста.
+  template <typename Container>
+  size_type drain(Container& out, size_type max_n);
+
+  void close();
+  bool closed() const;
+
+  size_type size() const;
+  bool empty() const;
+  size_type capacity() const { return capacity_; }
+
+ private:
+  template <typename U>
+  bool push_impl(U&& value);
+  template <typename U>
+  bool try_push_impl(U&& value);
+  T take_front();
+
+  Queue<T> queue_;
+  const size_type capacity_;
+  bool closed_;
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+};
+
+template <typename T>
+blocking_queue<T>::blocking_queue(size_type capacity)
+    : capacity_(capacity), closed_(false) {
+  if (capacity == 0) throw std::invalid_argument("Capacity must be positive");
+}
+
+template <typename T>
+T blocking_queue<T>::take_front() {
+  T value = queue_.pop();
+  not_full_.notify_one();
+  return value;
+}
+
+template <typename T>
+template <typename U>
+bool blocking_queue<T>::push_impl(U&& value) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_full_.wait(lock,
+                 [this] { return closed_ || queue_.size() < capacity_; });
+  if (closed_) return false;
+  queue_.push(std::forward<U>(value));
+  lock.unlock();
+  not_empty_.notify_one();
+  return true;
+}
+
+template <typename T>
+template <typename U>
+bool blocking_queue<T>::try_push_impl(U&& value) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (closed_ || queue_.size() >= capacity_) return false;
+  queue_.push(std::forward<U>(value));
+  lock.unlock();
+  not_empty_.notify_one();
+  return true;
+}
+
+template <typename T>
+bool blocking_queue<T>::pop_wait(T& value) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_empty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+  if (queue_.empty()) return false;
+  value = take_front();
+  return true;
+}
+
+template <typename T>
+template <typename Rep, typename Period>
+bool blocking_queue<T>::pop_for(
+    T& value, const std::chrono::duration<Rep, Period>& timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!not_empty_.wait_for(lock, timeout,
+                           [this] { return closed_ || !queue_.empty(); }) ||
+      queue_.empty())
+    return false;
+  value = take_front();
+  return true;
+}
+
+template <typename T>
+bool blocking_queue<T>::try_pop(T& value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (queue_.empty()) return false;
+  value = take_front();
+  return true;
+}
+
+template <typename T>
+template <typename Container>
+typename blocking_queue<T>::size_type blocking_queue<T>::drain(
+    Container& out, size_type max_n) {
+  if (max_n == 0) return 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_empty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+  size_type taken = 0;
+  while (taken < max_n && !queue_.empty()) {
+    out.push_back(queue_.pop());
+    ++taken;
+  }
+  lock.unlock();
+  if (taken > 0) not_full_.notify_all();
+  return taken;
+}
+
+template <typename T>
+void blocking_queue<T>::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  not_empty_.notify_all();
+  not_full_.notify_all();
+}
+
+template <typename T>
+bool blocking_queue<T>::closed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return closed_;
+}
+
+template <typename T>
+typename blocking_queue<T>::size_type blocking_queue<T>::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+template <typename T>
+bool blocking_queue<T>::empty() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.empty();
+}
+
+}  // namespace s21
+
+#endif  // BLOCKING_QUEUE_H
@@ -0,0 +1,247 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "../RBTree/Hardware.h"
+
+namespace s21 {
+
+// Ограниченная lock-free очередь для многих производителей и потребителей
+// (схема Вьюкова: у каждой ячейки свой счётчик последовательности).
+// Ёмкость фиксируется в конструкторе и округляется вверх до степени двойки
+// (не меньше двух).
+// Блокирующие push/pop сначала крутятся, затем уступают квант, и только
+// после этого засыпают на условной переменной. Производители и потребители
+// трогают мьютекс лишь тогда, когда кто-то действительно спит.
+template <typename T>
+class mpmc_queue {
+ public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+
+  explicit mpmc_queue(size_type capacity);
+  ~mpmc_queue();
+
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  bool try_push(const T& value) { return emplace_impl(value); }
+  bool try_push(T&& value) { return emplace_impl(std::move(value)); }
+  bool try_pop(T& value);
+
+  void push(const T& value) { push_wait(value); }
+  void push(T&& value) { push_wait(std::move(value)); }
+  T pop();
+
+  size_type capacity() const { return mask_ + 1; }
+  // Приблизительный размер: при конкурентном доступе может устареть сразу
+  size_type size_approx() const;
+  bool empty_approx() const { return size_approx() == 0; }
+
+ private:
+  struct Cell {
+    std::atomic<size_type> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T* value() { return std::launder(reinterpret_cast<T*>(&storage)); }
+  };
+
+  // Парковка ожидающих потоков: счётчик спящих и номер эпохи под мьютексом
+  struct Parking {
+    std::atomic<unsigned> waiters{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned long epoch = 0;
+
+    void notify() {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (waiters.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++epoch;
+        cv.notify_all();
+      }
+    }
+  };
+
+  static constexpr int kSpinIterations = 64;
+  static constexpr int kYieldIterations = 16;
+
+  template <typename U>
+  bool emplace_impl(U&& value);
+  // Забирает элемент из головы и передаёт его в sink(T&&); false, если
+  // очередь пуста
+  template <typename Sink>
+  bool take_impl(Sink sink);
+  template <typename U>
+  void push_wait(U&& value);
+  template <typename TryOp>
+  static void wait_until(Parking& parking, TryOp try_op);
+
+  Cell* buffer_;
+  size_type mask_;
+  alignas(detail::kCacheLine) std::atomic<size_type> enqueue_pos_;
+  alignas(detail::kCacheLine) std::atomic<size_type> dequeue_pos_;
+  alignas(detail::kCacheLine) Parking not_empty_;
+  Parking not_full_;
+};
+
+template <typename T>
+mpmc_queue<T>::mpmc_queue(size_type capacity) {
+  if (capacity == 0) throw std::invalid_argument("Capacity must be positive");
+  // В кольце из одной ячейки заполненная ячейка выглядит свободной для
+  // следующего push: её sequence уже равна следующей позиции. Поэтому
+  // ячеек минимум две
+  size_type rounded = 2;
+  while (rounded < capacity) rounded <<= 1;
+  buffer_ = static_cast<Cell*>(::operator new(sizeof(Cell) * rounded));
+  for (size_type i = 0; i < rounded; ++i) {
+    new (&buffer_[i].sequence) std::atomic<size_type>(i);
+  }
+  mask_ = rounded - 1;
+  enqueue_pos_.store(0, std::memory_order_relaxed);
+  dequeue_pos_.store(0, std::memory_order_relaxed);
+}
+
+template <typename T>
+mpmc_queue<T>::~mpmc_queue() {
+  size_type head = dequeue_pos_.load(std::memory_order_relaxed);
+  size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+  for (; head != tail; ++head) buffer_[head & mask_].value()->~T();
+  for (size_type i = 0; i <= mask_; ++i) {
+    buffer_[i].sequence.~atomic<size_type>();
+  }
+  ::operator delete(buffer_);
+}
+
+template <typename T>
+template <typename U>
+bool mpmc_queue<T>::emplace_impl(U&& value) {
+  Cell* cell;
+  size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &buffer_[pos & mask_];
+    size_type seq = cell->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::ptrdiff_t>(seq) -
+                static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  new (&cell->storage) T(std::forward<U>(value));
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  not_empty_.notify();
+  return true;
+}
+
+template <typename T>
+bool mpmc_queue<T>::try_pop(T& value) {
+  return take_impl([&value](T&& item) { value = std::move(item); });
+}
+
+template <typename T>
+template <typename Sink>
+bool mpmc_queue<T>::take_impl(Sink sink) {
+  Cell* cell;
+  size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &buffer_[pos & mask_];
+    size_type seq = cell->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::ptrdiff_t>(seq) -
+                static_cast<std::ptrdiff_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  T* stored = cell->value();
+  sink(std::move(*stored));
+  stored->~T();
+  cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+  not_full_.notify();
+  return true;
+}
+
+template <typename T>
+template <typename TryOp>
+void mpmc_queue<T>::wait_until(Parking& parking, TryOp try_op) {
+  for (int i = 0; i < kSpinIterations; ++i) {
+    if (try_op()) return;
+    detail::cpu_relax();
+  }
+  for (int i = 0; i < kYieldIterations; ++i) {
+    if (try_op()) return;
+    std::this_thread::yield();
+  }
+  // try_op выполняется без мьютекса: удачная операция будит парковку
+  // встречной стороны, и захват её мьютекса под своим привёл бы к взаимной
+  // блокировке спящих производителя и потребителя. Пропущенного
+  // пробуждения нет: эпоха запоминается до попытки, а notify увеличивает
+  // её, если видит ожидающего
+  parking.waiters.fetch_add(1, std::memory_order_relaxed);
+  try {
+    for (;;) {
+      unsigned long epoch;
+      {
+        std::lock_guard<std::mutex> lock(parking.mutex);
+        epoch = parking.epoch;
+      }
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (try_op()) break;
+      std::unique_lock<std::mutex> lock(parking.mutex);
+      parking.cv.wait(lock, [&] { return parking.epoch != epoch; });
+    }
+  } catch (...) {
+    parking.waiters.fetch_sub(1, std::memory_order_relaxed);
+    throw;
+  }
+  parking.waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+template <typename U>
+void mpmc_queue<T>::push_wait(U&& value) {
+  wait_until(not_full_, [&] { return emplace_impl(std::forward<U>(value)); });
+}
+
+template <typename T>
+T mpmc_queue<T>::pop() {
+  // Элемент перемещается прямо из ячейки: T не обязан иметь конструктор
+  // по умолчанию и присваивание
+  std::optional<T> value;
+  wait_until(not_empty_, [&] {
+    return take_impl([&value](T&& item) { value.emplace(std::move(item)); });
+  });
+  return std::move(*value);
+}
+
+template <typename T>
+typename mpmc_queue<T>::size_type mpmc_queue<T>::size_approx() const {
+  size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+  size_type head = dequeue_pos_.load(std::memory_order_relaxed);
+  return tail > head ? tail - head : 0;
+}
+
+}  // namespace s21
+
+#endif  // MPMC_QUEUE_H
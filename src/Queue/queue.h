@@ -26,12 +26,13 @@ class Queue {
   bool empty() const { return container.empty(); }
 
   void push(const T& value) { container.push_back(value); }
+  void push(T&& value) { container.push_back(std::move(value)); }
 
   T pop() {
     if (empty()) {
       throw std::out_of_range("Queue is empty");
     }
-    T value = container.front();
+    T value = std::move(container.front());
     container.pop_front();
     return value;
   }
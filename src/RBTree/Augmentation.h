@@ -0,0 +1,75 @@
+#ifndef RB_AUGMENTATION_H
+#define RB_AUGMENTATION_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+// Политики дополнения узлов RedBlackTree. Metadata - поля, которые
+// добавляются в каждый узел, update(node) пересчитывает их по детям.
+// Дерево вызывает update снизу вверх после любого изменения формы
+// (вставка, удаление, повороты), поэтому поля узла всегда описывают его
+// поддерево. Без дополнения (NoAugmentation) узел не растёт, а пересчёт
+// вырезается на этапе компиляции.
+struct NoAugmentation {
+  static constexpr bool enabled = false;
+
+  struct Metadata {};
+
+  template <typename Node>
+  static void update(Node*) {}
+};
+
+// Размер поддерева в каждом узле: select, rank и count_range за O(log n)
+struct OrderStatistics {
+  static constexpr bool enabled = true;
+
+  struct Metadata {
+    std::size_t subtree_size = 1;
+  };
+
+  template <typename Node>
+  static std::size_t sizeOf(const Node* node) {
+    return node ? node->subtree_size : 0;
+  }
+
+  template <typename Node>
+  static void update(Node* node) {
+    node->subtree_size = 1 + sizeOf(node->left) + sizeOf(node->right);
+  }
+};
+
+// Наибольший правый конец интервалов поддерева: по нему поиск пересечений
+// отбрасывает поддеревья, где все интервалы кончаются раньше запроса.
+// Элемент дерева - пара с интервалом {low, high} в first (так устроен
+// s21::interval_tree); концы сравнивает Compare, созданный по умолчанию
+template <typename K, typename Compare = std::less<K>>
+struct MaxEndpoint {
+  static constexpr bool enabled = true;
+  typedef K endpoint_type;
+  typedef Compare endpoint_compare;
+
+  struct Metadata {
+    K max_high{};
+  };
+
+  template <typename Node>
+  static void update(Node* node) {
+    Compare less;
+    const K* high = &node->data.first.high;
+    if (node->left && less(*high, node->left->max_high)) {
+      high = &node->left->max_high;
+    }
+    if (node->right && less(*high, node->right->max_high)) {
+      high = &node->right->max_high;
+    }
+    node->max_high = *high;
+  }
+};
+
+template <typename Augment>
+struct is_max_endpoint : std::false_type {};
+template <typename K, typename Compare>
+struct is_max_endpoint<MaxEndpoint<K, Compare>> : std::true_type {};
+
+#endif  // RB_AUGMENTATION_H
@@ -0,0 +1,915 @@
+#ifndef COMPACT_RED_BLACK_TREE_CC
+#define COMPACT_RED_BLACK_TREE_CC
+
+#include "CompactRedBlackTree.h"
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>::CompactRedBlackTree()
+    : count(0), capacity(0), root(kNil) {}
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>::CompactRedBlackTree(const Compare& compare)
+    : count(0), capacity(0), root(kNil), comp(compare) {}
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>::CompactRedBlackTree(
+    std::initializer_list<T> init_list)
+    : CompactRedBlackTree(init_list.begin(), init_list.end()) {}
+
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+CompactRedBlackTree<T, Compare>::CompactRedBlackTree(InputIt first,
+                                                     InputIt last)
+    : count(0), capacity(0), root(kNil) {
+  typedef typename std::iterator_traits<InputIt>::iterator_category category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    if (std::is_sorted(first, last, comp)) {
+      buildSorted(first, last);
+      return;
+    }
+  }
+  try {
+    for (; first != last; ++first) insert(*first);
+  } catch (...) {
+    destroyAll();
+    throw;
+  }
+}
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>::CompactRedBlackTree(
+    const CompactRedBlackTree& other)
+    : count(0), capacity(0), root(kNil), comp(other.comp) {
+  if (other.count == 0) return;
+  nodes.reset(new Node[other.count]);
+  capacity = other.count;
+  try {
+    for (; count < other.count; ++count) {
+      new (&nodes[count].slot) T(other.data(count));
+    }
+  } catch (...) {
+    destroyAll();
+    throw;
+  }
+  for (Index i = 0; i < count; ++i) {
+    nodes[i].left = other.nodes[i].left;
+    nodes[i].right = other.nodes[i].right;
+    nodes[i].parentAndColor = other.nodes[i].parentAndColor;
+  }
+  root = other.root;
+}
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>::CompactRedBlackTree(
+    CompactRedBlackTree&& other) noexcept
+    : nodes(std::move(other.nodes)),
+      count(other.count),
+      capacity(other.capacity),
+      root(other.root),
+      comp(other.comp) {
+  other.count = 0;
+  other.capacity = 0;
+  other.root = kNil;
+}
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>::~CompactRedBlackTree() {
+  destroyAll();
+}
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>& CompactRedBlackTree<T, Compare>::operator=(
+    const CompactRedBlackTree& other) {
+  if (this != &other) {
+    CompactRedBlackTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+CompactRedBlackTree<T, Compare>& CompactRedBlackTree<T, Compare>::operator=(
+    CompactRedBlackTree&& other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+template <typename ForwardIt>
+CompactRedBlackTree<T, Compare> CompactRedBlackTree<T, Compare>::from_sorted(
+    ForwardIt first, ForwardIt last, const Compare& compare) {
+  CompactRedBlackTree tree(compare);
+  tree.buildSorted(first, last);
+  return tree;
+}
+
+template <typename T, typename Compare>
+template <typename ForwardIt>
+void CompactRedBlackTree<T, Compare>::assign_sorted(ForwardIt first,
+                                                    ForwardIt last) {
+  CompactRedBlackTree tree(comp);
+  tree.buildSorted(first, last);
+  swap(tree);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::relocate(std::unique_ptr<Node[]>& to,
+                                               Index newCapacity) {
+  // Если перемещение T может бросить, элементы копируются: при исключении
+  // старый массив остаётся нетронутым
+  Index moved = 0;
+  try {
+    for (; moved < count; ++moved) {
+      new (&to[moved].slot) T(std::move_if_noexcept(data(moved)));
+    }
+  } catch (...) {
+    for (Index i = 0; i < moved; ++i) to[i].data().~T();
+    throw;
+  }
+  for (Index i = 0; i < count; ++i) {
+    to[i].left = nodes[i].left;
+    to[i].right = nodes[i].right;
+    to[i].parentAndColor = nodes[i].parentAndColor;
+    data(i).~T();
+  }
+  nodes.swap(to);
+  capacity = newCapacity;
+}
+
+template <typename T, typename Compare>
+template <typename V>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::newNode(V&& value) {
+  if (count < capacity) {
+    new (&nodes[count].slot) T(std::forward<V>(value));
+  } else {
+    if (count == kNil) {
+      throw std::length_error("CompactRedBlackTree: too many elements");
+    }
+    Index grown = capacity < kNil / 2 ? std::max(capacity * 2, kFirstCapacity)
+                                      : kNil;
+    std::unique_ptr<Node[]> bigger(new Node[grown]);
+    new (&bigger[count].slot) T(std::forward<V>(value));
+    try {
+      relocate(bigger, grown);
+    } catch (...) {
+      bigger[count].data().~T();
+      throw;
+    }
+  }
+  Node& node = nodes[count];
+  node.left = kNil;
+  node.right = kNil;
+  node.parentAndColor = kNil | kRed;
+  return count++;
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::moveLast(Index hole) {
+  Index last = count - 1;
+  new (&nodes[hole].slot) T(std::move(data(last)));
+  data(last).~T();
+  nodes[hole].left = nodes[last].left;
+  nodes[hole].right = nodes[last].right;
+  nodes[hole].parentAndColor = nodes[last].parentAndColor;
+  replaceChild(parent(hole), last, hole);
+  if (left(hole) != kNil) setParent(left(hole), hole);
+  if (right(hole) != kNil) setParent(right(hole), hole);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::destroyAll() {
+  if (!std::is_trivially_destructible<T>::value) {
+    for (Index i = 0; i < count; ++i) data(i).~T();
+  }
+  nodes.reset();
+  count = 0;
+  capacity = 0;
+  root = kNil;
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::replaceChild(Index up, Index from,
+                                                   Index to) {
+  if (up == kNil)
+    root = to;
+  else if (left(up) == from)
+    nodes[up].left = to;
+  else
+    nodes[up].right = to;
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::leftRotate(Index x) {
+  Index y = right(x);
+  nodes[x].right = left(y);
+  if (left(y) != kNil) setParent(left(y), x);
+  setParent(y, parent(x));
+  replaceChild(parent(x), x, y);
+  nodes[y].left = x;
+  setParent(x, y);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::rightRotate(Index y) {
+  Index x = left(y);
+  nodes[y].left = right(x);
+  if (right(x) != kNil) setParent(right(x), y);
+  setParent(x, parent(y));
+  replaceChild(parent(y), y, x);
+  nodes[x].right = y;
+  setParent(y, x);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::link(Index up, bool asLeft, Index z) {
+  setParent(z, up);
+  if (up == kNil)
+    root = z;
+  else if (asLeft)
+    nodes[up].left = z;
+  else
+    nodes[up].right = z;
+  fixInsert(z);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::fixInsert(Index z) {
+  while (isRed(parent(z))) {
+    Index p = parent(z);
+    Index g = parent(p);
+    if (p == left(g)) {
+      Index uncle = right(g);
+      if (isRed(uncle)) {
+        setRed(p, false);
+        setRed(uncle, false);
+        setRed(g, true);
+        z = g;
+      } else {
+        if (z == right(p)) {
+          z = p;
+          leftRotate(z);
+          p = parent(z);
+        }
+        setRed(p, false);
+        setRed(g, true);
+        rightRotate(g);
+      }
+    } else {
+      Index uncle = left(g);
+      if (isRed(uncle)) {
+        setRed(p, false);
+        setRed(uncle, false);
+        setRed(g, true);
+        z = g;
+      } else {
+        if (z == left(p)) {
+          z = p;
+          rightRotate(z);
+          p = parent(z);
+        }
+        setRed(p, false);
+        setRed(g, true);
+        leftRotate(g);
+      }
+    }
+  }
+  setRed(root, false);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::transplant(Index u, Index v) {
+  replaceChild(parent(u), u, v);
+  if (v != kNil) setParent(v, parent(u));
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::unlinkNode(Index z) {
+  bool removedRed = isRed(z);
+  Index x;
+  Index xParent;
+  if (left(z) == kNil) {
+    x = right(z);
+    xParent = parent(z);
+    transplant(z, x);
+  } else if (right(z) == kNil) {
+    x = left(z);
+    xParent = parent(z);
+    transplant(z, x);
+  } else {
+    Index y = minimum(right(z));
+    removedRed = isRed(y);
+    x = right(y);
+    if (parent(y) == z) {
+      xParent = y;
+    } else {
+      xParent = parent(y);
+      transplant(y, x);
+      nodes[y].right = right(z);
+      setParent(right(y), y);
+    }
+    transplant(z, y);
+    nodes[y].left = left(z);
+    setParent(left(y), y);
+    setRed(y, isRed(z));
+  }
+  if (!removedRed) fixErase(x, xParent);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::fixErase(Index x, Index up) {
+  // x может быть пустым, поэтому его родитель передаётся отдельно
+  while (x != root && !isRed(x)) {
+    if (x == left(up)) {
+      Index w = right(up);
+      if (isRed(w)) {
+        setRed(w, false);
+        setRed(up, true);
+        leftRotate(up);
+        w = right(up);
+      }
+      if (!isRed(left(w)) && !isRed(right(w))) {
+        setRed(w, true);
+        x = up;
+        up = parent(x);
+      } else {
+        if (!isRed(right(w))) {
+          setRed(left(w), false);
+          setRed(w, true);
+          rightRotate(w);
+          w = right(up);
+        }
+        setRed(w, isRed(up));
+        setRed(up, false);
+        setRed(right(w), false);
+        leftRotate(up);
+        x = root;
+      }
+    } else {
+      Index w = left(up);
+      if (isRed(w)) {
+        setRed(w, false);
+        setRed(up, true);
+        rightRotate(up);
+        w = left(up);
+      }
+      if (!isRed(left(w)) && !isRed(right(w))) {
+        setRed(w, true);
+        x = up;
+        up = parent(x);
+      } else {
+        if (!isRed(left(w))) {
+          setRed(right(w), false);
+          setRed(w, true);
+          leftRotate(w);
+          w = left(up);
+        }
+        setRed(w, isRed(up));
+        setRed(up, false);
+        setRed(left(w), false);
+        rightRotate(up);
+        x = root;
+      }
+    }
+  }
+  if (x != kNil) setRed(x, false);
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::eraseIndex(Index z) {
+  unlinkNode(z);
+  data(z).~T();
+  Index last = count - 1;
+  if (z != last) moveLast(z);
+  --count;
+  return z != last ? last : kNil;
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::minimum(Index i) const {
+  while (left(i) != kNil) i = left(i);
+  return i;
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::maximum(Index i) const {
+  while (right(i) != kNil) i = right(i);
+  return i;
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::successor(Index i) const {
+  if (right(i) != kNil) return minimum(right(i));
+  Index up = parent(i);
+  while (up != kNil && i == right(up)) {
+    i = up;
+    up = parent(up);
+  }
+  return up;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::lowerIndex(const Key& key) const {
+  Index result = kNil;
+  for (Index i = root; i != kNil;) {
+    if (comp(data(i), key)) {
+      i = right(i);
+    } else {
+      result = i;
+      i = left(i);
+    }
+  }
+  return result;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::upperIndex(const Key& key) const {
+  Index result = kNil;
+  for (Index i = root; i != kNil;) {
+    if (comp(key, data(i))) {
+      result = i;
+      i = left(i);
+    } else {
+      i = right(i);
+    }
+  }
+  return result;
+}
+
+template <typename T, typename Compare>
+template <typename Key>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::findIndex(const Key& key) const {
+  Index i = lowerIndex(key);
+  return i != kNil && !comp(key, data(i)) ? i : kNil;
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename Fn>
+void CompactRedBlackTree<T, Compare>::lowerIndicesBatch(const Key* keys,
+                                                        size_t n,
+                                                        Fn fn) const {
+  Index cursor[kBatchLanes];
+  Index candidate[kBatchLanes];
+  for (size_t base = 0; base < n; base += kBatchLanes) {
+    const Key* group = keys + base;
+    size_t lanes = std::min(kBatchLanes, n - base);
+    for (size_t i = 0; i < lanes; ++i) {
+      cursor[i] = root;
+      candidate[i] = kNil;
+    }
+    for (bool moving = root != kNil; moving;) {
+      moving = false;
+      for (size_t i = 0; i < lanes; ++i) {
+        Index node = cursor[i];
+        if (node == kNil) continue;
+        if (!comp(data(node), group[i])) {
+          candidate[i] = node;
+          node = left(node);
+        } else {
+          node = right(node);
+        }
+        cursor[i] = node;
+        if (node != kNil) {
+          prefetchForRead(&nodes[node]);
+          moving = true;
+        }
+      }
+    }
+    for (size_t i = 0; i < lanes; ++i) fn(base + i, candidate[i]);
+  }
+}
+
+template <typename T, typename Compare>
+template <typename V>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::emplace(V&& value) {
+  // Равные элементы встают после уже имеющихся
+  Index up = kNil;
+  bool asLeft = false;
+  for (Index i = root; i != kNil;) {
+    up = i;
+    asLeft = comp(value, data(i));
+    i = asLeft ? left(i) : right(i);
+  }
+  Index z = newNode(std::forward<V>(value));
+  link(up, asLeft, z);
+  return z;
+}
+
+template <typename T, typename Compare>
+template <typename InputIt>
+void CompactRedBlackTree<T, Compare>::buildSorted(InputIt first,
+                                                  InputIt last) {
+  typedef typename std::iterator_traits<InputIt>::iterator_category category;
+  try {
+    if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                  category>::value) {
+      reserve(static_cast<size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) newNode(*first);
+  } catch (...) {
+    destroyAll();
+    throw;
+  }
+  // Средний элемент каждого отрезка - корень его поддерева. Все уровни,
+  // кроме нижнего, заполнены целиком и чёрные, нижний неполный - красный
+  int redDepth = 0;
+  while ((size_t{2} << redDepth) <= size_t{count} + 1) ++redDepth;
+  root = linkRange(0, count, kNil, 0, redDepth);
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::Index
+CompactRedBlackTree<T, Compare>::linkRange(Index lo, Index hi, Index up,
+                                           int depth, int redDepth) {
+  if (lo >= hi) return kNil;
+  Index mid = lo + (hi - lo) / 2;
+  nodes[mid].parentAndColor = up | (depth == redDepth ? kRed : 0);
+  nodes[mid].left = linkRange(lo, mid, mid, depth + 1, redDepth);
+  nodes[mid].right = linkRange(mid + 1, hi, mid, depth + 1, redDepth);
+  return mid;
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::insert(const T& value) {
+  emplace(value);
+}
+
+template <typename T, typename Compare>
+std::pair<typename CompactRedBlackTree<T, Compare>::iterator, bool>
+CompactRedBlackTree<T, Compare>::insertUnique(const T& value) {
+  Index existing = findIndex(value);
+  if (existing != kNil) return {iterator(this, existing), false};
+  return {iterator(this, emplace(value)), true};
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::insert(iterator, const T& value) {
+  return iterator(this, emplace(value));
+}
+
+template <typename T, typename Compare>
+std::pair<typename CompactRedBlackTree<T, Compare>::iterator, bool>
+CompactRedBlackTree<T, Compare>::insertUnique(iterator, const T& value) {
+  return insertUnique(value);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::erase(const T& key) {
+  Index i = findIndex(key);
+  if (i != kNil) eraseIndex(i);
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::erase(iterator pos) {
+  Index next = successor(pos.index);
+  // Следующий мог оказаться последним в массиве и переехать в ячейку pos
+  Index moved = eraseIndex(pos.index);
+  if (moved != kNil && moved == next) next = pos.index;
+  return iterator(this, next);
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::erase(iterator first, iterator last) {
+  // Удаление переносит узлы, и last перестаёт указывать куда нужно:
+  // считаем элементы заранее
+  std::size_t n = 0;
+  for (iterator it = first; it != last; ++it) ++n;
+  for (; n > 0; --n) first = erase(first);
+  return first;
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::contains_batch(const T* keys, size_t n,
+                                                     bool* out) const {
+  lowerIndicesBatch(keys, n, [this, keys, out](size_t i, Index node) {
+    out[i] = node != kNil && !comp(keys[i], data(node));
+  });
+}
+
+template <typename T, typename Compare>
+template <typename OutputIt>
+OutputIt CompactRedBlackTree<T, Compare>::find_batch(const T* keys, size_t n,
+                                                     OutputIt out) const {
+  lowerIndicesBatch(keys, n, [this, keys, &out](size_t i, Index node) {
+    bool found = node != kNil && !comp(keys[i], data(node));
+    *out++ = iterator(this, found ? node : kNil);
+  });
+  return out;
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+void CompactRedBlackTree<T, Compare>::contains_batch(const Key* keys,
+                                                     size_t n,
+                                                     bool* out) const {
+  lowerIndicesBatch(keys, n, [this, keys, out](size_t i, Index node) {
+    out[i] = node != kNil && !comp(keys[i], data(node));
+  });
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename OutputIt, typename C, typename>
+OutputIt CompactRedBlackTree<T, Compare>::find_batch(const Key* keys,
+                                                     size_t n,
+                                                     OutputIt out) const {
+  lowerIndicesBatch(keys, n, [this, keys, &out](size_t i, Index node) {
+    bool found = node != kNil && !comp(keys[i], data(node));
+    *out++ = iterator(this, found ? node : kNil);
+  });
+  return out;
+}
+
+template <typename T, typename Compare>
+bool CompactRedBlackTree<T, Compare>::contains(const T& value) const {
+  return findIndex(value) != kNil;
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+bool CompactRedBlackTree<T, Compare>::contains(const Key& key) const {
+  return findIndex(key) != kNil;
+}
+
+template <typename T, typename Compare>
+T CompactRedBlackTree<T, Compare>::find(const T& value) {
+  Index i = findIndex(value);
+  if (i == kNil) throw std::runtime_error("Element not found");
+  return data(i);
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::lookup(const T& key) const {
+  return iterator(this, findIndex(key));
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::lookup(iterator, const T& key) const {
+  return iterator(this, findIndex(key));
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::lookup(const Key& key) const {
+  return iterator(this, findIndex(key));
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::lookup(iterator, const Key& key) const {
+  return iterator(this, findIndex(key));
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::lower_bound(const T& key) const {
+  return iterator(this, lowerIndex(key));
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::upper_bound(const T& key) const {
+  return iterator(this, upperIndex(key));
+}
+
+template <typename T, typename Compare>
+std::pair<typename CompactRedBlackTree<T, Compare>::iterator,
+          typename CompactRedBlackTree<T, Compare>::iterator>
+CompactRedBlackTree<T, Compare>::equal_range(const T& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::lower_bound(const Key& key) const {
+  return iterator(this, lowerIndex(key));
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::upper_bound(const Key& key) const {
+  return iterator(this, upperIndex(key));
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename C, typename>
+std::pair<typename CompactRedBlackTree<T, Compare>::iterator,
+          typename CompactRedBlackTree<T, Compare>::iterator>
+CompactRedBlackTree<T, Compare>::equal_range(const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename T, typename Compare>
+template <typename Fn>
+void CompactRedBlackTree<T, Compare>::for_each_in_range(const T& lo,
+                                                        const T& hi,
+                                                        Fn fn) const {
+  for (Index i = lowerIndex(lo); i != kNil && comp(data(i), hi);
+       i = successor(i)) {
+    fn(data(i));
+  }
+}
+
+template <typename T, typename Compare>
+template <typename Key, typename Fn, typename C, typename>
+void CompactRedBlackTree<T, Compare>::for_each_in_range(const Key& lo,
+                                                        const Key& hi,
+                                                        Fn fn) const {
+  for (Index i = lowerIndex(lo); i != kNil && comp(data(i), hi);
+       i = successor(i)) {
+    fn(data(i));
+  }
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::node_type
+CompactRedBlackTree<T, Compare>::extract(iterator pos) {
+  node_type handle(std::move(*pos));
+  eraseIndex(pos.index);
+  return handle;
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::node_type
+CompactRedBlackTree<T, Compare>::extract(const T& key) {
+  Index i = findIndex(key);
+  if (i == kNil) return node_type();
+  return extract(iterator(this, i));
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::insert(node_type&& handle) {
+  if (handle.empty()) return end();
+  iterator result(this, emplace(std::move(*handle.item)));
+  handle.item.reset();
+  return result;
+}
+
+template <typename T, typename Compare>
+std::pair<typename CompactRedBlackTree<T, Compare>::iterator, bool>
+CompactRedBlackTree<T, Compare>::insertUnique(node_type&& handle) {
+  if (handle.empty()) return {end(), false};
+  Index existing = findIndex(*handle.item);
+  if (existing != kNil) return {iterator(this, existing), false};
+  iterator result(this, emplace(std::move(*handle.item)));
+  handle.item.reset();
+  return {result, true};
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::merge(CompactRedBlackTree& other) {
+  if (this == &other) return;
+  reserve(size_t{count} + other.count);
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    emplace(std::move(*it));
+  }
+  other.clear();
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::mergeUnique(CompactRedBlackTree& other) {
+  if (this == &other || other.empty()) return;
+  std::vector<T> kept;
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    if (contains(*it))
+      kept.push_back(std::move(*it));
+    else
+      emplace(std::move(*it));
+  }
+  other.clear();
+  other.buildSorted(kept.begin(), kept.end());
+}
+
+template <typename T, typename Compare>
+bool CompactRedBlackTree<T, Compare>::isRedBlackTree() const {
+  if (root == kNil) return count == 0;
+  if (isRed(root) || parent(root) != kNil) return false;
+  size_t seen = 0;
+  return checkSubtree(root, seen) >= 0 && seen == count;
+}
+
+template <typename T, typename Compare>
+int CompactRedBlackTree<T, Compare>::checkSubtree(Index i,
+                                                  size_t& seen) const {
+  // Возвращает чёрную высоту поддерева или -1
+  if (i == kNil) return 0;
+  if (i >= count || ++seen > count) return -1;
+  Index l = left(i), r = right(i);
+  if (l != kNil && (parent(l) != i || comp(data(i), data(l)))) return -1;
+  if (r != kNil && (parent(r) != i || comp(data(r), data(i)))) return -1;
+  if (isRed(i) && (isRed(l) || isRed(r))) return -1;
+  int lh = checkSubtree(l, seen);
+  int rh = checkSubtree(r, seen);
+  if (lh < 0 || lh != rh) return -1;
+  return lh + (isRed(i) ? 0 : 1);
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::reserve(size_t n) {
+  if (n <= capacity) return;
+  if (n > kNil) {
+    throw std::length_error("CompactRedBlackTree: too many elements");
+  }
+  std::unique_ptr<Node[]> bigger(new Node[n]);
+  relocate(bigger, static_cast<Index>(n));
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::clear() {
+  destroyAll();
+}
+
+template <typename T, typename Compare>
+bool CompactRedBlackTree<T, Compare>::empty() const {
+  return count == 0;
+}
+
+template <typename T, typename Compare>
+size_t CompactRedBlackTree<T, Compare>::size() const {
+  return count;
+}
+
+template <typename T, typename Compare>
+size_t CompactRedBlackTree<T, Compare>::max_size() const {
+  return kNil;
+}
+
+template <typename T, typename Compare>
+void CompactRedBlackTree<T, Compare>::swap(CompactRedBlackTree& other) {
+  nodes.swap(other.nodes);
+  std::swap(count, other.count);
+  std::swap(capacity, other.capacity);
+  std::swap(root, other.root);
+  std::swap(comp, other.comp);
+}
+
+template <typename T, typename Compare>
+bool CompactRedBlackTree<T, Compare>::operator==(
+    const CompactRedBlackTree& other) const {
+  if (count != other.count) return false;
+  auto it = cbegin(), other_it = other.cbegin();
+  for (; it != cend(); ++it, ++other_it) {
+    if (!(*it == *other_it)) return false;
+  }
+  return true;
+}
+
+template <typename T, typename Compare>
+T CompactRedBlackTree<T, Compare>::GetMin() const {
+  if (root == kNil) throw std::runtime_error("Tree is empty");
+  return data(minimum(root));
+}
+
+template <typename T, typename Compare>
+T CompactRedBlackTree<T, Compare>::GetMax() const {
+  if (root == kNil) throw std::runtime_error("Tree is empty");
+  return data(maximum(root));
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::begin() const {
+  return iterator(this, root == kNil ? kNil : minimum(root));
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::iterator
+CompactRedBlackTree<T, Compare>::end() const {
+  return iterator(this, kNil);
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::const_iterator
+CompactRedBlackTree<T, Compare>::cbegin() const {
+  return const_iterator(begin());
+}
+
+template <typename T, typename Compare>
+typename CompactRedBlackTree<T, Compare>::const_iterator
+CompactRedBlackTree<T, Compare>::cend() const {
+  return const_iterator(end());
+}
+
+#endif
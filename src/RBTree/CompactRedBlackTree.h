@@ -0,0 +1,317 @@
+#ifndef COMPACT_RED_BLACK_TREE_H
+#define COMPACT_RED_BLACK_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Augmentation.h"
+#include "Prefetch.h"
+
+// Красно-чёрное дерево с компактными узлами: все узлы лежат в одном
+// массиве, связи - 32-битные индексы, а цвет хранится в старшем бите
+// индекса родителя. Узел RedBlackTree<int> занимает 32 байта (три
+// указателя и цвет) плюс служебные данные арены, узел этого дерева - 16.
+// Удаление переносит последний узел массива на место удалённого, поэтому
+// массив остаётся плотным, а копия дерева - это копия массива за O(n).
+//
+// Отличия от RedBlackTree: вставка и удаление делают недействительными
+// итераторы (массив растёт и уплотняется), node_type хранит сам элемент,
+// подсказки в insert/lookup не используются, элементов не больше 2^31 - 1.
+// Порядковые статистики, операции над множествами, join и split не
+// поддерживаются.
+template <typename T, typename Compare = std::less<T>>
+class CompactRedBlackTree {
+ private:
+  typedef std::uint32_t Index;
+
+  static constexpr Index kNil = 0x7FFFFFFF;
+  static constexpr Index kRed = 0x80000000;
+  static constexpr Index kFirstCapacity = 16;
+
+  struct Node {
+    Index left;
+    Index right;
+    Index parentAndColor;  // индекс родителя, старший бит - красный цвет
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type slot;
+
+    T& data() { return *std::launder(reinterpret_cast<T*>(&slot)); }
+  };
+
+  std::unique_ptr<Node[]> nodes;
+  Index count;
+  Index capacity;
+  Index root;
+  Compare comp;
+
+  T& data(Index i) const { return nodes[i].data(); }
+  Index left(Index i) const { return nodes[i].left; }
+  Index right(Index i) const { return nodes[i].right; }
+  Index parent(Index i) const { return nodes[i].parentAndColor & ~kRed; }
+  bool isRed(Index i) const {
+    return i != kNil && (nodes[i].parentAndColor & kRed) != 0;
+  }
+  void setParent(Index i, Index p) {
+    nodes[i].parentAndColor = (nodes[i].parentAndColor & kRed) | p;
+  }
+  void setRed(Index i, bool red) {
+    nodes[i].parentAndColor = parent(i) | (red ? kRed : 0);
+  }
+
+  // Новый красный узел без связей в конце массива. При росте массива
+  // элемент строится до переноса старых: value может лежать в нём же
+  template <typename V>
+  Index newNode(V&& value);
+  // Переносит элементы в новый массив на capacity узлов
+  void relocate(std::unique_ptr<Node[]>& to, Index newCapacity);
+  // Переносит последний узел массива в освободившуюся ячейку hole
+  void moveLast(Index hole);
+  void destroyAll();
+
+  void leftRotate(Index x);
+  void rightRotate(Index y);
+  void replaceChild(Index parent, Index from, Index to);
+  void link(Index parent, bool asLeft, Index z);
+  void fixInsert(Index z);
+  void transplant(Index u, Index v);
+  void unlinkNode(Index z);
+  void fixErase(Index x, Index parent);
+  // Удаляет узел и уплотняет массив; возвращает прежний индекс узла,
+  // переехавшего в ячейку z (kNil, если переезда не было)
+  Index eraseIndex(Index z);
+
+  Index minimum(Index i) const;
+  Index maximum(Index i) const;
+  Index successor(Index i) const;
+  template <typename Key>
+  Index lowerIndex(const Key& key) const;
+  template <typename Key>
+  Index upperIndex(const Key& key) const;
+  template <typename Key>
+  Index findIndex(const Key& key) const;
+  // lowerIndex для каждого из n ключей, fn(i, index) - по порядку ключей
+  template <typename Key, typename Fn>
+  void lowerIndicesBatch(const Key* keys, size_t n, Fn fn) const;
+  template <typename V>
+  Index emplace(V&& value);
+
+  // Сборка пустого дерева из упорядоченной последовательности за O(n):
+  // элементы ложатся в массив по порядку, и i-й по величине элемент
+  // оказывается в ячейке i
+  template <typename InputIt>
+  void buildSorted(InputIt first, InputIt last);
+  Index linkRange(Index lo, Index hi, Index up, int depth, int redDepth);
+  int checkSubtree(Index i, size_t& seen) const;
+
+ public:
+  class iterator;
+  class const_iterator;
+
+  // Вынутый элемент: сам объект, перемещённый из дерева
+  class node_type {
+   private:
+    mutable std::optional<T> item;
+
+    friend class CompactRedBlackTree;
+
+    explicit node_type(T&& value) : item(std::move(value)) {}
+
+   public:
+    node_type() = default;
+    node_type(node_type&& other) noexcept : item(std::move(other.item)) {
+      other.item.reset();
+    }
+    node_type& operator=(node_type&& other) noexcept {
+      if (this != &other) {
+        item = std::move(other.item);
+        other.item.reset();
+      }
+      return *this;
+    }
+    node_type(const node_type&) = delete;
+    node_type& operator=(const node_type&) = delete;
+
+    bool empty() const { return !item; }
+    explicit operator bool() const { return item.has_value(); }
+    T& value() const { return *item; }
+  };
+
+  CompactRedBlackTree();
+  explicit CompactRedBlackTree(const Compare& compare);
+  CompactRedBlackTree(std::initializer_list<T> init_list);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  CompactRedBlackTree(InputIt first, InputIt last);
+  // Копирует массив узлов как есть: ни сравнений, ни перебалансировки
+  CompactRedBlackTree(const CompactRedBlackTree& other);
+  CompactRedBlackTree(CompactRedBlackTree&& other) noexcept;
+  ~CompactRedBlackTree();
+
+  CompactRedBlackTree& operator=(const CompactRedBlackTree& other);
+  CompactRedBlackTree& operator=(CompactRedBlackTree&& other) noexcept;
+
+  template <typename ForwardIt>
+  static CompactRedBlackTree from_sorted(ForwardIt first, ForwardIt last,
+                                         const Compare& compare = Compare());
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
+
+  void insert(const T& value);
+  std::pair<iterator, bool> insertUnique(const T& value);
+  iterator insert(iterator hint, const T& value);
+  std::pair<iterator, bool> insertUnique(iterator hint, const T& value);
+  void erase(const T& key);
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  bool contains(const T& value) const;
+  T find(const T& value);
+  iterator lookup(const T& key) const;
+  iterator lookup(iterator hint, const T& key) const;
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lookup(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lookup(iterator hint, const Key& key) const;
+
+  // Пакетный поиск, как в RedBlackTree: спуски kBatchLanes ключей идут
+  // вперемешку, следующий узел каждого запрашивается заранее
+  void contains_batch(const T* keys, size_t n, bool* out) const;
+  template <typename OutputIt>
+  OutputIt find_batch(const T* keys, size_t n, OutputIt out) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  void contains_batch(const Key* keys, size_t n, bool* out) const;
+  template <typename Key, typename OutputIt, typename C = Compare,
+            typename = typename C::is_transparent>
+  OutputIt find_batch(const Key* keys, size_t n, OutputIt out) const;
+
+  iterator lower_bound(const T& key) const;
+  iterator upper_bound(const T& key) const;
+  std::pair<iterator, iterator> equal_range(const T& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const Key& key) const;
+
+  template <typename Fn>
+  void for_each_in_range(const T& lo, const T& hi, Fn fn) const;
+  template <typename Key, typename Fn, typename C = Compare,
+            typename = typename C::is_transparent>
+  void for_each_in_range(const Key& lo, const Key& hi, Fn fn) const;
+
+  // Элемент переезжает без копирования; insertUnique(handle) при
+  // совпадении ключа оставляет элемент в handle
+  node_type extract(iterator pos);
+  node_type extract(const T& key);
+  iterator insert(node_type&& handle);
+  std::pair<iterator, bool> insertUnique(node_type&& handle);
+  void merge(CompactRedBlackTree& other);
+  void mergeUnique(CompactRedBlackTree& other);
+
+  bool isRedBlackTree() const;
+
+  // Гарантирует, что следующие вставки до n элементов не перенесут массив
+  void reserve(size_t n);
+  void clear();
+  bool empty() const;
+  size_t size() const;
+  size_t max_size() const;
+  // Байт на элемент в массиве узлов: для int - 16
+  static constexpr size_t node_bytes() { return sizeof(Node); }
+  const Compare& value_comp() const { return comp; }
+  void swap(CompactRedBlackTree& other);
+  bool operator==(const CompactRedBlackTree& other) const;
+  T GetMin() const;
+  T GetMax() const;
+
+  class iterator {
+   private:
+    const CompactRedBlackTree* tree;
+    Index index;
+
+    friend class CompactRedBlackTree;
+    friend class const_iterator;
+
+    iterator(const CompactRedBlackTree* tree, Index index)
+        : tree(tree), index(index) {}
+
+   public:
+    iterator() : tree(nullptr), index(kNil) {}
+    T& operator*() const { return tree->data(index); }
+    T* operator->() const { return &tree->data(index); }
+    iterator& operator++() {
+      if (index != kNil) index = tree->successor(index);
+      return *this;
+    }
+    bool operator==(const iterator& other) const {
+      return index == other.index;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+  };
+
+  iterator begin() const;
+  iterator end() const;
+
+  class const_iterator {
+   private:
+    const CompactRedBlackTree* tree;
+    Index index;
+
+   public:
+    const_iterator() : tree(nullptr), index(kNil) {}
+    const_iterator(const iterator& it) : tree(it.tree), index(it.index) {}
+    const T& operator*() const { return tree->data(index); }
+    const T* operator->() const { return &tree->data(index); }
+    const_iterator& operator++() {
+      if (index != kNil) index = tree->successor(index);
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const {
+      return index == other.index;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+  };
+
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+};
+
+// Выбирает компактное дерево для s21_set, s21_multiset и s21_map:
+// s21_map<K, V, std::less<K>, NoAugmentation, CompactRedBlackTreeBackend>
+struct CompactRedBlackTreeBackend {
+  template <typename T, typename Compare, typename Augment>
+  struct select {
+    static_assert(std::is_same<Augment, NoAugmentation>::value,
+                  "CompactRedBlackTree does not support augmentation");
+    typedef CompactRedBlackTree<T, Compare> type;
+  };
+
+  template <typename T, typename Compare, typename Augment>
+  using tree = typename select<T, Compare, Augment>::type;
+};
+
+#include "CompactRedBlackTree.cc"
+
+#endif  // COMPACT_RED_BLACK_TREE_H
@@ -0,0 +1,27 @@
+#ifndef HARDWARE_H
+#define HARDWARE_H
+
+#include <cstddef>
+
+namespace s21 {
+
+namespace detail {
+
+// Подсказка процессору, что мы крутимся в цикле ожидания
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// Размер строки кеша: данные разных потоков выравниваются по нему, чтобы
+// не делить одну строку
+constexpr std::size_t kCacheLine = 64;
+
+}  // namespace detail
+
+}  // namespace s21
+
+#endif  // HARDWARE_H
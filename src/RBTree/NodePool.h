@@ -0,0 +1,175 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Арена для узлов дерева. Узлы нарезаются из крупных блоков, а освобождённые
+// узлы попадают в список свободных и переиспользуются. Память блоков
+// возвращается только целиком: release() отпускает всю арену без обхода
+// узлов, поэтому для тривиально разрушаемых данных очистка дерева не
+// зависит от числа элементов.
+template <typename Node>
+class NodePool {
+ private:
+  union Slot;
+
+ public:
+  // Владение одним блоком; блоки делят арены после join и объединения
+  // деревьев
+  typedef std::shared_ptr<Slot[]> Block;
+
+  NodePool() : free_list(nullptr), cursor(nullptr), limit(nullptr) {}
+  ~NodePool() = default;
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  NodePool(NodePool&& other) noexcept : NodePool() { swap(other); }
+  NodePool& operator=(NodePool&& other) noexcept {
+    if (this != &other) {
+      release();
+      swap(other);
+    }
+    return *this;
+  }
+
+  template <typename... Args>
+  Node* create(Args&&... args);
+  void destroy(Node* node);
+
+  // Гарантирует, что следующие n узлов будут выделены без новых блоков
+  void reserve(std::size_t n);
+  // Отпускает всю память; живые узлы к этому моменту должны быть разрушены
+  // (или иметь тривиальный деструктор)
+  void release();
+  void swap(NodePool& other) noexcept;
+  // Разделяет с other владение его блоками: узлы, перешедшие из другой
+  // арены (join, объединение деревьев), живут, пока жива хотя бы одна
+  void shareBlocks(const NodePool& other);
+  // Узел в отдельном блоке из одного слота - для узла, вынутого из дерева:
+  // он не удерживает блок исходной арены, а новое дерево принимает его
+  // блок через adoptBlock
+  template <typename... Args>
+  static std::pair<Node*, Block> createSingle(Args&&... args);
+  void adoptBlock(const Block& block);
+
+ private:
+  union Slot {
+    Slot* next;
+    typename std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+  };
+
+  static constexpr std::size_t kFirstBlock = 16;
+  static constexpr std::size_t kMaxBlock = 4096;
+
+  void addBlock(std::size_t count);
+
+  static bool byAddress(const Block& a, const Block& b) {
+    return a.get() < b.get();
+  }
+
+  // Упорядочены по адресу: блок узла ищется двоичным поиском
+  std::vector<Block> blocks;
+  Slot* free_list;
+  Slot* cursor;
+  Slot* limit;
+};
+
+template <typename Node>
+template <typename... Args>
+Node* NodePool<Node>::create(Args&&... args) {
+  Slot* slot;
+  if (free_list) {
+    slot = free_list;
+    free_list = free_list->next;
+  } else {
+    if (cursor == limit) {
+      // Блоки растут вдвое: 16, 32, ... до kMaxBlock узлов
+      std::size_t shift = std::min<std::size_t>(blocks.size(), 8);
+      addBlock(std::min(kFirstBlock << shift, kMaxBlock));
+    }
+    slot = cursor++;
+  }
+  try {
+    return new (&slot->storage) Node(std::forward<Args>(args)...);
+  } catch (...) {
+    slot->next = free_list;
+    free_list = slot;
+    throw;
+  }
+}
+
+template <typename Node>
+void NodePool<Node>::destroy(Node* node) {
+  node->~Node();
+  Slot* slot = reinterpret_cast<Slot*>(node);
+  slot->next = free_list;
+  free_list = slot;
+}
+
+template <typename Node>
+void NodePool<Node>::reserve(std::size_t n) {
+  if (static_cast<std::size_t>(limit - cursor) < n) addBlock(n);
+}
+
+template <typename Node>
+void NodePool<Node>::addBlock(std::size_t count) {
+  Block block(new Slot[count]);
+  cursor = block.get();
+  limit = cursor + count;
+  auto place = std::upper_bound(blocks.begin(), blocks.end(), block, byAddress);
+  blocks.insert(place, std::move(block));
+}
+
+template <typename Node>
+void NodePool<Node>::release() {
+  blocks.clear();
+  free_list = cursor = limit = nullptr;
+}
+
+template <typename Node>
+void NodePool<Node>::shareBlocks(const NodePool& other) {
+  if (this == &other || other.blocks.empty()) return;
+  blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+  // После split/join арены часто делят одни и те же блоки - не дублируем
+  auto sameBlock = [](const Block& a, const Block& b) {
+    return a.get() == b.get();
+  };
+  std::inplace_merge(blocks.begin(), blocks.end() - other.blocks.size(),
+                     blocks.end(), byAddress);
+  blocks.erase(std::unique(blocks.begin(), blocks.end(), sameBlock),
+               blocks.end());
+}
+
+template <typename Node>
+template <typename... Args>
+std::pair<Node*, typename NodePool<Node>::Block> NodePool<Node>::createSingle(
+    Args&&... args) {
+  Block block(new Slot[1]);
+  Node* node = new (&block[0].storage) Node(std::forward<Args>(args)...);
+  return {node, std::move(block)};
+}
+
+template <typename Node>
+void NodePool<Node>::adoptBlock(const Block& block) {
+  auto place = std::lower_bound(blocks.begin(), blocks.end(), block, byAddress);
+  if (place == blocks.end() || place->get() != block.get()) {
+    blocks.insert(place, block);
+  }
+}
+
+template <typename Node>
+void NodePool<Node>::swap(NodePool& other) noexcept {
+  std::swap(blocks, other.blocks);
+  std::swap(free_list, other.free_list);
+  std::swap(cursor, other.cursor);
+  std::swap(limit, other.limit);
+}
+
+#endif  // NODE_POOL_H
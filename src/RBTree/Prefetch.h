@@ -0,0 +1,29 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include <cstddef>
+
+// Просит процессор заранее подтянуть в кеш строку с адресом p (только
+// для чтения). Сам адрес не читается, так что годится любой указатель
+inline void prefetchForRead(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(p, 0, 3);
+#else
+  (void)p;
+#endif
+}
+
+// То же для объекта в несколько строк кеша, например широкого узла
+inline void prefetchForRead(const void* p, std::size_t bytes) {
+  constexpr std::size_t kLine = 64;
+  const char* first = static_cast<const char*>(p);
+  for (std::size_t offset = 0; offset < bytes; offset += kLine) {
+    prefetchForRead(first + offset);
+  }
+}
+
+// Сколько спусков пакетного поиска идут вперемешку. Столько промахов
+// кеша успевают перекрыться, а курсоры при этом остаются в L1
+constexpr std::size_t kBatchLanes = 16;
+
+#endif  // PREFETCH_H
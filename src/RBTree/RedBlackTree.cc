@@ -3,51 +3,227 @@
 
 #include "RedBlackTree.h"
 
-template <typename T>
-RedBlackTree<T>::RedBlackTree() : root(nullptr) {}
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::RedBlackTree()
+    : root(nullptr), leftmost(nullptr), rightmost(nullptr), count(0) {}
 
-template <typename T>
-RedBlackTree<T>::RedBlackTree(std::initializer_list<T> init_list)
-    : root(nullptr) {
-  for (const T& value : init_list) {
-    insert(value);
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::RedBlackTree(const Compare& compare)
+    : root(nullptr),
+      leftmost(nullptr),
+      rightmost(nullptr),
+      count(0),
+      comp(compare) {}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::RedBlackTree(
+    std::initializer_list<T> init_list)
+    : RedBlackTree(init_list.begin(), init_list.end()) {}
+
+template <typename T, typename Compare, typename Augment>
+template <typename InputIt, typename>
+RedBlackTree<T, Compare, Augment>::RedBlackTree(InputIt first, InputIt last)
+    : root(nullptr), leftmost(nullptr), rightmost(nullptr), count(0) {
+  typedef typename std::iterator_traits<InputIt>::iterator_category category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    if (std::is_sorted(first, last, comp)) {
+      buildSorted(first, last);
+      return;
+    }
+  }
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename ForwardIt>
+RedBlackTree<T, Compare, Augment>
+RedBlackTree<T, Compare, Augment>::from_sorted(ForwardIt first, ForwardIt last,
+                                               const Compare& compare) {
+  RedBlackTree tree(compare);
+  tree.buildSorted(first, last);
+  return tree;
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename ForwardIt>
+void RedBlackTree<T, Compare, Augment>::assign_sorted(ForwardIt first,
+                                                      ForwardIt last) {
+  RedBlackTree tree(comp);
+  tree.buildSorted(first, last);
+  swap(tree);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename InputIt>
+void RedBlackTree<T, Compare, Augment>::buildSorted(InputIt first,
+                                                    InputIt last) {
+  typedef typename std::iterator_traits<InputIt>::iterator_category category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    pool.reserve(static_cast<size_t>(std::distance(first, last)));
   }
+  Node* tail = nullptr;
+  for (; first != last; ++first) {
+    Node* node = pool.create(*first);
+    if (tail) {
+      tail->right = node;
+      node->parent = tail;
+    } else {
+      root = node;
+    }
+    tail = node;
+    ++count;
+  }
+  linkChain(root, tail, count);
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::linkChain(Node* head, Node* tail,
+                                                  size_t n) {
+  // Нижний уровень сбалансированного дерева - красный, остальные чёрные:
+  // все уровни выше последнего заполнены, и чёрная высота везде одинакова
+  size_t redDepth = 0;
+  for (size_t size = n; size > 1; size >>= 1) ++redDepth;
+  count = n;
+  leftmost = head;
+  rightmost = tail;
+  root = linkBalanced(head, n, 0, redDepth);
+  if (root) root->parent = nullptr;
 }
 
-template <typename T>
-void RedBlackTree<T>::leftRotate(std::shared_ptr<Node> x) {
-  std::shared_ptr<Node> y = x->right;
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::linkBalanced(Node*& chain, size_t n,
+                                                size_t depth,
+                                                size_t redDepth) {
+  if (n == 0) return nullptr;
+  size_t leftSize = (n - 1) / 2;
+  Node* left = linkBalanced(chain, leftSize, depth + 1, redDepth);
+  Node* node = chain;
+  chain = chain->right;
+  node->left = left;
+  if (left) left->parent = node;
+  node->right = linkBalanced(chain, n - 1 - leftSize, depth + 1, redDepth);
+  if (node->right) node->right->parent = node;
+  node->color = depth == redDepth && depth != 0 ? Color::RED : Color::BLACK;
+  Augment::update(node);
+  return node;
+}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::RedBlackTree(const RedBlackTree& other)
+    : root(nullptr),
+      leftmost(nullptr),
+      rightmost(nullptr),
+      count(0),
+      comp(other.comp) {
+  // Все узлы - в одном блоке арены; форма копируется без сравнений
+  pool.reserve(other.count);
+  try {
+    cloneSubtree(other.root, nullptr, &root);
+  } catch (...) {
+    clear();
+    throw;
+  }
+  count = other.count;
+  if (root) {
+    leftmost = getMinNode(root);
+    rightmost = getMaxNode(root);
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::cloneSubtree(const Node* source,
+                                                     Node* parent,
+                                                     Node** slot) {
+  // Прямой обход: левые поддеревья рекурсией (глубина O(log n)), правая
+  // ветвь - циклом
+  while (source) {
+    Node* node = pool.create(source->data);
+    static_cast<typename Augment::Metadata&>(*node) = *source;
+    node->color = source->color;
+    node->parent = parent;
+    *slot = node;
+    cloneSubtree(source->left, node, &node->left);
+    source = source->right;
+    parent = node;
+    slot = &node->right;
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::RedBlackTree(RedBlackTree&& other) noexcept
+    : root(other.root),
+      leftmost(other.leftmost),
+      rightmost(other.rightmost),
+      pool(std::move(other.pool)),
+      count(other.count),
+      comp(other.comp) {
+  other.forgetNodes();
+}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::~RedBlackTree() {
+  clear();
+}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>& RedBlackTree<T, Compare, Augment>::operator=(
+    const RedBlackTree& other) {
+  if (this != &other) {
+    RedBlackTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>& RedBlackTree<T, Compare, Augment>::operator=(
+    RedBlackTree&& other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::leftRotate(Node* x, Node*& top) {
+  Node* y = x->right;
   x->right = y->left;
   if (y->left != nullptr) y->left->parent = x;
   y->parent = x->parent;
   if (x->parent == nullptr)
-    root = y;
+    top = y;
   else if (x == x->parent->left)
     x->parent->left = y;
   else
     x->parent->right = y;
   y->left = x;
   x->parent = y;
+  Augment::update(x);
+  Augment::update(y);
 }
 
-template <typename T>
-void RedBlackTree<T>::rightRotate(std::shared_ptr<Node> y) {
-  std::shared_ptr<Node> x = y->left;
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::rightRotate(Node* y, Node*& top) {
+  Node* x = y->left;
   y->left = x->right;
   if (x->right != nullptr) x->right->parent = y;
   x->parent = y->parent;
   if (y->parent == nullptr)
-    root = x;
+    top = x;
   else if (y == y->parent->right)
     y->parent->right = x;
   else
     y->parent->left = x;
   x->right = y;
   y->parent = x;
+  Augment::update(y);
+  Augment::update(x);
 }
 
-template <typename T>
-void RedBlackTree<T>::fixInsert(std::shared_ptr<Node> newNode) {
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::fixInsert(Node* newNode, Node*& top) {
   while (newNode->parent && newNode->parent->color == Color::RED) {
     if (newNode->parent == newNode->parent->parent->left) {
       auto uncle = newNode->parent->parent->right;
@@ -59,11 +235,11 @@ void RedBlackTree<T>::fixInsert(std::shared_ptr<Node> newNode) {
       } else {
         if (newNode == newNode->parent->right) {
           newNode = newNode->parent;
-          leftRotate(newNode);
+          leftRotate(newNode, top);
         }
         newNode->parent->color = Color::BLACK;
         newNode->parent->parent->color = Color::RED;
-        rightRotate(newNode->parent->parent);
+        rightRotate(newNode->parent->parent, top);
       }
     } else {
       auto uncle = newNode->parent->parent->left;
@@ -75,60 +251,498 @@ void RedBlackTree<T>::fixInsert(std::shared_ptr<Node> newNode) {
       } else {
         if (newNode == newNode->parent->left) {
           newNode = newNode->parent;
-          rightRotate(newNode);
+          rightRotate(newNode, top);
         }
         newNode->parent->color = Color::BLACK;
         newNode->parent->parent->color = Color::RED;
-        leftRotate(newNode->parent->parent);
+        leftRotate(newNode->parent->parent, top);
       }
     }
   }
-  root->color = Color::BLACK;
+  // Красный корень перекрашивается: чёрная высота дерева растёт на один
+  bool grew = top->color == Color::RED;
+  top->color = Color::BLACK;
+  return grew;
 }
 
-template <typename T>
-std::shared_ptr<typename RedBlackTree<T>::Node> RedBlackTree<T>::find(
-    std::shared_ptr<Node> node, const T& value) const {
-  if (!node || node->data == value) return node;
-  if (value < node->data) return find(node->left, value);
-  return find(node->right, value);
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::updatePath(Node* node) {
+  if constexpr (Augment::enabled) {
+    for (; node; node = node->parent) Augment::update(node);
+  }
 }
 
-template <typename T>
-size_t RedBlackTree<T>::getSize(const std::shared_ptr<Node>& node) const {
-  if (!node) return 0;
-  return getSize(node->left) + getSize(node->right) + 1;
+template <typename T, typename Compare, typename Augment>
+template <typename Key>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::findNode(const Key& key) const {
+  // Один вызов comp на уровень: ищем самый левый узел с data >= key,
+  // а равенство проверяем один раз в конце
+  Node* candidate = lowerNode(key);
+  if (candidate && !comp(key, candidate->data)) return candidate;
+  return nullptr;
 }
 
-template <typename T>
-void RedBlackTree<T>::insert(const T& value) {
-  auto newNode = std::make_shared<Node>(value);
-  std::shared_ptr<Node> parent = nullptr;
-  auto currentNode = root;
-  while (currentNode) {
-    parent = currentNode;
-    if (newNode->data < currentNode->data)
-      currentNode = currentNode->left;
-    else
-      currentNode = currentNode->right;
+template <typename T, typename Compare, typename Augment>
+template <typename Key>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::findNodeNear(Node* hint,
+                                                const Key& key) const {
+  // Ищем тот же самый левый узел с data >= key, но спуск начинается не от
+  // корня, а от ближайшего предка hint, в поддереве которого он заведомо
+  // лежит. Если ключ совпадает с hint или его соседом, спуска нет вовсе
+  if (!hint) hint = rightmost;
+  if (!hint) return nullptr;
+  Node* candidate;
+  if (!comp(hint->data, key)) {
+    Node* prev = hint == leftmost ? nullptr : predecessor(hint);
+    if (!prev || comp(prev->data, key)) {
+      candidate = hint;
+    } else {
+      // Ответ не правее hint: поднимаемся, пока предок, к которому пришли
+      // справа, не окажется меньше key
+      Node* node = prev;
+      while (node->parent &&
+             !(node == node->parent->right && comp(node->parent->data, key))) {
+        node = node->parent;
+      }
+      candidate = lowerNodeIn(node, key);
+    }
+  } else {
+    Node* next = hint == rightmost ? nullptr : successor(hint);
+    if (!next || !comp(next->data, key)) {
+      candidate = next;
+    } else {
+      // Ответ правее hint: первый предок, к которому пришли слева и который
+      // не меньше key, ограничивает его сверху
+      Node* node = next;
+      while (node->parent &&
+             !(node == node->parent->left && !comp(node->parent->data, key))) {
+        node = node->parent;
+      }
+      candidate = lowerNodeIn(node->parent ? node->parent : node, key);
+    }
+  }
+  if (candidate && !comp(key, candidate->data)) return candidate;
+  return nullptr;
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::lowerNode(const Key& key) const {
+  return lowerNodeIn(root, key);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::lowerNodeIn(Node* node,
+                                               const Key& key) const {
+  Node* candidate = nullptr;
+  while (node) {
+    if (!comp(node->data, key)) {
+      candidate = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return candidate;
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename Fn>
+void RedBlackTree<T, Compare, Augment>::lowerNodesBatch(const Key* keys,
+                                                        size_t n,
+                                                        Fn fn) const {
+  // Каждый шаг спускает все ключи группы на уровень и сразу запрашивает
+  // следующий узел каждого: пока он едет из памяти, сравниваются узлы
+  // остальных ключей. Обычный спуск ждал бы каждый промах по очереди
+  Node* cursor[kBatchLanes];
+  Node* candidate[kBatchLanes];
+  for (size_t base = 0; base < n; base += kBatchLanes) {
+    const Key* group = keys + base;
+    size_t lanes = std::min(kBatchLanes, n - base);
+    for (size_t i = 0; i < lanes; ++i) {
+      cursor[i] = root;
+      candidate[i] = nullptr;
+    }
+    for (bool moving = root != nullptr; moving;) {
+      moving = false;
+      for (size_t i = 0; i < lanes; ++i) {
+        Node* node = cursor[i];
+        if (!node) continue;
+        if (!comp(node->data, group[i])) {
+          candidate[i] = node;
+          node = node->left;
+        } else {
+          node = node->right;
+        }
+        cursor[i] = node;
+        if (node) {
+          prefetchForRead(node);
+          moving = true;
+        }
+      }
+    }
+    for (size_t i = 0; i < lanes; ++i) fn(base + i, candidate[i]);
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::upperNode(const Key& key) const {
+  Node* candidate = nullptr;
+  Node* node = root;
+  while (node) {
+    if (comp(key, node->data)) {
+      candidate = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return candidate;
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename Fn>
+void RedBlackTree<T, Compare, Augment>::visitRange(Node* node, const Key& lo,
+                                                   const Key& hi,
+                                                   Fn& fn) const {
+  // Спускаемся до первого узла внутри диапазона: левее него действует
+  // только нижняя граница, правее - только верхняя
+  while (node) {
+    if (comp(node->data, lo)) {
+      node = node->right;
+    } else if (!comp(node->data, hi)) {
+      node = node->left;
+    } else {
+      visitFrom(node->left, lo, fn);
+      fn(node->data);
+      visitUntil(node->right, hi, fn);
+      return;
+    }
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename Fn>
+void RedBlackTree<T, Compare, Augment>::visitFrom(Node* node, const Key& lo,
+                                                  Fn& fn) const {
+  while (node) {
+    if (comp(node->data, lo)) {
+      node = node->right;
+    } else {
+      visitFrom(node->left, lo, fn);
+      fn(node->data);
+      visitAll(node->right, fn);
+      return;
+    }
   }
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename Fn>
+void RedBlackTree<T, Compare, Augment>::visitUntil(Node* node, const Key& hi,
+                                                   Fn& fn) const {
+  while (node) {
+    if (!comp(node->data, hi)) {
+      node = node->left;
+    } else {
+      visitAll(node->left, fn);
+      fn(node->data);
+      node = node->right;
+    }
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Fn>
+void RedBlackTree<T, Compare, Augment>::visitAll(Node* node, Fn& fn) {
+  while (node) {
+    visitAll(node->left, fn);
+    fn(node->data);
+    node = node->right;
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::predecessor(Node* node) {
+  if (node->left) {
+    node = node->left;
+    while (node->right) node = node->right;
+    return node;
+  }
+  Node* parent = node->parent;
+  while (parent && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::successor(Node* node) {
+  if (node->right) {
+    node = node->right;
+    while (node->left) node = node->left;
+    return node;
+  }
+  Node* parent = node->parent;
+  while (parent && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::attach(Node* parent, bool asLeft,
+                                          const T& value) {
+  Node* node = pool.create(value);
+  // Дополнение листа зависит от его элемента (например, MaxEndpoint)
+  Augment::update(node);
+  return link(parent, asLeft, node);
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::link(Node* parent, bool asLeft,
+                                        Node* newNode) {
   newNode->parent = parent;
-  if (!parent)
-    root = newNode;
-  else if (newNode->data < parent->data)
+  if (!parent) {
+    root = leftmost = rightmost = newNode;
+  } else if (asLeft) {
     parent->left = newNode;
-  else
+    if (parent == leftmost) leftmost = newNode;
+  } else {
     parent->right = newNode;
-  fixInsert(newNode);
+    if (parent == rightmost) rightmost = newNode;
+  }
+  updatePath(parent);
+  fixInsert(newNode, root);
+  ++count;
+  return newNode;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::leafParent(const T& value,
+                                              bool& goLeft) const {
+  Node* parent = nullptr;
+  Node* currentNode = root;
+  goLeft = true;
+  while (currentNode) {
+    parent = currentNode;
+    goLeft = comp(value, currentNode->data);
+    currentNode = goLeft ? currentNode->left : currentNode->right;
+  }
+  return parent;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::equalBefore(Node* parent, bool goLeft,
+                                               const T& value) const {
+  // Равный элемент может быть только непосредственным предшественником
+  // места вставки - проверяем его одним сравнением
+  Node* previous = parent && goLeft ? predecessor(parent) : parent;
+  if (previous && !comp(previous->data, value)) return previous;
+  return nullptr;
 }
 
-template <typename T>
-bool RedBlackTree<T>::isRedBlackTree() const {
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::insertNode(const T& value) {
+  bool goLeft;
+  Node* parent = leafParent(value, goLeft);
+  return attach(parent, goLeft, value);
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::insert(const T& value) {
+  insertNode(value);
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::insert(iterator hint, const T& value) {
+  // Новый узел встаёт рядом с hint, если порядок это позволяет: левым
+  // потомком hint или правым потомком его соседа (у соседа это место
+  // заведомо свободно). Крайние узлы кешированы, поэтому вставка в конец
+  // по подсказке end() не спускается от корня
+  Node* next = hint.current;
+  if (!next) {
+    if (rightmost && !comp(value, rightmost->data)) {
+      return iterator(attach(rightmost, false, value));
+    }
+  } else if (!comp(next->data, value)) {
+    Node* prev = next == leftmost ? nullptr : predecessor(next);
+    if (!prev || !comp(value, prev->data)) {
+      if (!next->left) return iterator(attach(next, true, value));
+      return iterator(attach(prev, false, value));
+    }
+  } else {
+    Node* after = next == rightmost ? nullptr : successor(next);
+    if (!after || !comp(after->data, value)) {
+      if (!next->right) return iterator(attach(next, false, value));
+      return iterator(attach(after, true, value));
+    }
+  }
+  return iterator(insertNode(value));
+}
+
+template <typename T, typename Compare, typename Augment>
+std::pair<typename RedBlackTree<T, Compare, Augment>::iterator, bool>
+RedBlackTree<T, Compare, Augment>::insertUnique(iterator hint,
+                                                const T& value) {
+  Node* next = hint.current;
+  if (!next) {
+    if (rightmost && comp(rightmost->data, value)) {
+      return {iterator(attach(rightmost, false, value)), true};
+    }
+  } else if (comp(value, next->data)) {
+    Node* prev = next == leftmost ? nullptr : predecessor(next);
+    if (!prev || comp(prev->data, value)) {
+      if (!next->left) return {iterator(attach(next, true, value)), true};
+      return {iterator(attach(prev, false, value)), true};
+    }
+  } else if (comp(next->data, value)) {
+    Node* after = next == rightmost ? nullptr : successor(next);
+    if (!after || comp(value, after->data)) {
+      if (!next->right) return {iterator(attach(next, false, value)), true};
+      return {iterator(attach(after, true, value)), true};
+    }
+  } else {
+    return {hint, false};
+  }
+  return insertUnique(value);
+}
+
+template <typename T, typename Compare, typename Augment>
+std::pair<typename RedBlackTree<T, Compare, Augment>::iterator, bool>
+RedBlackTree<T, Compare, Augment>::insertUnique(const T& value) {
+  bool goLeft;
+  Node* parent = leafParent(value, goLeft);
+  Node* equal = equalBefore(parent, goLeft, value);
+  if (equal) return {iterator(equal), false};
+  return {iterator(attach(parent, goLeft, value)), true};
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::insert(node_type&& handle) {
+  if (handle.empty()) return end();
+  bool goLeft;
+  Node* parent = leafParent(handle.node->data, goLeft);
+  return iterator(link(parent, goLeft, adopt(handle)));
+}
+
+template <typename T, typename Compare, typename Augment>
+std::pair<typename RedBlackTree<T, Compare, Augment>::iterator, bool>
+RedBlackTree<T, Compare, Augment>::insertUnique(node_type&& handle) {
+  if (handle.empty()) return {end(), false};
+  bool goLeft;
+  Node* parent = leafParent(handle.node->data, goLeft);
+  // Если равный элемент уже есть, узел остаётся в handle
+  Node* equal = equalBefore(parent, goLeft, handle.node->data);
+  if (equal) return {iterator(equal), false};
+  return {iterator(link(parent, goLeft, adopt(handle))), true};
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::adopt(node_type& handle) {
+  pool.adoptBlock(handle.block);
+  handle.block.reset();
+  Node* node = handle.node;
+  handle.node = nullptr;
+  node->left = node->right = nullptr;
+  node->color = Color::RED;
+  Augment::update(node);
+  return node;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::node_type
+RedBlackTree<T, Compare, Augment>::extract(iterator pos) {
+  // Элемент переезжает в отдельный блок: handle, а затем и дерево, куда
+  // его вставят, не держат целый блок этой арены ради одного узла. Слот
+  // освобождается, только когда перемещение удалось
+  auto single = NodePool<Node>::createSingle(
+      std::move_if_noexcept(pos.current->data));
+  eraseNode(pos.current);
+  return node_type(single.first, std::move(single.second));
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::node_type
+RedBlackTree<T, Compare, Augment>::extract(const T& key) {
+  Node* node = findNode(key);
+  if (!node) return node_type();
+  return extract(iterator(node));
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::merge(RedBlackTree& other) {
+  if (this == &other) return;
+  // Узлы other разбираются в цепочку без балансировки other и по одному
+  // перевешиваются сюда; блоки арены other становятся общими
+  pool.shareBlocks(other.pool);
+  Chain moved;
+  flatten(other.root, moved);
+  other.forgetNodes();
+  for (Node* node = moved.head; node;) {
+    Node* next = node->right;
+    node->right = nullptr;
+    node->color = Color::RED;
+    Augment::update(node);
+    bool goLeft;
+    Node* parent = leafParent(node->data, goLeft);
+    link(parent, goLeft, node);
+    node = next;
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::mergeUnique(RedBlackTree& other) {
+  if (this == &other) return;
+  pool.shareBlocks(other.pool);
+  Chain moved, kept;
+  flatten(other.root, moved);
+  other.forgetNodes();
+  for (Node* node = moved.head; node;) {
+    Node* next = node->right;
+    bool goLeft;
+    Node* parent = leafParent(node->data, goLeft);
+    if (equalBefore(parent, goLeft, node->data)) {
+      kept.push(node);
+    } else {
+      node->right = nullptr;
+      node->color = Color::RED;
+      Augment::update(node);
+      link(parent, goLeft, node);
+    }
+    node = next;
+  }
+  // Оставшиеся узлы уже упорядочены: other собирается из них за O(k)
+  other.linkChain(kept.head, kept.tail, kept.size);
+}
+
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::isRedBlackTree() const {
   return isRedBlackTreeHelper(root) >= 0;
 }
 
-template <typename T>
-int RedBlackTree<T>::isRedBlackTreeHelper(std::shared_ptr<Node> node) const {
+template <typename T, typename Compare, typename Augment>
+int RedBlackTree<T, Compare, Augment>::isRedBlackTreeHelper(
+    const Node* node) const {
   if (!node) return 1;
 
   if (node->color == Color::RED) {
@@ -146,128 +760,819 @@ int RedBlackTree<T>::isRedBlackTreeHelper(std::shared_ptr<Node> node) const {
   return leftBlackHeight + (node->color == Color::BLACK ? 1 : 0);
 }
 
-template <typename T>
-void RedBlackTree<T>::erase(const T& key) {
-  auto z = find(root, key);
-  if (!z || z->data != key) {
-    return;
-  }
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::transplant(Node* u, Node* v) {
+  if (!u->parent)
+    root = v;
+  else if (u == u->parent->left)
+    u->parent->left = v;
+  else
+    u->parent->right = v;
+  if (v) v->parent = u->parent;
+}
 
-  std::shared_ptr<Node> y, x;
-  if (!z->left || !z->right) {
-    y = z;
-  } else {
-    y = getMinNode(z->right);
-  }
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::eraseNode(Node* z) {
+  unlinkNode(z);
+  pool.destroy(z);
+}
 
-  if (y->left) {
-    x = y->left;
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::unlinkNode(Node* z) {
+  // Узел не копируется, а перевешивается: итераторы на остальные элементы
+  // остаются валидными
+  if (z == leftmost) leftmost = successor(z);
+  if (z == rightmost) rightmost = predecessor(z);
+  Node* y = z;
+  Color removedColor = y->color;
+  Node *x, *xParent;
+  if (!z->left) {
+    x = z->right;
+    xParent = z->parent;
+    transplant(z, z->right);
+  } else if (!z->right) {
+    x = z->left;
+    xParent = z->parent;
+    transplant(z, z->left);
   } else {
+    y = getMinNode(z->right);
+    removedColor = y->color;
     x = y->right;
+    if (y->parent == z) {
+      xParent = y;
+    } else {
+      xParent = y->parent;
+      transplant(y, y->right);
+      y->right = z->right;
+      y->right->parent = y;
+    }
+    transplant(z, y);
+    y->left = z->left;
+    y->left->parent = y;
+    y->color = z->color;
   }
+  // Ниже xParent поддеревья не менялись, выше - потеряли один узел
+  updatePath(xParent);
+  if (removedColor == Color::BLACK) fixErase(x, xParent);
+  --count;
+}
 
-  if (x) {
-    x->parent = y->parent;
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::fixErase(Node* x, Node* parent) {
+  // x несёт «лишний» чёрный цвет; x может быть пустым листом, поэтому его
+  // родитель передаётся отдельно
+  while (x != root && !isRed(x)) {
+    if (x == parent->left) {
+      Node* sibling = parent->right;
+      if (isRed(sibling)) {
+        sibling->color = Color::BLACK;
+        parent->color = Color::RED;
+        leftRotate(parent, root);
+        sibling = parent->right;
+      }
+      if (!isRed(sibling->left) && !isRed(sibling->right)) {
+        sibling->color = Color::RED;
+        x = parent;
+        parent = x->parent;
+      } else {
+        if (!isRed(sibling->right)) {
+          sibling->left->color = Color::BLACK;
+          sibling->color = Color::RED;
+          rightRotate(sibling, root);
+          sibling = parent->right;
+        }
+        sibling->color = parent->color;
+        parent->color = Color::BLACK;
+        sibling->right->color = Color::BLACK;
+        leftRotate(parent, root);
+        x = root;
+      }
+    } else {
+      Node* sibling = parent->left;
+      if (isRed(sibling)) {
+        sibling->color = Color::BLACK;
+        parent->color = Color::RED;
+        rightRotate(parent, root);
+        sibling = parent->left;
+      }
+      if (!isRed(sibling->left) && !isRed(sibling->right)) {
+        sibling->color = Color::RED;
+        x = parent;
+        parent = x->parent;
+      } else {
+        if (!isRed(sibling->left)) {
+          sibling->right->color = Color::BLACK;
+          sibling->color = Color::RED;
+          leftRotate(sibling, root);
+          sibling = parent->left;
+        }
+        sibling->color = parent->color;
+        parent->color = Color::BLACK;
+        sibling->left->color = Color::BLACK;
+        rightRotate(parent, root);
+        x = root;
+      }
+    }
   }
+  if (x) x->color = Color::BLACK;
+}
 
-  if (!y->parent) {
-    root = x;
-  } else if (y == y->parent->left) {
-    y->parent->left = x;
-  } else {
-    y->parent->right = x;
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::erase(const T& key) {
+  Node* z = findNode(key);
+  if (z) eraseNode(z);
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::erase(iterator pos) {
+  iterator next = pos;
+  ++next;
+  eraseNode(pos.current);
+  return next;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::erase(iterator first, iterator last) {
+  while (first != last) first = erase(first);
+  return last;
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::contains_batch(const T* keys, size_t n,
+                                                       bool* out) const {
+  lowerNodesBatch(keys, n, [this, keys, out](size_t i, Node* node) {
+    out[i] = node && !comp(keys[i], node->data);
+  });
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename OutputIt>
+OutputIt RedBlackTree<T, Compare, Augment>::find_batch(const T* keys,
+                                                       size_t n,
+                                                       OutputIt out) const {
+  lowerNodesBatch(keys, n, [this, keys, &out](size_t i, Node* node) {
+    *out++ = iterator(node && !comp(keys[i], node->data) ? node : nullptr);
+  });
+  return out;
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+void RedBlackTree<T, Compare, Augment>::contains_batch(const Key* keys,
+                                                       size_t n,
+                                                       bool* out) const {
+  lowerNodesBatch(keys, n, [this, keys, out](size_t i, Node* node) {
+    out[i] = node && !comp(keys[i], node->data);
+  });
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename OutputIt, typename C, typename>
+OutputIt RedBlackTree<T, Compare, Augment>::find_batch(const Key* keys,
+                                                       size_t n,
+                                                       OutputIt out) const {
+  lowerNodesBatch(keys, n, [this, keys, &out](size_t i, Node* node) {
+    *out++ = iterator(node && !comp(keys[i], node->data) ? node : nullptr);
+  });
+  return out;
+}
+
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::contains(const T& value) const {
+  return findNode(value) != nullptr;
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+bool RedBlackTree<T, Compare, Augment>::contains(const Key& key) const {
+  return findNode(key) != nullptr;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::lookup(const T& key) const {
+  return iterator(findNode(key));
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::lookup(const Key& key) const {
+  return iterator(findNode(key));
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::lookup(iterator hint, const T& key) const {
+  return iterator(findNodeNear(hint.current, key));
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::lookup(iterator hint,
+                                          const Key& key) const {
+  return iterator(findNodeNear(hint.current, key));
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key>
+size_t RedBlackTree<T, Compare, Augment>::countLess(const Key& key) const {
+  static_assert(Augment::enabled &&
+                    std::is_base_of<OrderStatistics::Metadata, Node>::value,
+                "rank/count_range require RedBlackTree<..., OrderStatistics>");
+  size_t result = 0;
+  for (const Node* node = root; node;) {
+    if (comp(node->data, key)) {
+      result += OrderStatistics::sizeOf(node->left) + 1;
+      node = node->right;
+    } else {
+      node = node->left;
+    }
   }
+  return result;
+}
 
-  if (y != z) {
-    z->data = y->data;
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::select(size_t k) const {
+  static_assert(Augment::enabled &&
+                    std::is_base_of<OrderStatistics::Metadata, Node>::value,
+                "select requires RedBlackTree<..., OrderStatistics>");
+  if (k >= count) throw std::out_of_range("select: index out of range");
+  Node* node = root;
+  while (true) {
+    size_t leftSize = OrderStatistics::sizeOf(node->left);
+    if (k < leftSize) {
+      node = node->left;
+    } else if (k == leftSize) {
+      return iterator(node);
+    } else {
+      k -= leftSize + 1;
+      node = node->right;
+    }
   }
 }
 
-template <typename T>
-bool RedBlackTree<T>::contains(const T& value) const {
-  return find(root, value) != nullptr;
+template <typename T, typename Compare, typename Augment>
+size_t RedBlackTree<T, Compare, Augment>::rank(const T& value) const {
+  return countLess(value);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+size_t RedBlackTree<T, Compare, Augment>::rank(const Key& key) const {
+  return countLess(key);
+}
+
+template <typename T, typename Compare, typename Augment>
+size_t RedBlackTree<T, Compare, Augment>::count_range(const T& lo,
+                                                      const T& hi) const {
+  if (!comp(lo, hi)) return 0;
+  return countLess(hi) - countLess(lo);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+size_t RedBlackTree<T, Compare, Augment>::count_range(const Key& lo,
+                                                      const Key& hi) const {
+  if (!comp(lo, hi)) return 0;
+  return countLess(hi) - countLess(lo);
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::lower_bound(const T& key) const {
+  return iterator(lowerNode(key));
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::upper_bound(const T& key) const {
+  return iterator(upperNode(key));
+}
+
+template <typename T, typename Compare, typename Augment>
+std::pair<typename RedBlackTree<T, Compare, Augment>::iterator,
+          typename RedBlackTree<T, Compare, Augment>::iterator>
+RedBlackTree<T, Compare, Augment>::equal_range(const T& key) const {
+  return {iterator(lowerNode(key)), iterator(upperNode(key))};
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::lower_bound(const Key& key) const {
+  return iterator(lowerNode(key));
 }
 
-template <typename T>
-T RedBlackTree<T>::find(const T& value) {
-  auto node = find(root, value);
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::upper_bound(const Key& key) const {
+  return iterator(upperNode(key));
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename C, typename>
+std::pair<typename RedBlackTree<T, Compare, Augment>::iterator,
+          typename RedBlackTree<T, Compare, Augment>::iterator>
+RedBlackTree<T, Compare, Augment>::equal_range(const Key& key) const {
+  return {iterator(lowerNode(key)), iterator(upperNode(key))};
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Fn>
+void RedBlackTree<T, Compare, Augment>::for_each_in_range(const T& lo,
+                                                          const T& hi,
+                                                          Fn fn) const {
+  visitRange(root, lo, hi, fn);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename Fn, typename C, typename>
+void RedBlackTree<T, Compare, Augment>::for_each_in_range(const Key& lo,
+                                                          const Key& hi,
+                                                          Fn fn) const {
+  visitRange(root, lo, hi, fn);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename Fn>
+void RedBlackTree<T, Compare, Augment>::for_each_overlap(const Key& lo,
+                                                         const Key& hi,
+                                                         Fn fn) const {
+  static_assert(is_max_endpoint<Augment>::value,
+                "for_each_overlap requires RedBlackTree<..., MaxEndpoint>");
+  visitOverlaps(root, lo, hi, fn);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Key, typename Fn>
+void RedBlackTree<T, Compare, Augment>::visitOverlaps(Node* node,
+                                                      const Key& lo,
+                                                      const Key& hi, Fn& fn) {
+  typename Augment::endpoint_compare less;
+  // Поддерево, где все интервалы кончаются до lo, пропускается целиком;
+  // узел, начинающийся после hi, обрывает обход: правее начала не меньше
+  while (node && !less(node->max_high, lo)) {
+    visitOverlaps(node->left, lo, hi, fn);
+    if (less(hi, node->data.first.low)) return;
+    if (!less(node->data.first.high, lo)) fn(node->data);
+    node = node->right;
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+T RedBlackTree<T, Compare, Augment>::find(const T& value) {
+  auto node = findNode(value);
   if (node)
     return node->data;
   else
     throw std::runtime_error("Element not found");
 }
 
-template <typename T>
-void RedBlackTree<T>::clear() {
-  root = nullptr;
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::destroyNodes() {
+  // Обход без стека: поворачиваем левых потомков вправо и разрушаем узлы
+  Node* node = root;
+  while (node) {
+    if (node->left) {
+      Node* left = node->left;
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    } else {
+      Node* next = node->right;
+      node->~Node();
+      node = next;
+    }
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::clear() {
+  if (!std::is_trivially_destructible<T>::value) destroyNodes();
+  forgetNodes();
+  pool.release();
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::forgetNodes() {
+  root = leftmost = rightmost = nullptr;
+  count = 0;
 }
 
-template <typename T>
-bool RedBlackTree<T>::empty() const {
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::empty() const {
   return !root;
 }
 
-template <typename T>
-size_t RedBlackTree<T>::size() const {
-  return getSize(root);
+template <typename T, typename Compare, typename Augment>
+size_t RedBlackTree<T, Compare, Augment>::size() const {
+  return count;
 }
 
-template <typename T>
-size_t RedBlackTree<T>::max_size() const {
+template <typename T, typename Compare, typename Augment>
+size_t RedBlackTree<T, Compare, Augment>::max_size() const {
   return std::numeric_limits<size_t>::max();
 }
 
-template <typename T>
-void RedBlackTree<T>::swap(RedBlackTree& other) {
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::swap(RedBlackTree& other) {
   std::swap(root, other.root);
+  std::swap(leftmost, other.leftmost);
+  std::swap(rightmost, other.rightmost);
+  std::swap(count, other.count);
+  std::swap(comp, other.comp);
+  pool.swap(other.pool);
 }
 
-template <typename T>
-bool RedBlackTree<T>::operator==(const RedBlackTree& other) const {
-  return root == other.root;
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::operator==(
+    const RedBlackTree& other) const {
+  if (count != other.count) return false;
+  auto it = cbegin(), other_it = other.cbegin();
+  for (; it != cend() && other_it != other.cend(); ++it, ++other_it) {
+    if (!(*it == *other_it)) return false;
+  }
+  return it == cend() && other_it == other.cend();
 }
 
-template <typename T>
-T RedBlackTree<T>::GetMin() const {
+template <typename T, typename Compare, typename Augment>
+T RedBlackTree<T, Compare, Augment>::GetMin() const {
   auto current = root;
   while (current && current->left) current = current->left;
   if (!current) throw std::runtime_error("Tree is empty");
   return current->data;
 }
 
-template <typename T>
-T RedBlackTree<T>::GetMax() const {
+template <typename T, typename Compare, typename Augment>
+T RedBlackTree<T, Compare, Augment>::GetMax() const {
   auto current = root;
   while (current && current->right) current = current->right;
   if (!current) throw std::runtime_error("Tree is empty");
   return current->data;
 }
 
-template <typename T>
-std::shared_ptr<typename RedBlackTree<T>::Node> RedBlackTree<T>::getMinNode(
-    std::shared_ptr<Node> node) const {
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::getMinNode(Node* node) const {
   while (node && node->left) node = node->left;
   return node;
 }
 
-template <typename T>
-std::shared_ptr<typename RedBlackTree<T>::Node> RedBlackTree<T>::getMaxNode(
-    std::shared_ptr<Node> node) const {
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Node*
+RedBlackTree<T, Compare, Augment>::getMaxNode(Node* node) const {
   while (node && node->right) node = node->right;
   return node;
 }
 
-template <typename T>
-RedBlackTree<T>::iterator::iterator(std::shared_ptr<Node> node)
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Subtree
+RedBlackTree<T, Compare, Augment>::whole() const {
+  int blackHeight = 0;
+  for (const Node* node = root; node; node = node->left) {
+    if (node->color == Color::BLACK) ++blackHeight;
+  }
+  return {root, blackHeight};
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::setRoot(Subtree tree) {
+  root = tree.root;
+  if (root) {
+    root->parent = nullptr;
+    root->color = Color::BLACK;
+  }
+  leftmost = getMinNode(root);
+  rightmost = getMaxNode(root);
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Subtree
+RedBlackTree<T, Compare, Augment>::join3(Subtree left, Node* middle,
+                                         Subtree right) {
+  // Все элементы left не больше middle, а middle - не больше элементов
+  // right. Красные корни перекрашиваем, чтобы выше корня не было красного
+  for (Subtree* tree : {&left, &right}) {
+    if (isRed(tree->root)) {
+      tree->root->color = Color::BLACK;
+      ++tree->blackHeight;
+    }
+  }
+  middle->parent = nullptr;
+  if (left.blackHeight == right.blackHeight) {
+    middle->left = left.root;
+    middle->right = right.root;
+    if (left.root) left.root->parent = middle;
+    if (right.root) right.root->parent = middle;
+    middle->color = Color::BLACK;
+    Augment::update(middle);
+    return {middle, left.blackHeight + 1};
+  }
+  // Спускаемся по краю более высокого дерева до чёрного узла той же
+  // чёрной высоты, что и у низкого, и подвешиваем на его место красный
+  // middle; остаётся починить возможную пару красных, как при вставке
+  bool leftIsTaller = left.blackHeight > right.blackHeight;
+  Subtree& tall = leftIsTaller ? left : right;
+  Subtree& low = leftIsTaller ? right : left;
+  Node* top = tall.root;
+  Node* parent = nullptr;
+  Node* node = top;
+  int height = tall.blackHeight;
+  while (height > low.blackHeight || isRed(node)) {
+    if (!isRed(node)) --height;
+    parent = node;
+    node = leftIsTaller ? node->right : node->left;
+  }
+  middle->parent = parent;
+  middle->color = Color::RED;
+  if (leftIsTaller) {
+    middle->left = node;
+    middle->right = low.root;
+    parent->right = middle;
+  } else {
+    middle->left = low.root;
+    middle->right = node;
+    parent->left = middle;
+  }
+  if (node) node->parent = middle;
+  if (low.root) low.root->parent = middle;
+  Augment::update(middle);
+  updatePath(parent);
+  bool grew = fixInsert(middle, top);
+  return {top, tall.blackHeight + (grew ? 1 : 0)};
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Subtree
+RedBlackTree<T, Compare, Augment>::join2(Subtree left, Subtree right) {
+  if (!left.root) return right;
+  if (!right.root) return left;
+  Node* last;
+  Subtree rest = splitLast(left, last);
+  return join3(rest, last, right);
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Subtree
+RedBlackTree<T, Compare, Augment>::joinChain(Subtree left, Chain& middle,
+                                             Subtree right) {
+  if (!middle.head) return join2(left, right);
+  for (Node* node = middle.head; node != middle.tail;) {
+    Node* next = node->right;
+    left = join3(left, node, {nullptr, 0});
+    node = next;
+  }
+  Subtree result = join3(left, middle.tail, right);
+  middle = Chain();
+  return result;
+}
+
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::Subtree
+RedBlackTree<T, Compare, Augment>::splitLast(Subtree tree, Node*& last) {
+  Node* node = tree.root;
+  int childHeight = tree.blackHeight - (isRed(node) ? 0 : 1);
+  Subtree left{node->left, childHeight}, right{node->right, childHeight};
+  if (left.root) left.root->parent = nullptr;
+  if (!right.root) {
+    last = node;
+    return left;
+  }
+  right.root->parent = nullptr;
+  return join3(left, node, splitLast(right, last));
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::flatten(Node* node, Chain& out) {
+  // Тот же обход без стека, что и в destroyNodes
+  while (node) {
+    if (node->left) {
+      Node* left = node->left;
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    } else {
+      Node* next = node->right;
+      out.push(node);
+      node = next;
+    }
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::split3(Subtree tree, const T& key,
+                                               Subtree& less, Chain& equal,
+                                               Subtree& greater) const {
+  if (!tree.root) {
+    less = greater = {nullptr, 0};
+    return;
+  }
+  Node* node = tree.root;
+  int childHeight = tree.blackHeight - (isRed(node) ? 0 : 1);
+  Subtree left{node->left, childHeight}, right{node->right, childHeight};
+  if (left.root) left.root->parent = nullptr;
+  if (right.root) right.root->parent = nullptr;
+  if (comp(key, node->data)) {
+    Subtree rest;
+    split3(left, key, less, equal, rest);
+    greater = join3(rest, node, right);
+  } else if (comp(node->data, key)) {
+    Subtree rest;
+    split3(right, key, rest, equal, greater);
+    less = join3(left, node, rest);
+  } else {
+    // Равные key элементы мультимножества могут быть по обе стороны узла
+    Subtree empty;
+    Chain after;
+    split3(left, key, less, equal, empty);
+    split3(right, key, empty, after, greater);
+    equal.push(node);
+    equal.append(after);
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Executor>
+typename RedBlackTree<T, Compare, Augment>::Subtree
+RedBlackTree<T, Compare, Augment>::combine(SetOperation op, Subtree a,
+                                           Subtree b, Chain& dropped,
+                                           Executor& executor) const {
+  if (!a.root || !b.root) {
+    if (op == SetOperation::UNION) return a.root ? a : b;
+    flatten(b.root, dropped);
+    if (op == SetOperation::DIFFERENCE) return a;
+    flatten(a.root, dropped);
+    return {nullptr, 0};
+  }
+  // Корень b делит обе задачи на независимые половины
+  Node* key = b.root;
+  int childHeight = b.blackHeight - (isRed(key) ? 0 : 1);
+  Subtree bLeft{key->left, childHeight}, bRight{key->right, childHeight};
+  if (bLeft.root) bLeft.root->parent = nullptr;
+  if (bRight.root) bRight.root->parent = nullptr;
+
+  Subtree aLess, aGreater, bLess, bGreater, empty;
+  Chain aEqual, bEqual, bEqualRight;
+  split3(a, key->data, aLess, aEqual, aGreater);
+  split3(bLeft, key->data, bLess, bEqual, empty);
+  split3(bRight, key->data, empty, bEqualRight, bGreater);
+  bEqual.push(key);
+  bEqual.append(bEqualRight);
+
+  Subtree left, right;
+  Chain droppedLeft, droppedRight;
+  auto solveLeft = [&] {
+    left = combine(op, aLess, bLess, droppedLeft, executor);
+  };
+  auto solveRight = [&] {
+    right = combine(op, aGreater, bGreater, droppedRight, executor);
+  };
+  if (std::min(a.blackHeight, b.blackHeight) >= kParallelBlackHeight) {
+    executor.invoke(solveLeft, solveRight);
+  } else {
+    solveLeft();
+    solveRight();
+  }
+
+  size_t common = std::min(aEqual.size, bEqual.size);
+  Chain keep;
+  if (op == SetOperation::UNION) {
+    Chain duplicates = bEqual.cut(common);
+    dropped.append(duplicates);
+    keep.append(aEqual);
+    keep.append(bEqual);
+  } else if (op == SetOperation::INTERSECTION) {
+    keep = aEqual.cut(common);
+    dropped.append(aEqual);
+    dropped.append(bEqual);
+  } else {
+    Chain removed = aEqual.cut(common);
+    dropped.append(removed);
+    dropped.append(bEqual);
+    keep.append(aEqual);
+  }
+  dropped.append(droppedLeft);
+  dropped.append(droppedRight);
+  return joinChain(left, keep, right);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Executor>
+void RedBlackTree<T, Compare, Augment>::applySetOperation(
+    SetOperation op, RedBlackTree& other, Executor& executor) {
+  pool.shareBlocks(other.pool);
+  Subtree a = whole(), b = other.whole();
+  size_t total = count + other.count;
+  other.forgetNodes();
+  Chain dropped;
+  setRoot(combine(op, a, b, dropped, executor));
+  count = total - dropped.size;
+  for (Node* node = dropped.head; node;) {
+    Node* next = node->right;
+    pool.destroy(node);
+    node = next;
+  }
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::set_union(RedBlackTree other) {
+  SequentialExecutor executor;
+  applySetOperation(SetOperation::UNION, other, executor);
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::set_intersection(RedBlackTree other) {
+  SequentialExecutor executor;
+  applySetOperation(SetOperation::INTERSECTION, other, executor);
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::set_difference(RedBlackTree other) {
+  SequentialExecutor executor;
+  applySetOperation(SetOperation::DIFFERENCE, other, executor);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Executor>
+void RedBlackTree<T, Compare, Augment>::set_union(RedBlackTree other,
+                                                  Executor& executor) {
+  applySetOperation(SetOperation::UNION, other, executor);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Executor>
+void RedBlackTree<T, Compare, Augment>::set_intersection(RedBlackTree other,
+                                                         Executor& executor) {
+  applySetOperation(SetOperation::INTERSECTION, other, executor);
+}
+
+template <typename T, typename Compare, typename Augment>
+template <typename Executor>
+void RedBlackTree<T, Compare, Augment>::set_difference(RedBlackTree other,
+                                                       Executor& executor) {
+  applySetOperation(SetOperation::DIFFERENCE, other, executor);
+}
+
+template <typename T, typename Compare, typename Augment>
+void RedBlackTree<T, Compare, Augment>::join(RedBlackTree other) {
+  if (root && other.root && comp(other.leftmost->data, rightmost->data)) {
+    throw std::invalid_argument("join: trees overlap");
+  }
+  pool.shareBlocks(other.pool);
+  Subtree a = whole(), b = other.whole();
+  count += other.count;
+  other.forgetNodes();
+  setRoot(join2(a, b));
+}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment> RedBlackTree<T, Compare, Augment>::split(
+    const T& key) {
+  RedBlackTree upper(comp);
+  upper.pool.shareBlocks(pool);
+  Subtree less, greater;
+  Chain equal;
+  split3(whole(), key, less, equal, greater);
+  setRoot(less);
+  upper.setRoot(joinChain({nullptr, 0}, equal, greater));
+
+  size_t lessCount;
+  if constexpr (std::is_base_of<OrderStatistics::Metadata, Node>::value) {
+    lessCount = OrderStatistics::sizeOf(root);
+  } else {
+    // Идём по обеим частям одновременно, пока не кончится меньшая
+    const_iterator lower = cbegin(), higher = upper.cbegin();
+    size_t steps = 0;
+    while (lower != cend() && higher != upper.cend()) {
+      ++lower;
+      ++higher;
+      ++steps;
+    }
+    lessCount = lower == cend() ? steps : count - steps;
+  }
+  upper.count = count - lessCount;
+  count = lessCount;
+  return upper;
+}
+
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::iterator::iterator(Node* node)
     : current(node) {}
 
-template <typename T>
-T& RedBlackTree<T>::iterator::operator*() const {
+template <typename T, typename Compare, typename Augment>
+T& RedBlackTree<T, Compare, Augment>::iterator::operator*() const {
   return current->data;
 }
 
-template <typename T>
-typename RedBlackTree<T>::iterator& RedBlackTree<T>::iterator::operator++() {
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator&
+RedBlackTree<T, Compare, Augment>::iterator::operator++() {
   if (!current) return *this;
   if (current->right) {
     current = current->right;
@@ -283,41 +1588,43 @@ typename RedBlackTree<T>::iterator& RedBlackTree<T>::iterator::operator++() {
   return *this;
 }
 
-template <typename T>
-bool RedBlackTree<T>::iterator::operator==(const iterator& other) const {
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::iterator::operator==(
+    const iterator& other) const {
   return current == other.current;
 }
 
-template <typename T>
-bool RedBlackTree<T>::iterator::operator!=(const iterator& other) const {
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::iterator::operator!=(
+    const iterator& other) const {
   return !(*this == other);
 }
 
-template <typename T>
-typename RedBlackTree<T>::iterator RedBlackTree<T>::begin() const {
-  auto node = root;
-  while (node && node->left) node = node->left;
-  return iterator(node);
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::begin() const {
+  return iterator(leftmost);
 }
 
-template <typename T>
-typename RedBlackTree<T>::iterator RedBlackTree<T>::end() const {
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::iterator
+RedBlackTree<T, Compare, Augment>::end() const {
   return iterator(nullptr);
 }
 
-template <typename T>
-RedBlackTree<T>::const_iterator::const_iterator(
-    std::shared_ptr<const Node> node)
+template <typename T, typename Compare, typename Augment>
+RedBlackTree<T, Compare, Augment>::const_iterator::const_iterator(
+    const Node* node)
     : current(node) {}
 
-template <typename T>
-const T& RedBlackTree<T>::const_iterator::operator*() const {
+template <typename T, typename Compare, typename Augment>
+const T& RedBlackTree<T, Compare, Augment>::const_iterator::operator*() const {
   return current->data;
 }
 
-template <typename T>
-typename RedBlackTree<T>::const_iterator&
-RedBlackTree<T>::const_iterator::operator++() {
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::const_iterator&
+RedBlackTree<T, Compare, Augment>::const_iterator::operator++() {
   if (!current) return *this;
   if (current->right) {
     current = current->right;
@@ -333,30 +1640,28 @@ RedBlackTree<T>::const_iterator::operator++() {
   return *this;
 }
 
-template <typename T>
-bool RedBlackTree<T>::const_iterator::operator==(
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::const_iterator::operator==(
     const const_iterator& other) const {
   return current == other.current;
 }
 
-template <typename T>
-bool RedBlackTree<T>::const_iterator::operator!=(
+template <typename T, typename Compare, typename Augment>
+bool RedBlackTree<T, Compare, Augment>::const_iterator::operator!=(
     const const_iterator& other) const {
   return !(*this == other);
 }
 
-template <typename T>
-typename RedBlackTree<T>::const_iterator RedBlackTree<T>::cbegin() const {
-  auto node = root;
-  while (node && node->left) node = node->left;
-  return const_iterator(node);
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::const_iterator
+RedBlackTree<T, Compare, Augment>::cbegin() const {
+  return const_iterator(leftmost);
 }
 
-template <typename T>
-typename RedBlackTree<T>::const_iterator RedBlackTree<T>::cend() const {
+template <typename T, typename Compare, typename Augment>
+typename RedBlackTree<T, Compare, Augment>::const_iterator
+RedBlackTree<T, Compare, Augment>::cend() const {
   return const_iterator(nullptr);
 }
 
-template class RedBlackTree<int>;
-
 #endif
\ No newline at end of file
@@ -2,20 +2,40 @@
 #define RED_BLACK_TREE_H
 
 #include <algorithm>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
+#include "Augmentation.h"
+#include "NodePool.h"
+#include "Prefetch.h"
+
+// Исполнитель по умолчанию для операций над множествами: «параллельные»
+// ветви выполняются по очереди. Подойдёт любой тип с invoke(f1, f2),
+// например s21::task_scheduler.
+struct SequentialExecutor {
+  template <typename F1, typename F2>
+  void invoke(F1&& f1, F2&& f2) {
+    f1();
+    f2();
+  }
+};
+
+template <typename T, typename Compare = std::less<T>,
+          typename Augment = NoAugmentation>
 class RedBlackTree {
  private:
   enum class Color { RED, BLACK };
 
-  struct Node {
+  struct Node : Augment::Metadata {
     T data;
     Color color;
-    std::shared_ptr<Node> left, right, parent;
+    Node *left, *right, *parent;
 
     explicit Node(const T& data)
         : data(data),
@@ -23,46 +43,392 @@ class RedBlackTree {
           left(nullptr),
           right(nullptr),
           parent(nullptr) {}
+    explicit Node(T&& data)
+        : data(std::move(data)),
+          color(Color::RED),
+          left(nullptr),
+          right(nullptr),
+          parent(nullptr) {}
+  };
+
+  // Узлы живут в арене дерева, связи между ними - обычные указатели:
+  // спуск по дереву не трогает счётчики ссылок
+  Node* root;
+  // Крайние узлы: begin() и вставка в конец по подсказке без спуска
+  Node* leftmost;
+  Node* rightmost;
+  NodePool<Node> pool;
+  size_t count;  // число элементов, чтобы size() не обходил дерево
+  Compare comp;
+
+  static bool isRed(const Node* node) {
+    return node && node->color == Color::RED;
+  }
+
+  // Повороты и восстановление после вставки работают на поддереве с
+  // корнем top, а не только на всём дереве: их использует join.
+  // fixInsert возвращает true, если чёрная высота поддерева выросла
+  static void leftRotate(Node* x, Node*& top);
+  static void rightRotate(Node* y, Node*& top);
+  static bool fixInsert(Node* z, Node*& top);
+  // Пересчитывает дополнение от node до корня
+  static void updatePath(Node* node);
+  void transplant(Node* u, Node* v);
+  void fixErase(Node* x, Node* parent);
+  void eraseNode(Node* z);
+  // Вынимает узел из дерева, не разрушая его
+  void unlinkNode(Node* z);
+  int isRedBlackTreeHelper(const Node* node) const;
+  template <typename Key>
+  Node* findNode(const Key& key) const;
+  // Тот же поиск, что findNode, но от ближайшего к hint подходящего предка
+  template <typename Key>
+  Node* findNodeNear(Node* hint, const Key& key) const;
+  template <typename Key>
+  Node* lowerNode(const Key& key) const;
+  template <typename Key>
+  Node* lowerNodeIn(Node* node, const Key& key) const;
+  template <typename Key>
+  Node* upperNode(const Key& key) const;
+  // lowerNode для каждого из n ключей, fn(i, node) - по порядку ключей
+  template <typename Key, typename Fn>
+  void lowerNodesBatch(const Key* keys, size_t n, Fn fn) const;
+  // Обход [lo, hi): сравнения только на узлах вдоль двух границ,
+  // поддеревья целиком внутри диапазона обходятся без сравнений
+  template <typename Key, typename Fn>
+  void visitRange(Node* node, const Key& lo, const Key& hi, Fn& fn) const;
+  template <typename Key, typename Fn>
+  void visitFrom(Node* node, const Key& lo, Fn& fn) const;
+  template <typename Key, typename Fn>
+  void visitUntil(Node* node, const Key& hi, Fn& fn) const;
+  template <typename Fn>
+  static void visitAll(Node* node, Fn& fn);
+  template <typename Key, typename Fn>
+  static void visitOverlaps(Node* node, const Key& lo, const Key& hi,
+                            Fn& fn);
+  static Node* predecessor(Node* node);
+  static Node* successor(Node* node);
+  // Подвешивает новый узел к parent и восстанавливает свойства дерева
+  Node* attach(Node* parent, bool asLeft, const T& value);
+  Node* link(Node* parent, bool asLeft, Node* node);
+  // Место нового листа value - после всех равных ему элементов
+  Node* leafParent(const T& value, bool& goLeft) const;
+  // Равный value элемент перед этим местом, если он есть
+  Node* equalBefore(Node* parent, bool goLeft, const T& value) const;
+  Node* insertNode(const T& value);
+  // Отцепляет узлы, не разрушая их: они перешли к другому дереву
+  void forgetNodes();
+  template <typename Key>
+  size_t countLess(const Key& key) const;
+  void destroyNodes();
+  // Сборка пустого дерева из упорядоченной последовательности за O(n):
+  // узлы сначала выстраиваются цепочкой по правым ссылкам (так дерево
+  // остаётся корректным, если копирование элемента бросит исключение), а
+  // затем цепочка без выделений перевязывается в сбалансированное дерево
+  template <typename InputIt>
+  void buildSorted(InputIt first, InputIt last);
+  // Копия поддерева source с теми же цветами и дополнением за O(n), без
+  // сравнений и поворотов. Каждая копия сразу подвешивается в *slot, так
+  // что при исключении из конструктора T готовые узлы достижимы из корня
+  void cloneSubtree(const Node* source, Node* parent, Node** slot);
+  Node* linkBalanced(Node*& chain, size_t n, size_t depth, size_t redDepth);
+  // Делает пустое дерево из n упорядоченных узлов, связанных через right
+  void linkChain(Node* head, Node* tail, size_t n);
+
+  // Поддерево и его чёрная высота (число чёрных узлов на пути от корня до
+  // пустого листа). Высота передаётся вместе с корнем, поэтому join стоит
+  // O(разности высот) и не спускается до листьев
+  struct Subtree {
+    Node* root;
+    int blackHeight;
   };
+  // Отцепленные узлы по возрастанию, связанные через right
+  struct Chain {
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    size_t size = 0;
 
-  std::shared_ptr<Node> root;
+    void push(Node* node) {
+      node->right = nullptr;
+      if (tail)
+        tail->right = node;
+      else
+        head = node;
+      tail = node;
+      ++size;
+    }
+    void append(Chain& other) {
+      if (!other.head) return;
+      if (tail)
+        tail->right = other.head;
+      else
+        head = other.head;
+      tail = other.tail;
+      size += other.size;
+      other = Chain();
+    }
+    // Отрезает первые n узлов
+    Chain cut(size_t n) {
+      Chain front;
+      while (front.size < n) {
+        Node* node = head;
+        head = head->right;
+        --size;
+        front.push(node);
+      }
+      if (!head) tail = nullptr;
+      return front;
+    }
+  };
+  enum class SetOperation { UNION, INTERSECTION, DIFFERENCE };
+  // Ветви, где оба поддерева не ниже этой чёрной высоты (в каждом не меньше
+  // 2^8 - 1 узлов), отдаются исполнителю параллельно
+  static constexpr int kParallelBlackHeight = 8;
 
-  void leftRotate(std::shared_ptr<Node> x);
-  void rightRotate(std::shared_ptr<Node> y);
-  void fixInsert(std::shared_ptr<Node> z);
-  int isRedBlackTreeHelper(std::shared_ptr<Node> node) const;
-  std::shared_ptr<Node> find(std::shared_ptr<Node> node, const T& value) const;
-  size_t getSize(const std::shared_ptr<Node>& node) const;
+  Subtree whole() const;
+  void setRoot(Subtree tree);
+  static Subtree join3(Subtree left, Node* middle, Subtree right);
+  static Subtree join2(Subtree left, Subtree right);
+  static Subtree joinChain(Subtree left, Chain& middle, Subtree right);
+  static Subtree splitLast(Subtree tree, Node*& last);
+  static void flatten(Node* node, Chain& out);
+  void split3(Subtree tree, const T& key, Subtree& less, Chain& equal,
+              Subtree& greater) const;
+  template <typename Executor>
+  Subtree combine(SetOperation op, Subtree a, Subtree b, Chain& dropped,
+                  Executor& executor) const;
+  template <typename Executor>
+  void applySetOperation(SetOperation op, RedBlackTree& other,
+                         Executor& executor);
 
  public:
   bool isRedBlackTree() const;
 
+  class iterator;
+  class const_iterator;
+
+  // Узел, вынутый из дерева (как node_type в std::set): владеет элементом
+  // и собственным блоком на один узел, поэтому переживает исходное дерево
+  // и не держит его арену. extract перемещает элемент в этот блок, а
+  // вставка handle в дерево того же типа перевешивает узел без копирования
+  // data и без выделения памяти
+  class node_type {
+   private:
+    Node* node;
+    typename NodePool<Node>::Block block;
+
+    friend class RedBlackTree;
+
+    node_type(Node* node, typename NodePool<Node>::Block block)
+        : node(node), block(std::move(block)) {}
+
+   public:
+    node_type() : node(nullptr) {}
+    node_type(node_type&& other) noexcept
+        : node(other.node), block(std::move(other.block)) {
+      other.node = nullptr;
+    }
+    node_type& operator=(node_type&& other) noexcept {
+      if (this != &other) {
+        reset();
+        std::swap(node, other.node);
+        std::swap(block, other.block);
+      }
+      return *this;
+    }
+    node_type(const node_type&) = delete;
+    node_type& operator=(const node_type&) = delete;
+    // Разрушает элемент и освобождает блок узла
+    ~node_type() { reset(); }
+
+    bool empty() const { return !node; }
+    explicit operator bool() const { return node != nullptr; }
+    T& value() const { return node->data; }
+
+   private:
+    void reset() {
+      if (node) node->~Node();
+      node = nullptr;
+      block.reset();
+    }
+  };
+
+ private:
+  // Забирает узел из handle в арену дерева и готовит его к вставке
+  Node* adopt(node_type& handle);
+
+ public:
+
   RedBlackTree();
+  explicit RedBlackTree(const Compare& compare);
   RedBlackTree(std::initializer_list<T> init_list);
+  // Если диапазон уже упорядочен, дерево строится за O(n) без поворотов
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  RedBlackTree(InputIt first, InputIt last);
+  RedBlackTree(const RedBlackTree& other);
+  RedBlackTree(RedBlackTree&& other) noexcept;
+  ~RedBlackTree();
+
+  RedBlackTree& operator=(const RedBlackTree& other);
+  RedBlackTree& operator=(RedBlackTree&& other) noexcept;
+
+  // Строят дерево из последовательности, уже упорядоченной по Compare
+  // (равные элементы допустимы), за O(n). Порядок не проверяется.
+  template <typename ForwardIt>
+  static RedBlackTree from_sorted(ForwardIt first, ForwardIt last,
+                                  const Compare& compare = Compare());
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
 
   void insert(const T& value);
+  // Вставляет, только если равного элемента ещё нет
+  std::pair<iterator, bool> insertUnique(const T& value);
+  // Вставка с подсказкой: если value встаёт непосредственно перед hint
+  // (или после него), узел подвешивается рядом без спуска от корня - для
+  // почти упорядоченных данных это амортизированно O(1). Иначе - обычная
+  // вставка. Вставка в конец - с подсказкой end()
+  iterator insert(iterator hint, const T& value);
+  std::pair<iterator, bool> insertUnique(iterator hint, const T& value);
+
+  // Перенос узлов между деревьями одного типа без копирования элементов.
+  // extract вынимает узел (по ключу - пустой handle, если ключа нет);
+  // insertUnique(handle) при совпадении ключа оставляет узел в handle;
+  // merge переносит все узлы other, mergeUnique - только отсутствующие
+  node_type extract(iterator pos);
+  node_type extract(const T& key);
+  iterator insert(node_type&& handle);
+  std::pair<iterator, bool> insertUnique(node_type&& handle);
+  void merge(RedBlackTree& other);
+  void mergeUnique(RedBlackTree& other);
   void erase(const T& key);
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
   bool contains(const T& value) const;
   T find(const T& value);
+  // Итератор на элемент, равный key по Compare, или end()
+  iterator lookup(const T& key) const;
+
+  // Гетерогенный поиск: доступен, если Compare объявляет is_transparent
+  // (например, std::less<>), и позволяет искать без временного T
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lookup(const Key& key) const;
+  // Поиск от подсказки: стоимость зависит от расстояния между hint и
+  // ответом, а не от размера дерева
+  iterator lookup(iterator hint, const T& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lookup(iterator hint, const Key& key) const;
+
+  // Пакетный поиск n ключей: спуски kBatchLanes ключей идут вперемешку,
+  // и промахи кеша разных ключей перекрываются, а не ждутся по очереди.
+  // contains_batch пишет out[i] - есть ли keys[i]; find_batch выдаёт в
+  // out итератор на каждый ключ (end(), если ключа нет)
+  void contains_batch(const T* keys, size_t n, bool* out) const;
+  template <typename OutputIt>
+  OutputIt find_batch(const T* keys, size_t n, OutputIt out) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  void contains_batch(const Key* keys, size_t n, bool* out) const;
+  template <typename Key, typename OutputIt, typename C = Compare,
+            typename = typename C::is_transparent>
+  OutputIt find_batch(const Key* keys, size_t n, OutputIt out) const;
+
+  // Первый элемент не меньше key, первый элемент больше key и пара из них
+  iterator lower_bound(const T& key) const;
+  iterator upper_bound(const T& key) const;
+  std::pair<iterator, iterator> equal_range(const T& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const Key& key) const;
+
+  // Вызывает fn для каждого элемента из [lo, hi) по возрастанию, без
+  // итераторов и без подъёмов по parent
+  template <typename Fn>
+  void for_each_in_range(const T& lo, const T& hi, Fn fn) const;
+  template <typename Key, typename Fn, typename C = Compare,
+            typename = typename C::is_transparent>
+  void for_each_in_range(const Key& lo, const Key& hi, Fn fn) const;
+
+  // Пересечения интервалов, доступны при Augment = MaxEndpoint: элементы -
+  // пары с интервалом {low, high} в first, упорядоченные по low. fn
+  // вызывается по возрастанию для каждого элемента, чей интервал
+  // пересекается с [lo, hi]; поддеревья без таких элементов пропускаются
+  template <typename Key, typename Fn>
+  void for_each_overlap(const Key& lo, const Key& hi, Fn fn) const;
+
+  // Порядковые статистики, доступны при Augment = OrderStatistics.
+  // select(k) - итератор на k-й по порядку элемент (с нуля), при
+  // k >= size() бросает std::out_of_range; rank(value) - число элементов,
+  // строго меньших value; count_range(lo, hi) - число элементов в [lo, hi)
+  iterator select(size_t k) const;
+  size_t rank(const T& value) const;
+  size_t count_range(const T& lo, const T& hi) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_t rank(const Key& key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_t count_range(const Key& lo, const Key& hi) const;
+
+  // Операции над множествами на основе join (Blelloch, Ferizovic, Sun):
+  // O(m log(n/m + 1)) сравнений, где m - размер меньшего дерева. Узлы
+  // other переходят в это дерево без копирования и выделений. Равные
+  // элементы считаются как в std::set_union и соседях: для повторов
+  // берутся max, min и разность кратностей. С executor, у которого есть
+  // invoke(f1, f2), крупные независимые поддеревья обрабатываются
+  // параллельно. Compare не должен бросать исключений.
+  void set_union(RedBlackTree other);
+  void set_intersection(RedBlackTree other);
+  void set_difference(RedBlackTree other);
+  template <typename Executor>
+  void set_union(RedBlackTree other, Executor& executor);
+  template <typename Executor>
+  void set_intersection(RedBlackTree other, Executor& executor);
+  template <typename Executor>
+  void set_difference(RedBlackTree other, Executor& executor);
+  // Дописывает other справа за O(log n); элементы other не должны быть
+  // меньше элементов дерева, иначе std::invalid_argument
+  void join(RedBlackTree other);
+  // Оставляет в дереве элементы меньше key, остальные возвращает. Форма
+  // меняется за O(log n); размеры частей берутся из OrderStatistics, а без
+  // него - обходом меньшей части. Части делят блоки арены.
+  RedBlackTree split(const T& key);
+
   void clear();
   bool empty() const;
   size_t size() const;
   size_t max_size() const;
+  const Compare& value_comp() const { return comp; }
   void swap(RedBlackTree& other);
   bool operator==(const RedBlackTree& other) const;
   T GetMin() const;
   T GetMax() const;
-  std::shared_ptr<Node> getMinNode(std::shared_ptr<Node> node) const;
-  std::shared_ptr<Node> getMaxNode(std::shared_ptr<Node> node) const;
+  Node* getMinNode(Node* node) const;
+  Node* getMaxNode(Node* node) const;
 
  public:
   class iterator {
    private:
-    std::shared_ptr<Node> current;
+    Node* current;
+
+    friend class RedBlackTree;
+    friend class const_iterator;
 
    public:
-    iterator(std::shared_ptr<Node> node);
+    iterator(Node* node = nullptr);
     T& operator*() const;
+    T* operator->() const { return &current->data; }
     iterator& operator++();
     bool operator==(const iterator& other) const;
     bool operator!=(const iterator& other) const;
@@ -74,11 +440,13 @@ class RedBlackTree {
  public:
   class const_iterator {
    private:
-    std::shared_ptr<const Node> current;
+    const Node* current;
 
    public:
-    const_iterator(std::shared_ptr<const Node> node);
+    const_iterator(const Node* node = nullptr);
+    const_iterator(const iterator& it) : current(it.current) {}
     const T& operator*() const;
+    const T* operator->() const { return &current->data; }
     const_iterator& operator++();
     bool operator==(const const_iterator& other) const;
     bool operator!=(const const_iterator& other) const;
@@ -86,9 +454,15 @@ class RedBlackTree {
 
   const_iterator cbegin() const;
   const_iterator cend() const;
+};
 
- public:
-#include "RedBlackTree.h"
+// Выбор дерева для s21_set, s21_multiset и s21_map: красно-чёрное дерево
+// по умолчанию, BTreeBackend из BTree/btree.h - B-дерево
+struct RedBlackTreeBackend {
+  template <typename T, typename Compare, typename Augment>
+  using tree = RedBlackTree<T, Compare, Augment>;
 };
 
+#include "RedBlackTree.cc"
+
 #endif  // RED_BLACK_TREE_H
@@ -5,11 +5,11 @@
 
 namespace s21 {
 
-template <typename T>
-s21_set<T>::s21_set() {}
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_set<T, Compare, Augment, Backend>::s21_set() {}
 
-template <typename T>
-void s21_set<T>::insert(const T& value) {
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::insert(const T& value) {
   try {
     tree.insert(value);
   } catch (const std::exception& e) {
@@ -17,97 +17,285 @@ void s21_set<T>::insert(const T& value) {
   }
 }
 
-template <typename T>
-void s21_set<T>::erase(const T& value) {
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::erase(const T& value) {
   tree.erase(value);
 }
 
-template <typename T>
-bool s21_set<T>::contains(const T& value) const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_set<T, Compare, Augment, Backend>::contains(const T& value) const {
   return tree.contains(value);
 }
 
-template <typename T>
-void s21_set<T>::clear() {
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::contains_batch(const T* keys,
+                                                           size_t n,
+                                                           bool* out) const {
+  tree.contains_batch(keys, n, out);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename OutputIt>
+OutputIt s21_set<T, Compare, Augment, Backend>::find_batch(
+    const T* keys, size_t n, OutputIt out) const {
+  return tree.find_batch(keys, n, out);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+static_ordered_set<T, Compare> s21_set<T, Compare, Augment, Backend>::freeze()
+    const {
+  std::vector<T> items;
+  items.reserve(tree.size());
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it) items.push_back(*it);
+  return static_ordered_set<T, Compare>(std::make_move_iterator(items.begin()),
+                                        std::make_move_iterator(items.end()),
+                                        tree.value_comp());
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::save(std::ostream& out) const {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "snapshots need a trivially copyable T");
+  detail::save_tree_snapshot<T>(out, detail::snapshot_kind::set, tree);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::load(std::istream& in) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "snapshots need a trivially copyable T");
+  detail::load_tree_snapshot<T>(in, detail::snapshot_kind::set, tree);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::clear() {
   tree.clear();
 }
 
-template <typename T>
-bool s21_set<T>::empty() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_set<T, Compare, Augment, Backend>::empty() const {
   return tree.empty();
 }
 
-template <typename T>
-size_t s21_set<T>::size() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_set<T, Compare, Augment, Backend>::size() const {
   return tree.size();
 }
 
-template <typename T>
-size_t s21_set<T>::max_size() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_set<T, Compare, Augment, Backend>::max_size() const {
   return tree.max_size();
 }
 
-template <typename T>
-typename RedBlackTree<T>::iterator s21_set<T>::find(const T& value) {
-  return tree.find(value);
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::tree_type::iterator
+s21_set<T, Compare, Augment, Backend>::find(const T& value) {
+  return tree.lookup(value);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::iterator
+s21_set<T, Compare, Augment, Backend>::insert(iterator hint, const T& value) {
+  return iterator(tree.insertUnique(hint.iter, value).first);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::iterator
+s21_set<T, Compare, Augment, Backend>::find(iterator hint,
+                                            const T& value) const {
+  return iterator(tree.lookup(hint.iter, value));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::node_type
+s21_set<T, Compare, Augment, Backend>::extract(const T& value) {
+  return tree.extract(value);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::node_type
+s21_set<T, Compare, Augment, Backend>::extract(iterator pos) {
+  return tree.extract(pos.iter);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+std::pair<typename s21_set<T, Compare, Augment, Backend>::iterator, bool>
+s21_set<T, Compare, Augment, Backend>::insert(node_type&& node) {
+  auto result = tree.insertUnique(std::move(node));
+  return {iterator(result.first), result.second};
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::merge(s21_set& other) {
+  tree.mergeUnique(other.tree);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::iterator
+s21_set<T, Compare, Augment, Backend>::select(size_t k) const {
+  return iterator(tree.select(k));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_set<T, Compare, Augment, Backend>::rank(const T& value) const {
+  return tree.rank(value);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+size_t s21_set<T, Compare, Augment, Backend>::count_range(const T& lo,
+                                                          const T& hi) const {
+  return tree.count_range(lo, hi);
 }
 
-template <typename T>
-bool s21_set<T>::operator==(const s21_set& other) const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_set<T, Compare, Augment, Backend>::operator==(
+    const s21_set& other) const {
   return tree == other.tree;
 }
 
-template <typename T>
-bool s21_set<T>::operator!=(const s21_set& other) const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+bool s21_set<T, Compare, Augment, Backend>::operator!=(
+    const s21_set& other) const {
   return !(*this == other);
 }
 
-template <typename T>
-typename s21_set<T>::iterator s21_set<T>::begin() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::iterator
+s21_set<T, Compare, Augment, Backend>::begin() const {
   return iterator(tree.begin());
 }
 
-template <typename T>
-typename s21_set<T>::iterator s21_set<T>::end() const {
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::iterator
+s21_set<T, Compare, Augment, Backend>::end() const {
   return iterator(tree.end());
 }
 
-template <typename T>
-s21_set<T>::s21_set(const s21_set& other) : tree(other.tree) {}
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_set<T, Compare, Augment, Backend>::s21_set(const s21_set& other)
+    : tree(other.tree) {}
 
-template <typename T>
-s21_set<T>::s21_set(s21_set&& other) noexcept : tree(std::move(other.tree)) {}
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_set<T, Compare, Augment, Backend>::s21_set(s21_set&& other) noexcept
+    : tree(std::move(other.tree)) {}
 
-template <typename T>
-s21_set<T>& s21_set<T>::operator=(const s21_set& other) {
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_set<T, Compare, Augment, Backend>&
+s21_set<T, Compare, Augment, Backend>::operator=(const s21_set& other) {
   if (this != &other) {
     tree = other.tree;
   }
   return *this;
 }
 
-template <typename T>
-s21_set<T>& s21_set<T>::operator=(s21_set&& other) noexcept {
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_set<T, Compare, Augment, Backend>&
+s21_set<T, Compare, Augment, Backend>::operator=(s21_set&& other) noexcept {
   if (this != &other) {
     tree = std::move(other.tree);
   }
   return *this;
 }
 
-template <typename T>
-s21_set<T>::s21_set(std::initializer_list<T> init_list) : tree() {
-  for (const auto& elem : init_list) {
-    insert(elem);
-  }
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_set<T, Compare, Augment, Backend>::s21_set(
+    std::initializer_list<T> init_list)
+    : tree(init_list) {}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename InputIt, typename>
+s21_set<T, Compare, Augment, Backend>::s21_set(InputIt first, InputIt last)
+    : tree(first, last) {}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename ForwardIt>
+void s21_set<T, Compare, Augment, Backend>::assign_sorted(ForwardIt first,
+                                                          ForwardIt last) {
+  tree.assign_sorted(first, last);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::iterator
+s21_set<T, Compare, Augment, Backend>::lower_bound(const T& value) const {
+  return iterator(tree.lower_bound(value));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+typename s21_set<T, Compare, Augment, Backend>::iterator
+s21_set<T, Compare, Augment, Backend>::upper_bound(const T& value) const {
+  return iterator(tree.upper_bound(value));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+std::pair<typename s21_set<T, Compare, Augment, Backend>::iterator,
+          typename s21_set<T, Compare, Augment, Backend>::iterator>
+s21_set<T, Compare, Augment, Backend>::equal_range(const T& value) const {
+  auto range = tree.equal_range(value);
+  return {iterator(range.first), iterator(range.second)};
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Fn>
+void s21_set<T, Compare, Augment, Backend>::for_each_in_range(const T& lo,
+                                                              const T& hi,
+                                                              Fn fn) const {
+  tree.for_each_in_range(lo, hi, [&fn](const T& value) { fn(value); });
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::set_union(s21_set other) {
+  tree.set_union(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::set_intersection(s21_set other) {
+  tree.set_intersection(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::set_difference(s21_set other) {
+  tree.set_difference(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Executor>
+void s21_set<T, Compare, Augment, Backend>::set_union(s21_set other,
+                                                      Executor& executor) {
+  tree.set_union(std::move(other.tree), executor);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Executor>
+void s21_set<T, Compare, Augment, Backend>::set_intersection(
+    s21_set other, Executor& executor) {
+  tree.set_intersection(std::move(other.tree), executor);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+template <typename Executor>
+void s21_set<T, Compare, Augment, Backend>::set_difference(s21_set other,
+                                                           Executor& executor) {
+  tree.set_difference(std::move(other.tree), executor);
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+void s21_set<T, Compare, Augment, Backend>::join(s21_set other) {
+  tree.join(std::move(other.tree));
+}
+
+template <typename T, typename Compare, typename Augment, typename Backend>
+s21_set<T, Compare, Augment, Backend>
+s21_set<T, Compare, Augment, Backend>::split(const T& key) {
+  return s21_set(tree.split(key));
 }
 
 }  // namespace s21
 
-template <typename T>
+template <typename T, typename Compare, typename Augment, typename Backend>
 template <typename... Args>
-vector<std::pair<typename s21::s21_set<T>::iterator, bool>>
-s21::s21_set<T>::insert_many(Args&&... args) {
-  vector<std::pair<typename s21::s21_set<T>::iterator, bool>> results;
+vector<std::pair<
+    typename s21::s21_set<T, Compare, Augment, Backend>::iterator, bool>>
+s21::s21_set<T, Compare, Augment, Backend>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> results;
 
   if constexpr (sizeof...(Args) == 0) {
     return results;
@@ -5,24 +5,61 @@
 #include <stdexcept>
 
 #include "../RBTree/RedBlackTree.h"
+#include "../Snapshot/snapshot.h"
+#include "../Static/static_ordered_set.h"
 #include "../Vector/vector.h"
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Compare = std::less<T>,
+          typename Augment = NoAugmentation,
+          typename Backend = RedBlackTreeBackend>
 class s21_set {
  private:
-  RedBlackTree<T> tree;
+  // Дерево выбирает Backend: RedBlackTreeBackend, BTreeBackend<> или
+  // CompactRedBlackTreeBackend
+  typedef typename Backend::template tree<T, Compare, Augment> tree_type;
+
+  tree_type tree;
+
+ public:
+  // Вынутый узел: переносится в другое множество без копирования элемента
+  typedef typename tree_type::node_type node_type;
+
+ private:
+  explicit s21_set(tree_type&& other) : tree(std::move(other)) {}
 
  public:
   s21_set();  // Конструктор по умолчанию
 
   void insert(const T& value);  // Вставка элемента в множество
 
+  class iterator;  // Объявление класса итератора
+
+  // Вставка и поиск от подсказки: если value лежит рядом с hint (например,
+  // ключи приходят почти по возрастанию и hint - end() или предыдущий
+  // вставленный элемент), дерево не спускается от корня
+  iterator insert(iterator hint, const T& value);
+  iterator find(iterator hint, const T& value) const;
+
+  // Перенос узлов между множествами без копирования и выделений. Если
+  // равный элемент уже есть, insert оставляет узел в node, а merge - в other
+  node_type extract(const T& value);
+  node_type extract(iterator pos);
+  std::pair<iterator, bool> insert(node_type&& node);
+  void merge(s21_set& other);
+
   void erase(const T& value);  // Удаление элемента из множества
 
   bool contains(const T& value) const;  // Проверка наличия элемента в множестве
 
+  // Пакетная проверка n ключей, например проба соединения: спуски идут
+  // вперемешку, и промахи кеша разных ключей перекрываются. out[i] - есть
+  // ли keys[i]; find_batch пишет в out итератор на каждый ключ или end()
+  void contains_batch(const T* keys, size_t n, bool* out) const;
+  template <typename OutputIt>
+  OutputIt find_batch(const T* keys, size_t n, OutputIt out) const;
+
   void clear();  // Очистка множества
 
   bool empty() const;  // Проверка, является ли множество пустым
@@ -31,19 +68,33 @@ class s21_set {
 
   size_t max_size() const;  // Получение максимального размера множества
 
-  typename RedBlackTree<T>::iterator find(
+  typename tree_type::iterator find(
       const T& value);  // Поиск элемента в множестве
 
   bool operator==(const s21_set& other) const;  // Оператор сравнения
 
   bool operator!=(const s21_set& other) const;  // Оператор неравенства
 
-  class iterator;  // Объявление класса итератора
-
   iterator begin() const;  // Итератор начала множества
 
   iterator end() const;  // Итератор конца множества
 
+  // Границы за O(log n): первый элемент не меньше value, первый больше
+  // value и пара из них
+  iterator lower_bound(const T& value) const;
+  iterator upper_bound(const T& value) const;
+  std::pair<iterator, iterator> equal_range(const T& value) const;
+  // Вызывает fn(const T&) для элементов из [lo, hi) по порядку
+  template <typename Fn>
+  void for_each_in_range(const T& lo, const T& hi, Fn fn) const;
+
+  // Порядковые статистики, нужен Augment = OrderStatistics: k-й по порядку
+  // элемент (с нуля), число элементов меньше value и число элементов в
+  // [lo, hi) - всё за O(log n)
+  iterator select(size_t k) const;
+  size_t rank(const T& value) const;
+  size_t count_range(const T& lo, const T& hi) const;
+
   s21_set(const s21_set& other);  // Конструктор копирования
 
   s21_set(s21_set&& other) noexcept;  // Конструктор перемещения
@@ -56,16 +107,56 @@ class s21_set {
   s21_set(std::initializer_list<T> init_list);  // Конструктор с инициализацией
                                                 // из списка инициализаторов
 
+  // Конструктор из диапазона; упорядоченный диапазон собирается за O(n)
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  s21_set(InputIt first, InputIt last);
+
+  // Заменяет содержимое упорядоченной последовательностью за O(n)
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last);
+
+  // Неизменяемый снимок за O(n) для наборов, которые после сборки только
+  // читают: раскладка Эйтцингера без узлов и указателей, повторы
+  // схлопываются
+  static_ordered_set<T, Compare> freeze() const;
+
+  // Двоичный снимок (см. Snapshot/snapshot.h) для тривиально копируемых
+  // T. load читает и проверяет снимок целиком и собирает дерево за O(n);
+  // при ошибке бросает std::runtime_error и не меняет множество
+  void save(std::ostream& out) const;
+  void load(std::istream& in);
+
+  // Объединение, пересечение и разность за O(m log(n/m + 1)): узлы other
+  // переходят в это множество без копирования. С executor (например,
+  // s21::task_scheduler) крупные поддеревья обрабатываются параллельно
+  void set_union(s21_set other);
+  void set_intersection(s21_set other);
+  void set_difference(s21_set other);
+  template <typename Executor>
+  void set_union(s21_set other, Executor& executor);
+  template <typename Executor>
+  void set_intersection(s21_set other, Executor& executor);
+  template <typename Executor>
+  void set_difference(s21_set other, Executor& executor);
+
+  // Дописывает other, все элементы которого не меньше наших, за O(log n)
+  void join(s21_set other);
+  // Оставляет элементы меньше key, остальные возвращает
+  s21_set split(const T& key);
+
   template <typename... Args>
-  vector<std::pair<typename s21_set<T>::iterator, bool>> insert_many(
+  vector<std::pair<typename s21_set::iterator, bool>> insert_many(
       Args&&... args);
 
   class iterator {
    private:
-    typename RedBlackTree<T>::iterator iter;
+    typename tree_type::iterator iter;
+
+    friend class s21_set;
 
    public:
-    iterator(typename RedBlackTree<T>::iterator it) : iter(it) {}
+    iterator(typename tree_type::iterator it) : iter(it) {}
 
     T& operator*() const { return *iter; }
 
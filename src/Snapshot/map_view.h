@@ -0,0 +1,200 @@
+#ifndef MAP_VIEW_H
+#define MAP_VIEW_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "snapshot.h"
+
+namespace s21 {
+
+// Словарь только для чтения поверх снимка s21_map::save, отображённого в
+// память через mmap. Открытие стоит O(1) и ничего не копирует: поиск идёт
+// двоичным поиском прямо по массиву ключей файла, страницы подгружает
+// ядро по мере обращений, а несколько процессов делят одну копию в page
+// cache. Конструктор проверяет заголовок и размер файла; контрольную
+// сумму (чтение всего файла) проверяет verify().
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class map_view {
+  static_assert(std::is_trivially_copyable<Key>::value &&
+                    std::is_trivially_copyable<Value>::value,
+                "map_view needs trivially copyable keys and values");
+  static_assert(alignof(Key) <= detail::kSnapshotAlign &&
+                    alignof(Value) <= detail::kSnapshotAlign,
+                "snapshot arrays are aligned to kSnapshotAlign");
+
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::size_t size_type;
+
+  explicit map_view(const std::string& path, const Compare& comp = Compare());
+  ~map_view() { unmap(); }
+
+  map_view(const map_view&) = delete;
+  map_view& operator=(const map_view&) = delete;
+  map_view(map_view&& other) noexcept;
+  map_view& operator=(map_view&& other) noexcept;
+
+  size_type size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+
+  // Указатель на значение в отображённом файле или nullptr
+  const Value* find(const Key& key) const;
+  bool contains(const Key& key) const { return find(key) != nullptr; }
+  const Value& at(const Key& key) const;
+  // Номер первого ключа не меньше key (size(), если такого нет)
+  size_type lower_bound(const Key& key) const;
+  // i-я по порядку пара
+  const Key& key(size_type i) const { return keys_[i]; }
+  const Value& value(size_type i) const { return values_[i]; }
+
+  // Сверяет контрольную сумму с содержимым файла
+  bool verify() const;
+
+ private:
+  void unmap();
+
+  void* data_;
+  std::size_t bytes_;
+  const Key* keys_;
+  const Value* values_;
+  size_type count_;
+  Compare comp_;
+};
+
+template <typename Key, typename Value, typename Compare>
+map_view<Key, Value, Compare>::map_view(const std::string& path,
+                                        const Compare& comp)
+    : data_(nullptr),
+      bytes_(0),
+      keys_(nullptr),
+      values_(nullptr),
+      count_(0),
+      comp_(comp) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Snapshot: cannot open " + path);
+  struct stat info;
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<std::uint64_t>(info.st_size) <
+          sizeof(detail::snapshot_header)) {
+    ::close(fd);
+    throw std::runtime_error("Snapshot: not a snapshot");
+  }
+  bytes_ = static_cast<std::size_t>(info.st_size);
+  data_ = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data_ == MAP_FAILED) {
+    data_ = nullptr;
+    throw std::runtime_error("Snapshot: mmap failed for " + path);
+  }
+  try {
+    const auto* header = static_cast<const detail::snapshot_header*>(data_);
+    detail::check_snapshot_header(*header, detail::snapshot_kind::map,
+                                  sizeof(Key), sizeof(Value));
+    std::uint64_t count = header->count;
+    // Переполнение при умножении отсекает и эта проверка: смещение
+    // значений не может быть больше файла
+    if (count > bytes_ / sizeof(Key) || header->values_offset > bytes_ ||
+        count > (bytes_ - header->values_offset) / sizeof(Value) ||
+        bytes_ != header->values_offset + count * sizeof(Value) +
+                      sizeof(std::uint64_t)) {
+      throw std::runtime_error("Snapshot: size mismatch");
+    }
+    const char* base = static_cast<const char*>(data_);
+    keys_ = reinterpret_cast<const Key*>(base + sizeof(*header));
+    values_ = reinterpret_cast<const Value*>(base + header->values_offset);
+    count_ = static_cast<size_type>(count);
+  } catch (...) {
+    unmap();
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename Compare>
+map_view<Key, Value, Compare>::map_view(map_view&& other) noexcept
+    : data_(other.data_),
+      bytes_(other.bytes_),
+      keys_(other.keys_),
+      values_(other.values_),
+      count_(other.count_),
+      comp_(other.comp_) {
+  other.data_ = nullptr;
+  other.bytes_ = 0;
+  other.count_ = 0;
+}
+
+template <typename Key, typename Value, typename Compare>
+map_view<Key, Value, Compare>& map_view<Key, Value, Compare>::operator=(
+    map_view&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    std::swap(data_, other.data_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(keys_, other.keys_);
+    std::swap(values_, other.values_);
+    std::swap(count_, other.count_);
+    std::swap(comp_, other.comp_);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename Compare>
+void map_view<Key, Value, Compare>::unmap() {
+  if (data_) ::munmap(data_, bytes_);
+  data_ = nullptr;
+  bytes_ = 0;
+  keys_ = nullptr;
+  values_ = nullptr;
+  count_ = 0;
+}
+
+template <typename Key, typename Value, typename Compare>
+typename map_view<Key, Value, Compare>::size_type
+map_view<Key, Value, Compare>::lower_bound(const Key& key) const {
+  return static_cast<size_type>(
+      std::lower_bound(keys_, keys_ + count_, key, comp_) - keys_);
+}
+
+template <typename Key, typename Value, typename Compare>
+const Value* map_view<Key, Value, Compare>::find(const Key& key) const {
+  size_type i = lower_bound(key);
+  if (i == count_ || comp_(key, keys_[i])) return nullptr;
+  return values_ + i;
+}
+
+template <typename Key, typename Value, typename Compare>
+const Value& map_view<Key, Value, Compare>::at(const Key& key) const {
+  const Value* value = find(key);
+  if (!value) throw std::out_of_range("Key not found");
+  return *value;
+}
+
+template <typename Key, typename Value, typename Compare>
+bool map_view<Key, Value, Compare>::verify() const {
+  if (!data_) return false;
+  detail::snapshot_checksum checksum;
+  checksum.update(data_, sizeof(detail::snapshot_header));
+  checksum.update(keys_, count_ * sizeof(Key));
+  checksum.update(values_, count_ * sizeof(Value));
+  const char* end = static_cast<const char*>(data_) + bytes_;
+  std::uint64_t stored;
+  std::memcpy(&stored, end - sizeof(stored), sizeof(stored));
+  return stored == checksum.value();
+}
+
+}  // namespace s21
+
+#endif  // MAP_VIEW_H
@@ -0,0 +1,293 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace s21 {
+
+namespace detail {
+
+// Двоичный снимок упорядоченного контейнера:
+//
+//   заголовок, 64 байта (snapshot_header)
+//   ключи: count элементов подряд, по возрастанию
+//   нули до границы kSnapshotAlign, затем значения (только у map)
+//   контрольная сумма заголовка, ключей и значений, 8 байт
+//
+// Числа записаны в порядке байтов машины, которая сохраняла снимок;
+// byte_order позволяет отличить чужой порядок от испорченного файла.
+// Массивы выровнены, так что map_view читает их прямо из mmap.
+
+constexpr char kSnapshotMagic[8] = {'S', '2', '1', 'S', 'N', 'A', 'P', 0};
+constexpr std::uint32_t kSnapshotVersion = 2;
+constexpr std::uint32_t kSnapshotByteOrder = 0x01020304;
+constexpr std::size_t kSnapshotAlign = 16;
+
+enum class snapshot_kind : std::uint32_t { set = 1, multiset = 2, map = 3 };
+
+struct snapshot_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t kind;
+  std::uint32_t key_size;
+  std::uint32_t value_size;  // 0 у множеств
+  std::uint32_t reserved;
+  std::uint64_t count;
+  std::uint64_t values_offset;  // от начала файла, 0 у множеств
+  unsigned char padding[16];
+};
+static_assert(sizeof(snapshot_header) == 64, "snapshot header is 64 bytes");
+
+// Смещение значений: сразу за ключами, выровненное по kSnapshotAlign
+inline std::uint64_t snapshot_values_offset(std::uint64_t count,
+                                            std::uint64_t key_size) {
+  std::uint64_t end = sizeof(snapshot_header) + count * key_size;
+  return (end + kSnapshotAlign - 1) / kSnapshotAlign * kSnapshotAlign;
+}
+
+// Контрольная сумма: FNV-1a по 8-байтным словам с перемешиванием. Не
+// зависит от того, какими кусками приходят данные
+class snapshot_checksum {
+ public:
+  void update(const void* data, std::size_t bytes);
+  std::uint64_t value() const;
+
+ private:
+  void mix(std::uint64_t word) {
+    state_ = (state_ ^ word) * 0x100000001b3ull;
+    state_ ^= state_ >> 29;
+  }
+
+  std::uint64_t state_ = 0xcbf29ce484222325ull;
+  std::uint64_t total_ = 0;
+  unsigned char tail_[8] = {};
+  std::size_t tail_size_ = 0;
+};
+
+inline void snapshot_checksum::update(const void* data, std::size_t bytes) {
+  const unsigned char* next = static_cast<const unsigned char*>(data);
+  total_ += bytes;
+  if (tail_size_ > 0) {
+    std::size_t take = std::min(bytes, sizeof(tail_) - tail_size_);
+    std::memcpy(tail_ + tail_size_, next, take);
+    tail_size_ += take;
+    next += take;
+    bytes -= take;
+    if (tail_size_ < sizeof(tail_)) return;
+    std::uint64_t word;
+    std::memcpy(&word, tail_, sizeof(word));
+    mix(word);
+    tail_size_ = 0;
+  }
+  for (; bytes >= sizeof(std::uint64_t); bytes -= sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, next, sizeof(word));
+    mix(word);
+    next += sizeof(word);
+  }
+  std::memcpy(tail_, next, bytes);
+  tail_size_ = bytes;
+}
+
+inline std::uint64_t snapshot_checksum::value() const {
+  snapshot_checksum last = *this;
+  std::uint64_t word = 0;
+  std::memcpy(&word, tail_, tail_size_);
+  last.mix(word);
+  last.mix(total_);
+  return last.state_;
+}
+
+inline snapshot_header make_snapshot_header(snapshot_kind kind,
+                                            std::size_t key_size,
+                                            std::size_t value_size,
+                                            std::uint64_t count) {
+  snapshot_header header = {};
+  std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+  header.version = kSnapshotVersion;
+  header.byte_order = kSnapshotByteOrder;
+  header.kind = static_cast<std::uint32_t>(kind);
+  header.key_size = static_cast<std::uint32_t>(key_size);
+  header.value_size = static_cast<std::uint32_t>(value_size);
+  header.count = count;
+  header.values_offset =
+      value_size ? snapshot_values_offset(count, key_size) : 0;
+  return header;
+}
+
+// Проверяет заголовок на соответствие ожидаемому контейнеру
+inline void check_snapshot_header(const snapshot_header& header,
+                                  snapshot_kind kind, std::size_t key_size,
+                                  std::size_t value_size) {
+  if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("Snapshot: not a snapshot");
+  }
+  if (header.byte_order != kSnapshotByteOrder) {
+    throw std::runtime_error("Snapshot: foreign byte order");
+  }
+  if (header.version != kSnapshotVersion) {
+    throw std::runtime_error("Snapshot: unsupported version");
+  }
+  if (header.kind != static_cast<std::uint32_t>(kind) ||
+      header.key_size != key_size || header.value_size != value_size) {
+    throw std::runtime_error("Snapshot: container type mismatch");
+  }
+  if (value_size &&
+      header.values_offset != snapshot_values_offset(header.count, key_size)) {
+    throw std::runtime_error("Snapshot: corrupted header");
+  }
+}
+
+// Пишет снимок в поток: заголовок, затем элементы по одному через
+// write, затем finish. Элементы копятся в буфере, чтобы не звать
+// ostream::write на каждый
+class snapshot_writer {
+ public:
+  snapshot_writer(std::ostream& out, const snapshot_header& header)
+      : out_(out), written_(0) {
+    buffer_.reserve(kBufferBytes);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    checksum_.update(&header, sizeof(header));
+    written_ = sizeof(header);
+  }
+
+  template <typename T>
+  void write(const T& item) {
+    const char* bytes = reinterpret_cast<const char*>(&item);
+    checksum_.update(bytes, sizeof(T));
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+    if (buffer_.size() >= kBufferBytes) flush();
+  }
+  // Дописывает нули до смещения значений
+  void pad_to(std::uint64_t offset) {
+    while (written_ + buffer_.size() < offset) buffer_.push_back(0);
+  }
+  void finish() {
+    std::uint64_t sum = checksum_.value();
+    const char* bytes = reinterpret_cast<const char*>(&sum);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(sum));
+    flush();
+    out_.flush();
+    if (!out_) throw std::runtime_error("Snapshot: write failed");
+  }
+
+ private:
+  static constexpr std::size_t kBufferBytes = 1 << 16;
+
+  void flush() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    written_ += buffer_.size();
+    buffer_.clear();
+  }
+
+  std::ostream& out_;
+  std::uint64_t written_;
+  std::vector<char> buffer_;
+  snapshot_checksum checksum_;
+};
+
+// Читает снимок из потока в порядке записи. Массивы растут по мере
+// чтения, так что испорченный count не выделит память заранее
+class snapshot_reader {
+ public:
+  snapshot_reader(std::istream& in, snapshot_kind kind, std::size_t key_size,
+                  std::size_t value_size)
+      : in_(in), read_(0) {
+    read_bytes(&header_, sizeof(header_));
+    check_snapshot_header(header_, kind, key_size, value_size);
+    checksum_.update(&header_, sizeof(header_));
+  }
+
+  std::uint64_t count() const { return header_.count; }
+
+  template <typename T>
+  void read_array(std::vector<T>& items) {
+    constexpr std::size_t kChunk = (1 << 16) / sizeof(T) + 1;
+    items.clear();
+    for (std::uint64_t left = header_.count; left > 0;) {
+      std::size_t n = static_cast<std::size_t>(
+          std::min<std::uint64_t>(left, kChunk));
+      std::size_t old_size = items.size();
+      items.resize(old_size + n);
+      read_bytes(items.data() + old_size, n * sizeof(T));
+      checksum_.update(items.data() + old_size, n * sizeof(T));
+      left -= n;
+    }
+  }
+  void skip_to(std::uint64_t offset) {
+    char zero[kSnapshotAlign];
+    if (offset < read_ || offset - read_ > sizeof(zero)) {
+      throw std::runtime_error("Snapshot: corrupted header");
+    }
+    read_bytes(zero, static_cast<std::size_t>(offset - read_));
+  }
+  void finish() {
+    std::uint64_t sum;
+    read_bytes(&sum, sizeof(sum));
+    if (sum != checksum_.value()) {
+      throw std::runtime_error("Snapshot: checksum mismatch");
+    }
+  }
+
+ private:
+  void read_bytes(void* to, std::size_t bytes) {
+    in_.read(static_cast<char*>(to), static_cast<std::streamsize>(bytes));
+    if (static_cast<std::size_t>(in_.gcount()) != bytes) {
+      throw std::runtime_error("Snapshot: unexpected end of data");
+    }
+    read_ += bytes;
+  }
+
+  std::istream& in_;
+  std::uint64_t read_;
+  snapshot_header header_;
+  snapshot_checksum checksum_;
+};
+
+// Снимок множества: элементы дерева по порядку
+template <typename T, typename Tree>
+void save_tree_snapshot(std::ostream& out, snapshot_kind kind,
+                        const Tree& tree) {
+  snapshot_writer writer(
+      out, make_snapshot_header(kind, sizeof(T), 0, tree.size()));
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it) writer.write(*it);
+  writer.finish();
+}
+
+// Читает и проверяет снимок множества целиком, затем собирает дерево за
+// O(n). Элементы множества должны строго возрастать, мультимножества -
+// не убывать. При любой ошибке дерево не меняется
+template <typename T, typename Tree>
+void load_tree_snapshot(std::istream& in, snapshot_kind kind, Tree& tree) {
+  snapshot_reader reader(in, kind, sizeof(T), 0);
+  std::vector<T> items;
+  reader.read_array(items);
+  reader.finish();
+  auto comp = tree.value_comp();
+  if (kind == snapshot_kind::set) {
+    auto repeat = std::adjacent_find(
+        items.begin(), items.end(),
+        [&comp](const T& a, const T& b) { return !comp(a, b); });
+    if (repeat != items.end()) {
+      throw std::runtime_error(
+          "Snapshot: elements are not strictly increasing");
+    }
+  } else if (!std::is_sorted(items.begin(), items.end(), comp)) {
+    throw std::runtime_error("Snapshot: elements are not sorted");
+  }
+  tree.assign_sorted(items.begin(), items.end());
+}
+
+}  // namespace detail
+
+}  // namespace s21
+
+#endif  // SNAPSHOT_H
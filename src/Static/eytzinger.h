@@ -0,0 +1,133 @@
+#ifndef EYTZINGER_H
+#define EYTZINGER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../RBTree/Prefetch.h"
+
+namespace s21 {
+
+namespace detail {
+
+// Раскладка Эйтцингера: n упорядоченных элементов лежат в порядке обхода
+// в ширину неявного дерева поиска. Узел с номером k (нумерация с единицы)
+// хранится в ячейке k - 1, его дети - узлы 2k и 2k + 1. Верхние уровни,
+// которые нужны каждому поиску, занимают первые строки кеша, а потомки
+// узла на несколько уровней вниз (для int - на четыре) лежат подряд и
+// подтягиваются одной предвыборкой.
+// Номер 0 означает "нет узла".
+
+// Число единиц в младших разрядах k
+inline std::size_t eytzinger_trailing_ones(std::size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(
+      __builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+  std::size_t ones = 0;
+  for (; k & 1; k >>= 1) ++ones;
+  return ones;
+#endif
+}
+
+// Глубина узла k (корень - 0), то есть floor(log2(k)); k > 0
+inline std::size_t eytzinger_depth(std::size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(
+      63 - __builtin_clzll(static_cast<unsigned long long>(k)));
+#else
+  std::size_t depth = 0;
+  while (k >>= 1) ++depth;
+  return depth;
+#endif
+}
+
+// Самый левый (наименьший) узел
+inline std::size_t eytzinger_first(std::size_t n) {
+  if (n == 0) return 0;
+  std::size_t k = 1;
+  while (2 * k <= n) k *= 2;
+  return k;
+}
+
+// Следующий по порядку узел после k или 0
+inline std::size_t eytzinger_next(std::size_t k, std::size_t n) {
+  if (2 * k + 1 <= n) {
+    k = 2 * k + 1;
+    while (2 * k <= n) k *= 2;
+    return k;
+  }
+  // Поднимаемся, пока приходим справа, и ещё на один уровень
+  return k >> (eytzinger_trailing_ones(k) + 1);
+}
+
+// Число узлов в поддереве k. Все уровни, кроме последнего, заполнены,
+// поэтому поддерево полное до предпоследнего уровня, а на последнем ему
+// принадлежит непрерывный отрезок номеров
+inline std::size_t eytzinger_subtree_size(std::size_t k, std::size_t n) {
+  if (k == 0 || k > n) return 0;
+  std::size_t levels = eytzinger_depth(n) - eytzinger_depth(k);
+  std::size_t width = std::size_t{1} << levels;
+  std::size_t first = k << levels;
+  std::size_t bottom = first > n ? 0 : std::min(width, n - first + 1);
+  return width - 1 + bottom;
+}
+
+// Порядок ячеек: order[k - 1] - номер по возрастанию элемента узла k
+inline std::vector<std::size_t> eytzinger_order(std::size_t n) {
+  std::vector<std::size_t> order(n);
+  std::size_t rank = 0;
+  for (std::size_t k = eytzinger_first(n); k; k = eytzinger_next(k, n)) {
+    order[k - 1] = rank++;
+  }
+  return order;
+}
+
+// Сколько потомков одного уровня помещается в строку кеша: на столько
+// узлов вперёд запрашивается предвыборка
+template <typename T>
+constexpr std::size_t eytzinger_prefetch_stride() {
+  std::size_t stride = 2;
+  while (stride * 2 * sizeof(T) <= 64) stride *= 2;
+  return stride;
+}
+
+// Первый узел, на котором less ложен (или 0). less(item) должен быть
+// истинен на префиксе упорядоченной последовательности. Спуск без
+// ветвлений: направление - это младший бит следующего номера
+template <typename T, typename Less>
+std::size_t eytzinger_search(const T* items, std::size_t n, Less less) {
+  constexpr std::size_t kStride = eytzinger_prefetch_stride<T>();
+  std::size_t k = 1;
+  while (k <= n) {
+    if (kStride * k <= n) {
+      prefetchForRead(items + kStride * k - 1, kStride * sizeof(T));
+    }
+    k = 2 * k + (less(items[k - 1]) ? 1 : 0);
+  }
+  // Последний поворот налево вёл к ответу: снимаем повороты направо
+  // после него и его самого
+  return k >> (eytzinger_trailing_ones(k) + 1);
+}
+
+// Число элементов, на которых less истинен
+template <typename T, typename Less>
+std::size_t eytzinger_count(const T* items, std::size_t n, Less less) {
+  std::size_t count = 0;
+  for (std::size_t k = 1; k <= n;) {
+    if (less(items[k - 1])) {
+      count += eytzinger_subtree_size(2 * k, n) + 1;
+      k = 2 * k + 1;
+    } else {
+      k = 2 * k;
+    }
+  }
+  return count;
+}
+
+}  // namespace detail
+
+}  // namespace s21
+
+#endif  // EYTZINGER_H
@@ -0,0 +1,208 @@
+#ifndef STATIC_ORDERED_MAP_H
+#define STATIC_ORDERED_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "eytzinger.h"
+
+namespace s21 {
+
+// Неизменяемый словарь в раскладке Эйтцингера, пара к static_ordered_set
+// (обычно снимок s21_map::freeze()). Ключи лежат отдельным массивом,
+// поэтому поиск читает только их; значения - в параллельном массиве в том
+// же порядке. Как и у flat_map, итератор возвращает пару ссылок
+// first/second, а не value_type&.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class static_ordered_map {
+  static_assert(!std::is_same<Value, bool>::value,
+                "std::vector<bool> has no contiguous storage");
+
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<const Key, Value> value_type;
+  typedef Compare key_compare;
+  typedef std::size_t size_type;
+
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::pair<const Key, Value> value_type;
+    typedef std::ptrdiff_t difference_type;
+    struct reference {
+      const Key& first;
+      const Value& second;
+    };
+    // operator-> должен вернуть что-то с operator->, а пары нет
+    struct pointer {
+      reference item;
+      const reference* operator->() const { return &item; }
+    };
+
+    const_iterator() : map_(nullptr), node_(0) {}
+
+    reference operator*() const {
+      return {map_->keys_[node_ - 1], map_->values_[node_ - 1]};
+    }
+    pointer operator->() const { return {**this}; }
+    const_iterator& operator++() {
+      node_ = detail::eytzinger_next(node_, map_->keys_.size());
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+    bool operator==(const const_iterator& other) const {
+      return node_ == other.node_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class static_ordered_map;
+
+    const_iterator(const static_ordered_map* map, size_type node)
+        : map_(map), node_(node) {}
+
+    const static_ordered_map* map_;
+    size_type node_;  // номер узла в раскладке, 0 - end()
+  };
+  typedef const_iterator iterator;
+
+  static_ordered_map() : comp_() {}
+  explicit static_ordered_map(const Compare& comp) : comp_(comp) {}
+  static_ordered_map(std::initializer_list<value_type> items,
+                     const Compare& comp = Compare())
+      : static_ordered_map(items.begin(), items.end(), comp) {}
+  // Пары упорядочиваются по ключу (упорядоченный диапазон - за O(n)); из
+  // пар с равными ключами остаётся первая
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  static_ordered_map(InputIt first, InputIt last,
+                     const Compare& comp = Compare());
+
+  const_iterator begin() const {
+    return const_iterator(this, detail::eytzinger_first(keys_.size()));
+  }
+  const_iterator end() const { return const_iterator(this, 0); }
+
+  bool empty() const { return keys_.empty(); }
+  size_type size() const { return keys_.size(); }
+  const Compare& key_comp() const { return comp_; }
+
+  const Value& at(const Key& key) const;
+  bool contains(const Key& key) const { return find(key) != end(); }
+  const_iterator find(const Key& key) const;
+  const_iterator lower_bound(const Key& key) const;
+  const_iterator upper_bound(const Key& key) const;
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  // Число ключей меньше key
+  size_type rank(const Key& key) const;
+
+  bool operator==(const static_ordered_map& other) const {
+    return keys_ == other.keys_ && values_ == other.values_;
+  }
+  bool operator!=(const static_ordered_map& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  // Номер узла с первым ключом не меньше key, 0 - нет такого
+  size_type lower_node(const Key& key) const {
+    return detail::eytzinger_search(
+        keys_.data(), keys_.size(),
+        [this, &key](const Key& item) { return comp_(item, key); });
+  }
+
+  std::vector<Key> keys_;  // в порядке обхода неявного дерева в ширину
+  std::vector<Value> values_;
+  Compare comp_;
+};
+
+template <typename Key, typename Value, typename Compare>
+template <typename InputIt, typename>
+static_ordered_map<Key, Value, Compare>::static_ordered_map(
+    InputIt first, InputIt last, const Compare& comp)
+    : comp_(comp) {
+  // value_type с константным ключом не переставить, сортируются копии
+  std::vector<std::pair<Key, Value>> sorted(first, last);
+  auto less = [this](const std::pair<Key, Value>& a,
+                     const std::pair<Key, Value>& b) {
+    return comp_(a.first, b.first);
+  };
+  if (!std::is_sorted(sorted.begin(), sorted.end(), less)) {
+    std::stable_sort(sorted.begin(), sorted.end(), less);
+  }
+  sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                           [&less](const std::pair<Key, Value>& a,
+                                   const std::pair<Key, Value>& b) {
+                             return !less(a, b);
+                           }),
+               sorted.end());
+  std::vector<std::size_t> order = detail::eytzinger_order(sorted.size());
+  keys_.reserve(sorted.size());
+  values_.reserve(sorted.size());
+  for (std::size_t rank : order) {
+    keys_.push_back(std::move(sorted[rank].first));
+    values_.push_back(std::move(sorted[rank].second));
+  }
+}
+
+template <typename Key, typename Value, typename Compare>
+const Value& static_ordered_map<Key, Value, Compare>::at(
+    const Key& key) const {
+  size_type node = lower_node(key);
+  if (node == 0 || comp_(key, keys_[node - 1])) {
+    throw std::out_of_range("Key not found");
+  }
+  return values_[node - 1];
+}
+
+template <typename Key, typename Value, typename Compare>
+typename static_ordered_map<Key, Value, Compare>::const_iterator
+static_ordered_map<Key, Value, Compare>::find(const Key& key) const {
+  size_type node = lower_node(key);
+  if (node == 0 || comp_(key, keys_[node - 1])) return end();
+  return const_iterator(this, node);
+}
+
+template <typename Key, typename Value, typename Compare>
+typename static_ordered_map<Key, Value, Compare>::const_iterator
+static_ordered_map<Key, Value, Compare>::lower_bound(const Key& key) const {
+  return const_iterator(this, lower_node(key));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename static_ordered_map<Key, Value, Compare>::const_iterator
+static_ordered_map<Key, Value, Compare>::upper_bound(const Key& key) const {
+  return const_iterator(
+      this, detail::eytzinger_search(
+                keys_.data(), keys_.size(),
+                [this, &key](const Key& item) { return !comp_(key, item); }));
+}
+
+template <typename Key, typename Value, typename Compare>
+typename static_ordered_map<Key, Value, Compare>::size_type
+static_ordered_map<Key, Value, Compare>::rank(const Key& key) const {
+  return detail::eytzinger_count(
+      keys_.data(), keys_.size(),
+      [this, &key](const Key& item) { return comp_(item, key); });
+}
+
+}  // namespace s21
+
+#endif  // STATIC_ORDERED_MAP_H
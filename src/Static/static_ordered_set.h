@@ -0,0 +1,172 @@
+#ifndef STATIC_ORDERED_SET_H
+#define STATIC_ORDERED_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "eytzinger.h"
+
+namespace s21 {
+
+// Неизменяемое упорядоченное множество для данных, которые собирают один
+// раз и дальше только читают (обычно это снимок s21_set::freeze()).
+// Элементы лежат в одном массиве в раскладке Эйтцингера: ни узлов, ни
+// указателей, ни поддержки вращений. Поиск спускается по неявному дереву
+// без ветвлений и заранее подтягивает потомков на несколько уровней
+// вперёд, поэтому на больших наборах он быстрее и двоичного поиска по
+// отсортированному массиву, и спуска по дереву из узлов. Обход по порядку
+// стоит O(1) амортизированно на шаг, rank - O(log n).
+template <typename T, typename Compare = std::less<T>>
+class static_ordered_set {
+ public:
+  typedef T key_type;
+  typedef T value_type;
+  typedef Compare key_compare;
+  typedef Compare value_compare;
+  typedef std::size_t size_type;
+
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    const_iterator() : set_(nullptr), node_(0) {}
+
+    reference operator*() const { return set_->items_[node_ - 1]; }
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++() {
+      node_ = detail::eytzinger_next(node_, set_->items_.size());
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+    bool operator==(const const_iterator& other) const {
+      return node_ == other.node_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class static_ordered_set;
+
+    const_iterator(const static_ordered_set* set, size_type node)
+        : set_(set), node_(node) {}
+
+    const static_ordered_set* set_;
+    size_type node_;  // номер узла в раскладке, 0 - end()
+  };
+  typedef const_iterator iterator;
+
+  static_ordered_set() : comp_() {}
+  explicit static_ordered_set(const Compare& comp) : comp_(comp) {}
+  static_ordered_set(std::initializer_list<T> init_list,
+                     const Compare& comp = Compare())
+      : static_ordered_set(init_list.begin(), init_list.end(), comp) {}
+  // Упорядоченный диапазон раскладывается за O(n), иначе он сначала
+  // сортируется. Из равных элементов остаётся первый
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  static_ordered_set(InputIt first, InputIt last,
+                     const Compare& comp = Compare());
+
+  const_iterator begin() const {
+    return const_iterator(this, detail::eytzinger_first(items_.size()));
+  }
+  const_iterator end() const { return const_iterator(this, 0); }
+
+  bool empty() const { return items_.empty(); }
+  size_type size() const { return items_.size(); }
+  const Compare& value_comp() const { return comp_; }
+
+  bool contains(const T& value) const { return find(value) != end(); }
+  const_iterator find(const T& value) const;
+  const_iterator lower_bound(const T& value) const;
+  const_iterator upper_bound(const T& value) const;
+  std::pair<const_iterator, const_iterator> equal_range(
+      const T& value) const {
+    return {lower_bound(value), upper_bound(value)};
+  }
+  // Число элементов меньше value
+  size_type rank(const T& value) const;
+
+  bool operator==(const static_ordered_set& other) const {
+    return items_ == other.items_;
+  }
+  bool operator!=(const static_ordered_set& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  std::vector<T> items_;  // в порядке обхода неявного дерева в ширину
+  Compare comp_;
+};
+
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+static_ordered_set<T, Compare>::static_ordered_set(InputIt first,
+                                                   InputIt last,
+                                                   const Compare& comp)
+    : comp_(comp) {
+  std::vector<T> sorted(first, last);
+  if (!std::is_sorted(sorted.begin(), sorted.end(), comp_)) {
+    std::stable_sort(sorted.begin(), sorted.end(), comp_);
+  }
+  sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                           [this](const T& a, const T& b) {
+                             return !comp_(a, b);
+                           }),
+               sorted.end());
+  std::vector<std::size_t> order = detail::eytzinger_order(sorted.size());
+  items_.reserve(sorted.size());
+  for (std::size_t rank : order) items_.push_back(std::move(sorted[rank]));
+}
+
+template <typename T, typename Compare>
+typename static_ordered_set<T, Compare>::const_iterator
+static_ordered_set<T, Compare>::find(const T& value) const {
+  const_iterator it = lower_bound(value);
+  if (it != end() && comp_(value, *it)) return end();
+  return it;
+}
+
+template <typename T, typename Compare>
+typename static_ordered_set<T, Compare>::const_iterator
+static_ordered_set<T, Compare>::lower_bound(const T& value) const {
+  return const_iterator(
+      this, detail::eytzinger_search(
+                items_.data(), items_.size(),
+                [this, &value](const T& item) { return comp_(item, value); }));
+}
+
+template <typename T, typename Compare>
+typename static_ordered_set<T, Compare>::const_iterator
+static_ordered_set<T, Compare>::upper_bound(const T& value) const {
+  return const_iterator(
+      this, detail::eytzinger_search(
+                items_.data(), items_.size(),
+                [this, &value](const T& item) { return !comp_(value, item); }));
+}
+
+template <typename T, typename Compare>
+typename static_ordered_set<T, Compare>::size_type
+static_ordered_set<T, Compare>::rank(const T& value) const {
+  return detail::eytzinger_count(
+      items_.data(), items_.size(),
+      [this, &value](const T& item) { return comp_(item, value); });
+}
+
+}  // namespace s21
+
+#endif  // STATIC_ORDERED_SET_H
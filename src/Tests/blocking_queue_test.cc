@@ -0,0 +1,125 @@
+#include "../Queue/blocking_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../Vector/vector.h"
+
+TEST(BlockingQueueTest, PushAndPopWait) {
+  s21::blocking_queue<int> q(4);
+  EXPECT_TRUE(q.push(1));
+  EXPECT_TRUE(q.push(2));
+  EXPECT_EQ(q.size(), 2u);
+
+  int value = 0;
+  EXPECT_TRUE(q.pop_wait(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(q.pop_wait(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(BlockingQueueTest, TryPushRespectsCapacity) {
+  s21::blocking_queue<int> q(2);
+  EXPECT_TRUE(q.try_push(1));
+  EXPECT_TRUE(q.try_push(2));
+  EXPECT_FALSE(q.try_push(3));
+
+  int value = 0;
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_TRUE(q.try_push(3));
+  EXPECT_THROW(s21::blocking_queue<int>(0), std::invalid_argument);
+}
+
+TEST(BlockingQueueTest, PopForTimesOut) {
+  s21::blocking_queue<int> q;
+  int value = 0;
+  EXPECT_FALSE(q.pop_for(value, std::chrono::milliseconds(10)));
+
+  q.push(7);
+  EXPECT_TRUE(q.pop_for(value, std::chrono::milliseconds(10)));
+  EXPECT_EQ(value, 7);
+}
+
+TEST(BlockingQueueTest, DrainTakesBatch) {
+  s21::blocking_queue<int> q;
+  for (int i = 0; i < 10; ++i) q.push(i);
+
+  vector<int> batch;
+  EXPECT_EQ(q.drain(batch, 4), 4u);
+  EXPECT_EQ(batch.size(), 4u);
+  EXPECT_EQ(batch.front(), 0);
+  EXPECT_EQ(batch.back(), 3);
+
+  EXPECT_EQ(q.drain(batch, 100), 6u);
+  EXPECT_EQ(batch.size(), 10u);
+  EXPECT_EQ(batch.back(), 9);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(BlockingQueueTest, CloseWakesConsumers) {
+  s21::blocking_queue<int> q;
+  q.push(1);
+  std::thread consumer([&q] {
+    int value = 0;
+    EXPECT_TRUE(q.pop_wait(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(q.pop_wait(value));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  q.close();
+  consumer.join();
+
+  EXPECT_TRUE(q.closed());
+  EXPECT_FALSE(q.push(2));
+  vector<int> batch;
+  EXPECT_EQ(q.drain(batch, 8), 0u);
+}
+
+TEST(BlockingQueueTest, BackpressureWithBatchConsumer) {
+  const int kProducers = 4;
+  const int kPerProducer = 2000;
+  s21::blocking_queue<int> q(8);
+  std::atomic<int> done{0};
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&] {
+      for (int i = 1; i <= kPerProducer; ++i) q.push(i);
+      if (++done == kProducers) q.close();
+    });
+  }
+
+  long long sum = 0;
+  vector<int> batch;
+  while (q.drain(batch, 16) > 0) {
+    EXPECT_LE(batch.size(), 16u);
+    for (int v : batch) sum += v;
+    batch.clear();
+  }
+  for (auto& t : producers) t.join();
+
+  EXPECT_EQ(sum, 1LL * kProducers * kPerProducer * (kPerProducer + 1) / 2);
+}
+
+// Move-only элементы проходят через очередь без копий
+TEST(BlockingQueueTest, MoveOnlyItems) {
+  s21::blocking_queue<std::unique_ptr<int>> queue(2);
+  EXPECT_TRUE(queue.push(std::make_unique<int>(1)));
+  auto second = std::make_unique<int>(2);
+  EXPECT_TRUE(queue.try_push(std::move(second)));
+  EXPECT_EQ(second, nullptr);
+  EXPECT_FALSE(queue.try_push(std::make_unique<int>(3)));
+
+  std::unique_ptr<int> value;
+  ASSERT_TRUE(queue.pop_wait(value));
+  EXPECT_EQ(*value, 1);
+  std::vector<std::unique_ptr<int>> rest;
+  EXPECT_EQ(queue.drain(rest, 8), 1u);
+  EXPECT_EQ(*rest[0], 2);
+}
@@ -0,0 +1,67 @@
+#include "../Concurrent/concurrent_set.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentSetTest, SingleThreadUpdates) {
+  s21::concurrent_set<int> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.insert(3));
+  EXPECT_TRUE(set.insert(1));
+  EXPECT_FALSE(set.insert(3));
+  EXPECT_TRUE(set.contains(1));
+  EXPECT_EQ(set.size(), 2u);
+
+  auto before = set.snapshot();
+  EXPECT_TRUE(set.erase(1));
+  EXPECT_FALSE(set.erase(1));
+  set.update([](const s21::persistent_set<int>& current) {
+    return current.insert(5).insert(7);
+  });
+  EXPECT_EQ(before, (s21::persistent_set<int>{1, 3}));
+  EXPECT_EQ(set.snapshot(), (s21::persistent_set<int>{3, 5, 7}));
+  EXPECT_EQ(set.read([](const s21::persistent_set<int>& current) {
+              return *current.lower_bound(4);
+            }),
+            5);
+  set.synchronize();
+  EXPECT_EQ(set.size(), 3u);
+}
+
+// Писатель добавляет и убирает пары {2k, 2k + 1} одной публикацией;
+// читатель в любой версии видит либо обе половины пары, либо ни одной
+TEST(ConcurrentSetTest, ReadersSeeConsistentVersions) {
+  s21::concurrent_set<int> set;
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.emplace_back([&set, &done, &torn] {
+      while (!done.load(std::memory_order_relaxed)) {
+        bool consistent = set.read([](const s21::persistent_set<int>& now) {
+          if (now.size() % 2 != 0) return false;
+          for (int value : now) {
+            if (!now.contains(value ^ 1)) return false;
+          }
+          return true;
+        });
+        if (!consistent) torn.fetch_add(1);
+        set.contains(42);
+      }
+    });
+  }
+  for (int step = 0; step < 2000; ++step) {
+    int pair = step % 50 * 2;
+    set.update([pair](const s21::persistent_set<int>& current) {
+      if (current.contains(pair)) return current.erase(pair).erase(pair + 1);
+      return current.insert(pair).insert(pair + 1);
+    });
+  }
+  done.store(true);
+  for (std::thread& reader : readers) reader.join();
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_TRUE(set.snapshot().is_balanced());
+}
@@ -0,0 +1,149 @@
+#include "../Flat/flat_map.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+TEST(FlatMapTest, InsertAtAndIndex) {
+  s21::flat_map<std::string, int> map = {{"b", 2}, {"a", 1}, {"b", 20}};
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.at("b"), 2);
+  EXPECT_THROW(map.at("z"), std::out_of_range);
+
+  auto result = map.insert("c", 3);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(result.first->first, "c");
+  EXPECT_FALSE(map.insert({"c", 30}).second);
+  map["d"] = 4;
+  map["a"] += 10;
+  EXPECT_EQ(map.at("a"), 11);
+  EXPECT_EQ(map.size(), 4u);
+
+  std::vector<std::string> keys;
+  for (auto item : map) keys.push_back(item.first);
+  EXPECT_EQ(keys, (std::vector<std::string>{"a", "b", "c", "d"}));
+
+  EXPECT_EQ(map.erase("b"), 1u);
+  EXPECT_EQ(map.erase("b"), 0u);
+  auto next = map.erase(map.find("c"));
+  EXPECT_EQ(next->first, "d");
+  EXPECT_FALSE(map.contains("c"));
+}
+
+TEST(FlatMapTest, BoundsRangeScanAndOrderStatistics) {
+  const s21::flat_map<int, int> map = {{10, 1}, {20, 2}, {30, 3}, {40, 4}};
+  EXPECT_EQ(map.lower_bound(20)->second, 2);
+  EXPECT_EQ(map.upper_bound(20)->second, 3);
+  EXPECT_EQ(map.upper_bound(40), map.end());
+  auto range = map.equal_range(25);
+  EXPECT_EQ(range.first, range.second);
+
+  EXPECT_EQ(map.select(1)->first, 20);
+  EXPECT_EQ(map.rank(35), 3u);
+  EXPECT_EQ(map.count_range(15, 40), 2u);
+
+  int sum = 0;
+  map.for_each_in_range(15, 40, [&sum](auto item) { sum += item.second; });
+  EXPECT_EQ(sum, 5);
+}
+
+// Пачки пар в случайном порядке и с повторами сверяются с std::map:
+// из повторов в пачке остаётся первая пара, имеющиеся ключи не меняются
+TEST(FlatMapTest, BulkInsertMatchesStdMap) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 1000);
+  s21::flat_map<int, int> map;
+  std::map<int, int> reference;
+  for (int round = 0; round < 40; ++round) {
+    std::vector<std::pair<int, int>> batch(round % 5 * 50);
+    for (auto& item : batch) item = {dist(gen), round};
+    if (round % 4 == 0) std::sort(batch.begin(), batch.end());
+    map.insert(batch.begin(), batch.end());
+    reference.insert(batch.begin(), batch.end());
+    for (int i = 0; i < 10; ++i) {
+      int key = dist(gen);
+      ASSERT_EQ(map.erase(key), reference.erase(key));
+    }
+    ASSERT_EQ(map.size(), reference.size());
+    auto it = map.begin();
+    for (const auto& item : reference) {
+      ASSERT_EQ(it->first, item.first);
+      ASSERT_EQ(it->second, item.second);
+      ++it;
+    }
+  }
+}
+
+TEST(FlatMapTest, MergeAndHeterogeneousLookup) {
+  s21::flat_map<std::string, int, std::less<>> map = {{"a", 1}, {"c", 3}};
+  s21::flat_map<std::string, int, std::less<>> other = {{"b", 2}, {"c", 30}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ(map.at("c"), 3);
+  EXPECT_EQ(other.size(), 1u);
+  EXPECT_EQ(other.find(std::string_view("c"))->second, 30);
+  EXPECT_TRUE(map.contains(std::string_view("b")));
+
+  auto hint = map.insert(map.end(), {"d", 4});
+  EXPECT_EQ(hint->second, 4);
+  hint->second = 40;
+  EXPECT_EQ(map.at("d"), 40);
+}
+
+TEST(FlatMapTest, ExtractSequenceAndReplace) {
+  s21::flat_map<int, std::string> map = {{2, "b"}, {1, "a"}};
+  auto sequence = map.extract_sequence();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(sequence.keys, (std::vector<int>{1, 2}));
+  EXPECT_EQ(sequence.values, (std::vector<std::string>{"a", "b"}));
+
+  sequence.keys.push_back(5);
+  sequence.values.push_back("e");
+  map.replace(std::move(sequence.keys), std::move(sequence.values));
+  EXPECT_EQ(map.at(5), "e");
+  EXPECT_THROW(map.replace({2, 1}, {"b", "a"}), std::invalid_argument);
+  EXPECT_THROW(map.replace({1}, {}), std::invalid_argument);
+}
+
+namespace {
+
+// Значение, копия которого бросает, когда счётчик доходит до нуля
+struct FragileValue {
+  static int copies_left;
+  int value;
+
+  FragileValue(int value) : value(value) {}
+  FragileValue(const FragileValue& other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("copy failed");
+  }
+  FragileValue& operator=(const FragileValue&) = default;
+};
+int FragileValue::copies_left = -1;
+
+}  // namespace
+
+// Исключение посреди пакетной вставки не рассинхронизирует массивы и не
+// оставляет неупорядоченный хвост
+TEST(FlatMapTest, BulkInsertRollsBackOnThrow) {
+  s21::flat_map<int, FragileValue> map = {{10, 1}, {20, 2}, {30, 3}};
+  std::vector<std::pair<int, FragileValue>> batch = {
+      {25, 4}, {5, 5}, {15, 6}, {35, 7}};
+  FragileValue::copies_left = 2;
+  EXPECT_THROW(map.insert(batch.begin(), batch.end()), std::runtime_error);
+  FragileValue::copies_left = -1;
+  ASSERT_EQ(map.size(), 3u);
+  EXPECT_EQ(map.at(20).value, 2);
+  EXPECT_FALSE(map.contains(25));
+  EXPECT_EQ(map.lower_bound(11)->first, 20);
+
+  map.insert(batch.begin(), batch.end());
+  EXPECT_EQ(map.size(), 7u);
+  EXPECT_EQ(map.begin()->first, 5);
+}
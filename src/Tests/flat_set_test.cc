@@ -0,0 +1,116 @@
+#include "../Flat/flat_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST(FlatSetTest, InsertFindErase) {
+  s21::flat_set<int> set = {5, 1, 9, 1, 3};
+  EXPECT_EQ(set.size(), 4u);
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{1, 3, 5, 9}));
+
+  auto result = set.insert(4);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(*result.first, 4);
+  EXPECT_FALSE(set.insert(4).second);
+  EXPECT_TRUE(set.contains(4));
+  EXPECT_EQ(set.find(6), set.end());
+
+  EXPECT_EQ(set.erase(4), 1u);
+  EXPECT_EQ(set.erase(4), 0u);
+  EXPECT_EQ(*set.erase(set.find(3)), 5);
+  EXPECT_EQ(set, (s21::flat_set<int>{1, 5, 9}));
+}
+
+TEST(FlatSetTest, BoundsAndOrderStatistics) {
+  s21::flat_set<int> set = {10, 20, 30, 40};
+  EXPECT_EQ(*set.lower_bound(20), 20);
+  EXPECT_EQ(*set.upper_bound(20), 30);
+  EXPECT_EQ(set.upper_bound(40), set.end());
+  auto range = set.equal_range(25);
+  EXPECT_EQ(range.first, range.second);
+
+  EXPECT_EQ(*set.select(2), 30);
+  EXPECT_THROW(set.select(4), std::out_of_range);
+  EXPECT_EQ(set.rank(35), 3u);
+  EXPECT_EQ(set.count_range(15, 40), 2u);
+  EXPECT_EQ(set.count_range(40, 15), 0u);
+
+  int sum = 0;
+  set.for_each_in_range(15, 40, [&sum](const int& value) { sum += value; });
+  EXPECT_EQ(sum, 50);
+}
+
+// Пачки вставок, удаления и слияния сверяются с std::set
+TEST(FlatSetTest, BulkInsertMatchesStdSet) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 2000);
+  s21::flat_set<int> set;
+  std::set<int> reference;
+  for (int round = 0; round < 50; ++round) {
+    std::vector<int> batch(round % 7 * 40);
+    for (int& value : batch) value = dist(gen);
+    if (round % 5 == 0) std::sort(batch.begin(), batch.end());
+    set.insert(batch.begin(), batch.end());
+    reference.insert(batch.begin(), batch.end());
+    for (int i = 0; i < 20; ++i) {
+      int value = dist(gen);
+      ASSERT_EQ(set.erase(value), reference.erase(value));
+    }
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), set.begin(),
+                           set.end()));
+  }
+  for (int key = -1; key <= 2001; ++key) {
+    ASSERT_EQ(set.contains(key), reference.count(key) > 0);
+    auto expected =
+        std::distance(reference.begin(), reference.lower_bound(key));
+    ASSERT_EQ(set.rank(key), static_cast<size_t>(expected));
+  }
+}
+
+TEST(FlatSetTest, HintedInsert) {
+  s21::flat_set<int> set;
+  set.reserve(100);
+  auto last = set.end();
+  for (int value = 0; value < 100; value += 2) {
+    last = set.insert(set.end(), value);
+  }
+  EXPECT_EQ(*last, 98);
+  EXPECT_EQ(*set.insert(set.begin(), 51), 51);
+  EXPECT_EQ(*set.insert(set.begin(), 50), 50);
+  EXPECT_EQ(set.size(), 51u);
+  EXPECT_GE(set.capacity(), 51u);
+}
+
+TEST(FlatSetTest, MergeKeepsDuplicatesInOther) {
+  s21::flat_set<int> set = {1, 3, 5, 7}, other = {0, 3, 4, 7, 9};
+  set.merge(other);
+  EXPECT_EQ(set, (s21::flat_set<int>{0, 1, 3, 4, 5, 7, 9}));
+  EXPECT_EQ(other, (s21::flat_set<int>{3, 7}));
+}
+
+TEST(FlatSetTest, ExtractSequenceAndReplace) {
+  s21::flat_set<std::string, std::less<>> set = {"b", "a", "c"};
+  EXPECT_TRUE(set.contains(std::string_view("b")));
+  EXPECT_EQ(*set.find(std::string_view("c")), "c");
+
+  std::vector<std::string> items = set.extract_sequence();
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(items, (std::vector<std::string>{"a", "b", "c"}));
+
+  // Массив переходит обратно без копирования
+  items.push_back("d");
+  const std::string* data = items.data();
+  set.replace(std::move(items));
+  EXPECT_EQ(set.size(), 4u);
+  EXPECT_EQ(&*set.begin(), data);
+
+  EXPECT_THROW(set.replace({"b", "a"}), std::invalid_argument);
+  EXPECT_THROW(set.replace({"a", "a"}), std::invalid_argument);
+}
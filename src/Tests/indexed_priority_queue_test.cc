@@ -0,0 +1,151 @@
+#include "../PriorityQueue/indexed_priority_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(IndexedPriorityQueueTest, PushPopMinFirst) {
+  s21::indexed_priority_queue<std::string, int> pq;
+  pq.push("c", 30);
+  pq.push("a", 10);
+  pq.push("b", 20);
+
+  EXPECT_EQ(pq.size(), 3u);
+  EXPECT_EQ(pq.top_key(), "a");
+  EXPECT_EQ(pq.top_priority(), 10);
+  EXPECT_EQ(pq.pop(), std::make_pair(std::string("a"), 10));
+  EXPECT_EQ(pq.pop().first, "b");
+  EXPECT_EQ(pq.pop().first, "c");
+  EXPECT_TRUE(pq.empty());
+  EXPECT_THROW(pq.top(), std::out_of_range);
+  EXPECT_THROW(pq.pop(), std::out_of_range);
+}
+
+TEST(IndexedPriorityQueueTest, ContainsAndPriority) {
+  s21::indexed_priority_queue<int, double> pq;
+  pq.push(7, 1.5);
+  EXPECT_TRUE(pq.contains(7));
+  EXPECT_FALSE(pq.contains(8));
+  EXPECT_DOUBLE_EQ(pq.priority(7), 1.5);
+  EXPECT_THROW(pq.priority(8), std::out_of_range);
+  EXPECT_THROW(pq.push(7, 2.0), std::invalid_argument);
+}
+
+TEST(IndexedPriorityQueueTest, DecreaseAndIncreaseKey) {
+  s21::indexed_priority_queue<int, int> pq;
+  for (int k = 0; k < 10; ++k) pq.push(k, 100 + k);
+
+  pq.decrease_key(9, 1);
+  EXPECT_EQ(pq.top_key(), 9);
+  pq.increase_key(9, 500);
+  EXPECT_EQ(pq.top_key(), 0);
+  EXPECT_THROW(pq.decrease_key(0, 1000), std::invalid_argument);
+  EXPECT_THROW(pq.increase_key(0, 1), std::invalid_argument);
+  EXPECT_THROW(pq.decrease_key(42, 1), std::out_of_range);
+
+  pq.push_or_update(5, 0);
+  EXPECT_EQ(pq.top_key(), 5);
+  pq.push_or_update(42, -1);
+  EXPECT_EQ(pq.top_key(), 42);
+}
+
+TEST(IndexedPriorityQueueTest, EraseArbitraryKey) {
+  s21::indexed_priority_queue<int, int> pq;
+  for (int k = 0; k < 20; ++k) pq.push(k, (k * 7) % 20);
+
+  EXPECT_TRUE(pq.erase(0));
+  EXPECT_TRUE(pq.erase(13));
+  EXPECT_FALSE(pq.erase(0));
+  EXPECT_FALSE(pq.contains(13));
+
+  int previous = std::numeric_limits<int>::min();
+  size_t popped = 0;
+  while (!pq.empty()) {
+    auto entry = pq.pop();
+    EXPECT_LE(previous, entry.second);
+    previous = entry.second;
+    ++popped;
+  }
+  EXPECT_EQ(popped, 18u);
+}
+
+TEST(IndexedPriorityQueueTest, DijkstraMatchesBellmanFord) {
+  const int kNodes = 200;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> node(0, kNodes - 1);
+  std::uniform_int_distribution<int> weight(1, 50);
+  std::vector<std::vector<std::pair<int, int>>> graph(kNodes);
+  for (int e = 0; e < kNodes * 5; ++e)
+    graph[node(gen)].push_back({node(gen), weight(gen)});
+
+  const long long kInf = std::numeric_limits<long long>::max();
+  std::vector<long long> expected(kNodes, kInf);
+  expected[0] = 0;
+  for (int round = 0; round < kNodes; ++round) {
+    for (int u = 0; u < kNodes; ++u) {
+      if (expected[u] == kInf) continue;
+      for (auto [v, w] : graph[u])
+        if (expected[u] + w < expected[v]) expected[v] = expected[u] + w;
+    }
+  }
+
+  std::vector<long long> dist(kNodes, kInf);
+  s21::indexed_priority_queue<int, long long> pq;
+  pq.reserve(kNodes);
+  dist[0] = 0;
+  pq.push(0, 0);
+  while (!pq.empty()) {
+    auto [u, d] = pq.pop();
+    for (auto [v, w] : graph[u]) {
+      if (d + w < dist[v]) {
+        dist[v] = d + w;
+        if (pq.contains(v))
+          pq.decrease_key(v, dist[v]);
+        else
+          pq.push(v, dist[v]);
+      }
+    }
+  }
+
+  EXPECT_EQ(dist, expected);
+}
+
+namespace {
+
+// Приоритет, копия которого бросает, пока fail_copies выставлен
+struct FragilePriority {
+  static bool fail_copies;
+  int value;
+
+  FragilePriority(int value) : value(value) {}
+  FragilePriority(const FragilePriority& other) : value(other.value) {
+    if (fail_copies) throw std::runtime_error("copy failed");
+  }
+  FragilePriority& operator=(const FragilePriority&) = default;
+  bool operator<(const FragilePriority& other) const {
+    return value < other.value;
+  }
+};
+bool FragilePriority::fail_copies = false;
+
+}  // namespace
+
+// Неудачный push не оставляет ключ в индексе, и его можно повторить
+TEST(IndexedPriorityQueueTest, FailedPushLeavesNoTrace) {
+  s21::indexed_priority_queue<int, FragilePriority> pq;
+  pq.push(1, 10);
+  FragilePriority::fail_copies = true;
+  EXPECT_THROW(pq.push(2, 5), std::runtime_error);
+  FragilePriority::fail_copies = false;
+  EXPECT_FALSE(pq.contains(2));
+  EXPECT_EQ(pq.size(), 1u);
+
+  pq.push(2, 5);
+  EXPECT_EQ(pq.top_key(), 2);
+  EXPECT_EQ(pq.size(), 2u);
+}
@@ -0,0 +1,116 @@
+#include "../Interval/interval_tree.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef std::pair<s21::interval<int>, int> Rule;
+
+// Ожидаемый ответ перебором, в порядке дерева
+std::vector<int> BruteOverlaps(std::vector<Rule> rules, int lo, int hi) {
+  std::stable_sort(rules.begin(), rules.end(),
+                   [](const Rule& a, const Rule& b) {
+                     if (a.first.low != b.first.low) {
+                       return a.first.low < b.first.low;
+                     }
+                     return a.first.high < b.first.high;
+                   });
+  std::vector<int> result;
+  for (const Rule& rule : rules) {
+    if (rule.first.low <= hi && lo <= rule.first.high) {
+      result.push_back(rule.second);
+    }
+  }
+  return result;
+}
+
+std::vector<int> Values(
+    const std::vector<std::pair<const s21::interval<int>, int>>& items) {
+  std::vector<int> result;
+  for (const auto& item : items) result.push_back(item.second);
+  return result;
+}
+
+}  // namespace
+
+TEST(IntervalTreeTest, PointAndRangeQueries) {
+  s21::interval_tree<int, std::string> ranges{
+      {{10, 20}, "a"}, {{15, 25}, "b"}, {{30, 40}, "c"}, {{0, 5}, "d"}};
+  auto hits = ranges.overlaps(17);
+  ASSERT_EQ(hits.size(), 2u);
+  EXPECT_EQ(hits[0].second, "a");
+  EXPECT_EQ(hits[1].second, "b");
+  EXPECT_TRUE(ranges.overlaps(27).empty());
+  // Концы входят в интервал
+  EXPECT_EQ(ranges.overlaps(40).size(), 1u);
+  EXPECT_EQ(ranges.overlaps(s21::interval<int>{5, 10}).size(), 2u);
+  EXPECT_EQ(ranges.overlaps(s21::interval<int>{-100, 100}).size(), 4u);
+
+  EXPECT_EQ(ranges.find({30, 40})->second, "c");
+  EXPECT_EQ(ranges.find({30, 41}), ranges.end());
+  EXPECT_THROW(ranges.insert({5, 4}, "bad"), std::invalid_argument);
+  EXPECT_EQ(ranges.size(), 4u);
+}
+
+TEST(IntervalTreeTest, DuplicatesAndErase) {
+  s21::interval_tree<int, int> tree;
+  tree.insert({1, 3}, 1);
+  tree.insert({1, 3}, 2);
+  tree.insert({2, 9}, 3);
+  EXPECT_EQ(Values(tree.overlaps(2)), (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(tree.erase(s21::interval<int>{1, 3}), 2u);
+  EXPECT_EQ(tree.erase(s21::interval<int>{1, 3}), 0u);
+  EXPECT_EQ(Values(tree.overlaps(2)), (std::vector<int>{3}));
+  tree.erase(tree.begin());
+  EXPECT_TRUE(tree.empty());
+  EXPECT_TRUE(tree.overlaps(2).empty());
+}
+
+// После случайных вставок и удалений дополнение остаётся верным: ответы
+// совпадают с перебором
+TEST(IntervalTreeTest, MatchesBruteForce) {
+  std::mt19937 random(49);
+  std::uniform_int_distribution<int> start(0, 1000);
+  std::uniform_int_distribution<int> length(0, 60);
+  s21::interval_tree<int, int> tree;
+  std::vector<Rule> rules;
+  for (int step = 0; step < 3000; ++step) {
+    if (rules.empty() || random() % 3 != 0) {
+      int low = start(random);
+      s21::interval<int> range{low, low + length(random)};
+      tree.insert(range, step);
+      rules.emplace_back(range, step);
+    } else {
+      s21::interval<int> range = rules[random() % rules.size()].first;
+      size_t expected = 0;
+      for (size_t i = 0; i < rules.size();) {
+        if (rules[i].first == range) {
+          rules.erase(rules.begin() + i);
+          ++expected;
+        } else {
+          ++i;
+        }
+      }
+      ASSERT_EQ(tree.erase(range), expected);
+    }
+    if (step % 50 == 0) {
+      ASSERT_EQ(tree.size(), rules.size());
+      if (!tree.empty()) {
+        ASSERT_TRUE(tree.isRedBlackTree());
+      }
+      for (int query = 0; query < 20; ++query) {
+        int lo = start(random);
+        int hi = lo + length(random) / 4;
+        ASSERT_EQ(Values(tree.overlaps(s21::interval<int>{lo, hi})),
+                  BruteOverlaps(rules, lo, hi));
+      }
+    }
+  }
+}
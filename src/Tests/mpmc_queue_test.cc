@@ -0,0 +1,165 @@
+#include "../Queue/mpmc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(MpmcQueueTest, CapacityRoundedUpToPowerOfTwo) {
+  s21::mpmc_queue<int> q(5);
+  EXPECT_EQ(q.capacity(), 8u);
+  EXPECT_THROW(s21::mpmc_queue<int>(0), std::invalid_argument);
+}
+
+TEST(MpmcQueueTest, CapacityOneHoldsTwoCells) {
+  s21::mpmc_queue<int> q(1);
+  EXPECT_EQ(q.capacity(), 2u);
+  EXPECT_TRUE(q.try_push(1));
+  EXPECT_TRUE(q.try_push(2));
+  EXPECT_FALSE(q.try_push(3));
+
+  int value = 0;
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(q.try_pop(value));
+}
+
+TEST(MpmcQueueTest, TryPushTryPopFifo) {
+  s21::mpmc_queue<int> q(4);
+  EXPECT_TRUE(q.try_push(1));
+  EXPECT_TRUE(q.try_push(2));
+  EXPECT_TRUE(q.try_push(3));
+  EXPECT_EQ(q.size_approx(), 3u);
+
+  int value = 0;
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(q.try_pop(value));
+  EXPECT_TRUE(q.empty_approx());
+}
+
+TEST(MpmcQueueTest, TryPushFailsWhenFull) {
+  s21::mpmc_queue<int> q(2);
+  EXPECT_TRUE(q.try_push(1));
+  EXPECT_TRUE(q.try_push(2));
+  EXPECT_FALSE(q.try_push(3));
+
+  int value = 0;
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_TRUE(q.try_push(3));
+}
+
+TEST(MpmcQueueTest, DestroysRemainingElements) {
+  auto shared = std::make_shared<int>(42);
+  {
+    s21::mpmc_queue<std::shared_ptr<int>> q(4);
+    q.push(shared);
+    q.push(shared);
+    EXPECT_EQ(shared.use_count(), 3);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(MpmcQueueTest, MoveOnlyValues) {
+  s21::mpmc_queue<std::unique_ptr<std::string>> q(2);
+  q.push(std::make_unique<std::string>("task"));
+  auto value = q.pop();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, "task");
+}
+
+namespace {
+
+// Без конструктора по умолчанию и без присваивания
+class Ticket {
+ public:
+  explicit Ticket(int id) : id_(id) {}
+  Ticket(Ticket&&) = default;
+  Ticket& operator=(Ticket&&) = delete;
+  int id() const { return id_; }
+
+ private:
+  int id_;
+};
+
+// Медленное перемещение: удачная операция надолго задерживается в
+// try_op, пока встречная сторона уже спит на своей парковке
+struct SlowMove {
+  explicit SlowMove(int v) : value(v) {}
+  SlowMove(SlowMove&& other) : value(other.value) {
+    std::this_thread::sleep_for(std::chrono::microseconds(300));
+  }
+  SlowMove& operator=(SlowMove&& other) {
+    value = other.value;
+    return *this;
+  }
+
+  int value;
+};
+
+}  // namespace
+
+TEST(MpmcQueueTest, PopNeedsOnlyMoveConstruction) {
+  s21::mpmc_queue<Ticket> q(2);
+  q.push(Ticket(7));
+  q.push(Ticket(8));
+  EXPECT_EQ(q.pop().id(), 7);
+  EXPECT_EQ(q.pop().id(), 8);
+}
+
+TEST(MpmcQueueTest, BlockingProducersAndConsumers) {
+  const int kProducers = 4;
+  const int kConsumers = 4;
+  const int kPerProducer = 10000;
+  s21::mpmc_queue<int> q(16);
+  std::atomic<long long> sum{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back([&q] {
+      for (int i = 1; i <= kPerProducer; ++i) q.push(i);
+    });
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.emplace_back([&q, &sum] {
+      for (int i = 0; i < kPerProducer; ++i) sum += q.pop();
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  long long expected = 1LL * kProducers * kPerProducer * (kPerProducer + 1) / 2;
+  EXPECT_EQ(sum.load(), expected);
+  EXPECT_TRUE(q.empty_approx());
+}
+
+// Спящие производители и потребители не блокируют друг друга
+TEST(MpmcQueueTest, SlowMovesDoNotDeadlock) {
+  const int kThreads = 3;
+  const int kPerThread = 150;
+  s21::mpmc_queue<SlowMove> q(2);
+  std::atomic<long long> sum{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&q] {
+      for (int i = 1; i <= kPerThread; ++i) q.push(SlowMove(i));
+    });
+    threads.emplace_back([&q, &sum] {
+      for (int i = 0; i < kPerThread; ++i) sum += q.pop().value;
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  EXPECT_EQ(sum.load(), 1LL * kThreads * kPerThread * (kPerThread + 1) / 2);
+  EXPECT_TRUE(q.empty_approx());
+}
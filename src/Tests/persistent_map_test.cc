@@ -0,0 +1,51 @@
+#include "../Persistent/persistent_map.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(PersistentMapTest, InsertOrAssignKeepsSnapshot) {
+  s21::persistent_map<std::string, int> config = {
+      {"timeout", 30}, {"retries", 3}, {"timeout", 60}};
+  EXPECT_EQ(config.size(), 2u);
+  EXPECT_EQ(config.at("timeout"), 30);
+
+  auto snapshot = config;
+  config = config.insert_or_assign("timeout", 45).insert("port", 8080);
+  EXPECT_EQ(config.at("timeout"), 45);
+  EXPECT_EQ(config.at("port"), 8080);
+  EXPECT_EQ(snapshot.at("timeout"), 30);
+  EXPECT_FALSE(snapshot.contains("port"));
+  EXPECT_THROW(snapshot.at("port"), std::out_of_range);
+
+  EXPECT_EQ(config.insert("port", 1).at("port"), 8080);
+  config = config.erase("retries");
+  EXPECT_EQ(config.size(), 2u);
+  EXPECT_EQ(snapshot.size(), 2u);
+  EXPECT_TRUE(config.is_balanced());
+}
+
+TEST(PersistentMapTest, OrderedAccess) {
+  std::vector<std::pair<int, std::string>> items;
+  for (int i = 99; i >= 0; --i) items.emplace_back(i, std::to_string(i));
+  s21::persistent_map<int, std::string> map(items.begin(), items.end());
+  EXPECT_TRUE(map.is_balanced());
+  EXPECT_EQ(map.begin()->first, 0);
+  EXPECT_EQ(map.select(42)->second, "42");
+  EXPECT_EQ(map.rank(50), 50u);
+  EXPECT_EQ(map.lower_bound(50)->first, 50);
+  EXPECT_EQ(map.upper_bound(99), map.end());
+  EXPECT_EQ(map.find(100), map.end());
+
+  int sum = 0;
+  map.for_each_in_range(10, 13, [&sum](const auto& item) {
+    sum += item.first;
+  });
+  EXPECT_EQ(sum, 33);
+
+  auto copy = map.erase(5).insert(5, "5");
+  EXPECT_EQ(copy, map);
+  EXPECT_NE(copy.insert_or_assign(5, "five"), map);
+}
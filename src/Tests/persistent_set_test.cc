@@ -0,0 +1,79 @@
+#include "../Persistent/persistent_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+TEST(PersistentSetTest, UpdatesReturnNewVersions) {
+  const s21::persistent_set<int> empty;
+  auto one = empty.insert(1);
+  auto two = one.insert(2);
+  auto same = two.insert(2);
+  auto back = two.erase(1);
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(one, (s21::persistent_set<int>{1}));
+  EXPECT_EQ(two, (s21::persistent_set<int>{1, 2}));
+  EXPECT_EQ(same, two);
+  EXPECT_EQ(back, (s21::persistent_set<int>{2}));
+  EXPECT_EQ(back.erase(7), back);
+  EXPECT_TRUE(two.contains(1));
+  EXPECT_FALSE(back.contains(1));
+}
+
+TEST(PersistentSetTest, BoundsAndOrderStatistics) {
+  s21::persistent_set<int> set = {40, 10, 30, 20, 10};
+  EXPECT_EQ(set.size(), 4u);
+  EXPECT_EQ(*set.lower_bound(20), 20);
+  EXPECT_EQ(*set.upper_bound(20), 30);
+  EXPECT_EQ(set.upper_bound(40), set.end());
+  EXPECT_EQ(set.find(25), set.end());
+  EXPECT_EQ(*set.select(3), 40);
+  EXPECT_THROW(set.select(4), std::out_of_range);
+  EXPECT_EQ(set.rank(35), 3u);
+
+  int sum = 0;
+  set.for_each_in_range(15, 40, [&sum](const int& value) { sum += value; });
+  EXPECT_EQ(sum, 50);
+}
+
+// Каждая версия, сохранённая по ходу случайных правок, остаётся равной
+// своему снимку в std::set и сбалансированной
+TEST(PersistentSetTest, OldVersionsSurviveUpdates) {
+  std::mt19937 gen(43);
+  std::uniform_int_distribution<int> dist(0, 500);
+  s21::persistent_set<int> current;
+  std::set<int> reference;
+  std::vector<s21::persistent_set<int>> versions;
+  std::vector<std::set<int>> snapshots;
+  for (int step = 0; step < 3000; ++step) {
+    int value = dist(gen);
+    if (step % 3 == 2) {
+      current = current.erase(value);
+      reference.erase(value);
+    } else {
+      current = current.insert(value);
+      reference.insert(value);
+    }
+    if (step % 100 == 0) {
+      versions.push_back(current);
+      snapshots.push_back(reference);
+    }
+  }
+  for (size_t i = 0; i < versions.size(); ++i) {
+    ASSERT_TRUE(versions[i].is_balanced());
+    ASSERT_EQ(versions[i].size(), snapshots[i].size());
+    ASSERT_TRUE(std::equal(snapshots[i].begin(), snapshots[i].end(),
+                           versions[i].begin()));
+  }
+  for (int key = 0; key <= 500; key += 7) {
+    auto expected =
+        std::distance(reference.begin(), reference.lower_bound(key));
+    ASSERT_EQ(current.rank(key), static_cast<size_t>(expected));
+  }
+}
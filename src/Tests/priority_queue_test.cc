@@ -0,0 +1,115 @@
+#include "../PriorityQueue/priority_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(PriorityQueueTest, PushPopOrder) {
+  s21::priority_queue<int> pq;
+  EXPECT_TRUE(pq.empty());
+  pq.push(5);
+  pq.push(1);
+  pq.push(9);
+  pq.push(3);
+
+  EXPECT_EQ(pq.size(), 4u);
+  EXPECT_EQ(pq.top(), 9);
+  EXPECT_EQ(pq.pop(), 9);
+  EXPECT_EQ(pq.pop(), 5);
+  EXPECT_EQ(pq.pop(), 3);
+  EXPECT_EQ(pq.pop(), 1);
+  EXPECT_TRUE(pq.empty());
+}
+
+TEST(PriorityQueueTest, EmptyThrows) {
+  s21::priority_queue<int> pq;
+  EXPECT_THROW(pq.top(), std::out_of_range);
+  EXPECT_THROW(pq.pop(), std::out_of_range);
+}
+
+TEST(PriorityQueueTest, MinHeapWithGreater) {
+  s21::priority_queue<int, std::greater<int>> pq = {4, 8, 2, 6};
+  EXPECT_EQ(pq.pop(), 2);
+  EXPECT_EQ(pq.pop(), 4);
+  EXPECT_EQ(pq.pop(), 6);
+  EXPECT_EQ(pq.pop(), 8);
+}
+
+TEST(PriorityQueueTest, EmplaceConstructsInPlace) {
+  s21::priority_queue<std::string> pq;
+  pq.emplace(3, 'a');
+  pq.emplace("zz");
+  pq.push(std::string("m"));
+  EXPECT_EQ(pq.pop(), "zz");
+  EXPECT_EQ(pq.pop(), "m");
+  EXPECT_EQ(pq.pop(), "aaa");
+}
+
+namespace {
+
+struct DerefLess {
+  bool operator()(const std::unique_ptr<int>& a,
+                  const std::unique_ptr<int>& b) const {
+    return *a < *b;
+  }
+};
+
+}  // namespace
+
+// unique_ptr не копируется: тест не соберётся, если emplace, push или pop
+// где-то копируют элемент
+TEST(PriorityQueueTest, EmplaceMoveOnly) {
+  s21::priority_queue<std::unique_ptr<int>, DerefLess> pq;
+  pq.emplace(new int(5));
+  pq.push(std::make_unique<int>(9));
+  for (int value : {1, 7, 3}) pq.push(std::make_unique<int>(value));
+  std::vector<int> popped;
+  while (!pq.empty()) popped.push_back(*pq.pop());
+  EXPECT_EQ(popped, (std::vector<int>{9, 7, 5, 3, 1}));
+}
+
+template <std::size_t Arity>
+static void CheckAgainstStd(unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  std::vector<int> values(500);
+  for (auto& v : values) v = dist(gen);
+
+  s21::priority_queue<int, std::less<int>, Arity> pq(values.begin(),
+                                                     values.begin() + 200);
+  std::priority_queue<int> expected(values.begin(), values.begin() + 200);
+  pq.push_range(values.begin() + 200, values.begin() + 250);
+  for (auto it = values.begin() + 200; it != values.begin() + 250; ++it)
+    expected.push(*it);
+  pq.push_range(values.begin() + 250, values.end());
+  for (auto it = values.begin() + 250; it != values.end(); ++it)
+    expected.push(*it);
+
+  ASSERT_EQ(pq.size(), expected.size());
+  while (!expected.empty()) {
+    ASSERT_EQ(pq.pop(), expected.top());
+    expected.pop();
+  }
+}
+
+TEST(PriorityQueueTest, HeapifyAndPushRangeMatchStd) {
+  CheckAgainstStd<2>(1);
+  CheckAgainstStd<4>(2);
+  CheckAgainstStd<8>(3);
+}
+
+TEST(PriorityQueueTest, ClearAndSwap) {
+  s21::priority_queue<int> a = {1, 2, 3};
+  s21::priority_queue<int> b;
+  a.swap(b);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(b.top(), 3);
+  b.clear();
+  EXPECT_TRUE(b.empty());
+}
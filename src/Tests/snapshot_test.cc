@@ -0,0 +1,191 @@
+#include "../Snapshot/snapshot.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../Map/map.h"
+#include "../Multiset/multiset.h"
+#include "../Set/set.h"
+#include "../Snapshot/map_view.h"
+
+namespace {
+
+std::string ExpectLoadError(const std::string& bytes, s21::s21_set<int>& set) {
+  std::istringstream in(bytes);
+  try {
+    set.load(in);
+  } catch (const std::runtime_error& error) {
+    return error.what();
+  }
+  return "";
+}
+
+}  // namespace
+
+TEST(SnapshotTest, SetAndMultisetRoundTrip) {
+  s21::s21_set<int> set;
+  for (int i = 0; i < 50000; ++i) set.insert((i * 7919) % 50021);
+  std::stringstream stream;
+  set.save(stream);
+  s21::s21_set<int> loaded;
+  loaded.insert(-1);
+  loaded.load(stream);
+  ASSERT_EQ(loaded.size(), set.size());
+  for (auto it = set.begin(), other = loaded.begin(); it != set.end();
+       ++it, ++other) {
+    ASSERT_EQ(*it, *other);
+  }
+
+  s21::s21_multiset<double> multiset{2.5, 1.0, 2.5, -3.0};
+  std::stringstream multi_stream;
+  multiset.save(multi_stream);
+  s21::s21_multiset<double> multi_loaded;
+  multi_loaded.load(multi_stream);
+  std::vector<double> items;
+  for (auto it = multi_loaded.begin(); it != multi_loaded.end(); ++it) {
+    items.push_back(*it);
+  }
+  EXPECT_EQ(items, (std::vector<double>{-3.0, 1.0, 2.5, 2.5}));
+
+  // Снимок множества не читается как мультимножество
+  std::istringstream wrong_kind(stream.str());
+  EXPECT_THROW(multi_loaded.load(wrong_kind), std::runtime_error);
+  EXPECT_EQ(multi_loaded.size(), 4u);
+
+  s21::s21_set<int> empty;
+  std::stringstream empty_stream;
+  empty.save(empty_stream);
+  loaded.load(empty_stream);
+  EXPECT_TRUE(loaded.empty());
+}
+
+TEST(SnapshotTest, MapRoundTrip) {
+  s21_map<int, double> map;
+  for (int i = 0; i < 1000; ++i) map.insert(i * 3, i * 0.5);
+  std::stringstream stream;
+  map.save(stream);
+  s21_map<int, double> loaded;
+  loaded.load(stream);
+  ASSERT_EQ(loaded.size(), map.size());
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(loaded.at(i * 3), i * 0.5);
+  EXPECT_FALSE(loaded.contains(1));
+  EXPECT_TRUE(loaded.isRedBlackTree());
+
+  // Другой размер значения - другой тип словаря
+  s21_map<int, float> other;
+  std::istringstream in(stream.str());
+  EXPECT_THROW(other.load(in), std::runtime_error);
+}
+
+// Любая порча обнаруживается, а множество остаётся прежним
+TEST(SnapshotTest, RejectsDamagedInput) {
+  s21::s21_set<int> source{5, 1, 9, 3};
+  std::stringstream stream;
+  source.save(stream);
+  const std::string good = stream.str();
+  s21::s21_set<int> set{42};
+
+  std::string flipped = good;
+  flipped[sizeof(s21::detail::snapshot_header) + 2] ^= 0x10;
+  EXPECT_EQ(ExpectLoadError(flipped, set), "Snapshot: checksum mismatch");
+  EXPECT_EQ(ExpectLoadError(good.substr(0, good.size() - 3), set),
+            "Snapshot: unexpected end of data");
+  EXPECT_EQ(ExpectLoadError("not a snapshot at all, but long enough to be "
+                            "read as a header by the loader ......",
+                            set),
+            "Snapshot: not a snapshot");
+
+  // Испорченный порядок с верной контрольной суммой
+  s21::detail::snapshot_header header = s21::detail::make_snapshot_header(
+      s21::detail::snapshot_kind::set, sizeof(int), 0, 3);
+  std::ostringstream unsorted;
+  s21::detail::snapshot_writer writer(unsorted, header);
+  for (int item : {3, 1, 2}) writer.write(item);
+  writer.finish();
+  EXPECT_EQ(ExpectLoadError(unsorted.str(), set),
+            "Snapshot: elements are not strictly increasing");
+
+  // Повторы недопустимы во множестве, даже если порядок верный
+  std::ostringstream repeated;
+  s21::detail::snapshot_writer repeated_writer(repeated, header);
+  for (int item : {1, 2, 2}) repeated_writer.write(item);
+  repeated_writer.finish();
+  EXPECT_EQ(ExpectLoadError(repeated.str(), set),
+            "Snapshot: elements are not strictly increasing");
+
+  ASSERT_EQ(set.size(), 1u);
+  EXPECT_TRUE(set.contains(42));
+}
+
+// Заголовок входит в контрольную сумму: снимок мультимножества с
+// подменённым видом не читается как множество
+TEST(SnapshotTest, HeaderIsChecksummed) {
+  s21::s21_multiset<int> multiset{1, 1, 2};
+  std::stringstream stream;
+  multiset.save(stream);
+  std::string bytes = stream.str();
+  s21::detail::snapshot_header header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  header.kind = static_cast<std::uint32_t>(s21::detail::snapshot_kind::set);
+  std::memcpy(&bytes[0], &header, sizeof(header));
+
+  s21::s21_set<int> set{7};
+  EXPECT_EQ(ExpectLoadError(bytes, set), "Snapshot: checksum mismatch");
+  ASSERT_EQ(set.size(), 1u);
+  EXPECT_TRUE(set.contains(7));
+  set.insert(1);
+  EXPECT_EQ(set.size(), 2u);
+}
+
+TEST(SnapshotTest, MapViewReadsSavedFile) {
+  char path[] = "/tmp/s21_snapshot_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+
+  s21_map<std::int64_t, std::int32_t> map;
+  for (int i = 0; i < 3000; ++i) map.insert(i * 2, -i);
+  {
+    std::ofstream out(path, std::ios::binary);
+    map.save(out);
+  }
+  {
+    s21::map_view<std::int64_t, std::int32_t> view(path);
+    ASSERT_EQ(view.size(), 3000u);
+    EXPECT_TRUE(view.verify());
+    for (int i = 0; i < 3000; ++i) {
+      ASSERT_NE(view.find(i * 2), nullptr);
+      EXPECT_EQ(*view.find(i * 2), -i);
+      EXPECT_EQ(view.find(i * 2 + 1), nullptr);
+    }
+    EXPECT_EQ(view.at(100), -50);
+    EXPECT_THROW(view.at(7), std::out_of_range);
+    EXPECT_EQ(view.lower_bound(7), 4u);
+    EXPECT_EQ(view.key(4), 8);
+    EXPECT_EQ(view.value(4), -4);
+
+    s21::map_view<std::int64_t, std::int32_t> moved(std::move(view));
+    EXPECT_EQ(moved.size(), 3000u);
+    EXPECT_TRUE(view.empty());
+    EXPECT_FALSE(view.verify());
+  }
+  EXPECT_THROW((s21::map_view<std::int32_t, std::int32_t>(path)),
+               std::runtime_error);
+
+  // Файл с лишним байтом не открывается
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    out.put(0);
+  }
+  EXPECT_THROW((s21::map_view<std::int64_t, std::int32_t>(path)),
+               std::runtime_error);
+  unlink(path);
+}
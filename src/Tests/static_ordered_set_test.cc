@@ -0,0 +1,103 @@
+#include "../Static/static_ordered_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Map/map.h"
+#include "../Set/set.h"
+#include "../Static/static_ordered_map.h"
+
+// Раскладка сверяется с отсортированным массивом при всех размерах до
+// нескольких полных уровней, включая пустой и неполный последний уровень
+TEST(StaticOrderedSetTest, MatchesSortedArray) {
+  for (int n = 0; n <= 70; ++n) {
+    std::vector<int> sorted;
+    for (int i = 0; i < n; ++i) sorted.push_back(2 * i);
+    s21::static_ordered_set<int> set(sorted.rbegin(), sorted.rend());
+    ASSERT_EQ(set.size(), sorted.size());
+    ASSERT_TRUE(std::equal(sorted.begin(), sorted.end(), set.begin(),
+                           set.end()));
+    for (int key = -1; key <= 2 * n; ++key) {
+      auto expected = std::lower_bound(sorted.begin(), sorted.end(), key);
+      auto lower = set.lower_bound(key);
+      if (expected == sorted.end()) {
+        ASSERT_EQ(lower, set.end());
+      } else {
+        ASSERT_EQ(*lower, *expected);
+      }
+      auto upper = std::upper_bound(sorted.begin(), sorted.end(), key);
+      if (upper == sorted.end()) {
+        ASSERT_EQ(set.upper_bound(key), set.end());
+      } else {
+        ASSERT_EQ(*set.upper_bound(key), *upper);
+      }
+      ASSERT_EQ(set.rank(key),
+                static_cast<size_t>(expected - sorted.begin()));
+      ASSERT_EQ(set.contains(key), key % 2 == 0 && key < 2 * n && key >= 0);
+    }
+  }
+}
+
+TEST(StaticOrderedSetTest, DuplicatesAndCustomCompare) {
+  s21::static_ordered_set<std::string, std::greater<std::string>> set = {
+      "b", "a", "c", "b"};
+  EXPECT_EQ(set.size(), 3u);
+  EXPECT_EQ(std::vector<std::string>(set.begin(), set.end()),
+            (std::vector<std::string>{"c", "b", "a"}));
+  EXPECT_EQ(set.rank("a"), 2u);
+  EXPECT_EQ(*set.find("b"), "b");
+  EXPECT_EQ(set.find("z"), set.end());
+}
+
+TEST(StaticOrderedSetTest, FreezeSet) {
+  std::mt19937 gen(47);
+  s21::s21_set<int> source;
+  std::vector<int> values;
+  for (int i = 0; i < 5000; ++i) {
+    int value = static_cast<int>(gen() % 100000);
+    if (!source.contains(value)) {
+      source.insert(value);
+      values.push_back(value);
+    }
+  }
+  std::sort(values.begin(), values.end());
+  s21::static_ordered_set<int> frozen = source.freeze();
+  ASSERT_EQ(frozen.size(), values.size());
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), frozen.begin()));
+  for (int i = 0; i < 2000; ++i) {
+    int key = static_cast<int>(gen() % 100000);
+    ASSERT_EQ(frozen.contains(key), source.contains(key));
+    ASSERT_EQ(frozen.rank(key),
+              static_cast<size_t>(
+                  std::lower_bound(values.begin(), values.end(), key) -
+                  values.begin()));
+  }
+}
+
+TEST(StaticOrderedMapTest, FreezeMap) {
+  s21_map<std::string, int> source;
+  for (int i = 0; i < 100; ++i) source[std::to_string(i)] = i;
+  s21::static_ordered_map<std::string, int> frozen = source.freeze();
+  ASSERT_EQ(frozen.size(), 100u);
+  EXPECT_EQ(frozen.at("42"), 42);
+  EXPECT_THROW(frozen.at("100"), std::out_of_range);
+  EXPECT_FALSE(frozen.contains("100"));
+  EXPECT_EQ(frozen.lower_bound("100")->first, "11");
+  EXPECT_EQ(frozen.rank("2"), 12u);  // "0", "1", "10".."19"
+
+  auto it = frozen.begin();
+  for (auto source_it = source.begin(); source_it != source.end();
+       ++source_it, ++it) {
+    ASSERT_EQ(it->first, source_it->first);
+    ASSERT_EQ(it->second, source_it->second);
+  }
+  EXPECT_EQ(it, frozen.end());
+
+  s21::static_ordered_map<int, char> letters = {{2, 'b'}, {1, 'a'}, {2, 'x'}};
+  EXPECT_EQ(letters.size(), 2u);
+  EXPECT_EQ(letters.at(2), 'b');
+}
@@ -0,0 +1,83 @@
+#include "../WorkStealing/task_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+static long long Fib(s21::task_scheduler& scheduler, int n) {
+  if (n < 15) {
+    long long a = 0, b = 1;
+    for (int i = 0; i < n; ++i) {
+      long long c = a + b;
+      a = b;
+      b = c;
+    }
+    return a;
+  }
+  long long x = 0, y = 0;
+  scheduler.invoke([&] { x = Fib(scheduler, n - 1); },
+                   [&] { y = Fib(scheduler, n - 2); });
+  return x + y;
+}
+
+TEST(TaskSchedulerTest, SubmitAndWaitIdle) {
+  s21::task_scheduler scheduler(4);
+  EXPECT_EQ(scheduler.thread_count(), 4u);
+  std::atomic<int> counter{0};
+  for (int i = 0; i < 5000; ++i) scheduler.submit([&counter] { ++counter; });
+  scheduler.wait_idle();
+  EXPECT_EQ(counter.load(), 5000);
+}
+
+TEST(TaskSchedulerTest, NestedSubmitGoesToWorkerDeque) {
+  s21::task_scheduler scheduler(3);
+  std::atomic<int> counter{0};
+  for (int i = 0; i < 10; ++i) {
+    scheduler.submit([&] {
+      for (int j = 0; j < 100; ++j) scheduler.submit([&counter] { ++counter; });
+    });
+  }
+  scheduler.wait_idle();
+  EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(TaskSchedulerTest, InvokeForkJoin) {
+  s21::task_scheduler scheduler(4);
+  EXPECT_EQ(Fib(scheduler, 25), 75025);
+}
+
+TEST(TaskSchedulerTest, ParallelFor) {
+  s21::task_scheduler scheduler(4);
+  std::vector<int> data(10000, 0);
+  scheduler.parallel_for<size_t>(0, data.size(), 64,
+                                 [&data](size_t i) { data[i] = int(i) * 2; });
+  for (size_t i = 0; i < data.size(); ++i) ASSERT_EQ(data[i], int(i) * 2);
+}
+
+TEST(TaskSchedulerTest, ExceptionsPropagate) {
+  s21::task_scheduler scheduler(2);
+  scheduler.submit([] { throw std::runtime_error("task failed"); });
+  EXPECT_THROW(scheduler.wait_idle(), std::runtime_error);
+  EXPECT_THROW(scheduler.invoke([] {}, [] { throw std::logic_error("x"); }),
+               std::logic_error);
+}
+
+TEST(TaskSchedulerTest, WaitIdleFromTaskThrows) {
+  s21::task_scheduler scheduler(2);
+  std::atomic<bool> rejected{false};
+  scheduler.submit([&] {
+    try {
+      scheduler.wait_idle();
+    } catch (const std::logic_error&) {
+      rejected = true;
+    }
+  });
+  scheduler.wait_idle();
+  EXPECT_TRUE(rejected.load());
+
+  // Непойманная ошибка доходит до внешнего ожидающего потока
+  scheduler.submit([&scheduler] { scheduler.wait_idle(); });
+  EXPECT_THROW(scheduler.wait_idle(), std::logic_error);
+}
@@ -1,9 +1,16 @@
 #include <gtest/gtest.h>
 
 #include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
 #include <random>
+#include <vector>
 
+#include "../BTree/btree.h"
 #include "../Map/map.h"
+#include "../RBTree/CompactRedBlackTree.h"
 #include "../RBTree/RedBlackTree.h"
 
 // Функция для генерации случайного ключа
@@ -255,4 +262,352 @@ TEST(RedBlackTreeTest, RightRotateRoot) {
   tree.insert(7);
 
   EXPECT_TRUE(tree.isRedBlackTree());
-}
\ No newline at end of file
+}
+
+TEST(s21_mapTest, SizeAfterMove) {
+  s21_map<int, std::string> myMap;
+  myMap.insert(1, "one");
+  myMap.insert(2, "two");
+
+  s21_map<int, std::string> movedMap(std::move(myMap));
+  ASSERT_EQ(movedMap.size(), 2u);
+  ASSERT_EQ(myMap.size(), 0u);
+
+  myMap = std::move(movedMap);
+  ASSERT_EQ(myMap.size(), 2u);
+  ASSERT_EQ(movedMap.size(), 0u);
+}
+
+TEST(RedBlackTreeTest, EraseKeepsBalanceUnderChurn) {
+  RedBlackTree<int> tree;
+  std::multiset<int> expected;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(0, 500);
+  for (int step = 0; step < 20000; ++step) {
+    int value = dist(gen);
+    if (step % 3 == 2) {
+      tree.erase(value);
+      auto it = expected.find(value);
+      if (it != expected.end()) expected.erase(it);
+    } else {
+      tree.insert(value);
+      expected.insert(value);
+    }
+    if (step % 1000 == 0) {
+      ASSERT_TRUE(tree.isRedBlackTree());
+    }
+  }
+  ASSERT_TRUE(tree.isRedBlackTree());
+  ASSERT_EQ(tree.size(), expected.size());
+  auto it = tree.cbegin();
+  for (int value : expected) {
+    ASSERT_EQ(*it, value);
+    ++it;
+  }
+}
+
+TEST(RedBlackTreeTest, EraseByIterator) {
+  RedBlackTree<int> tree = {1, 2, 3, 4, 5, 6, 7, 8};
+  auto it = tree.begin();
+  ++it;
+  it = tree.erase(it);
+  EXPECT_EQ(*it, 3);
+
+  auto last = it;
+  ++last;
+  ++last;
+  it = tree.erase(it, last);
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(tree.size(), 5u);
+  EXPECT_FALSE(tree.contains(3));
+  EXPECT_FALSE(tree.contains(4));
+  EXPECT_TRUE(tree.isRedBlackTree());
+
+  tree.erase(tree.begin(), tree.end());
+  EXPECT_TRUE(tree.empty());
+}
+
+TEST(s21_mapTest, EraseNodeWithTwoChildren) {
+  s21_map<int, std::string> myMap;
+  for (int key : {50, 30, 70, 20, 40, 60, 80}) {
+    myMap.insert(key, std::to_string(key));
+  }
+  myMap.erase(30);
+  myMap.erase(50);
+
+  ASSERT_EQ(myMap.size(), 5u);
+  ASSERT_FALSE(myMap.contains(30));
+  ASSERT_FALSE(myMap.contains(50));
+  ASSERT_EQ(myMap.at(20), "20");
+  ASSERT_EQ(myMap.at(40), "40");
+  ASSERT_TRUE(myMap.isRedBlackTree());
+}
+
+TEST(s21_mapTest, ChurnMatchesStdMap) {
+  s21_map<int, int> myMap;
+  std::map<int, int> stdMap;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> dist(0, 300);
+  for (int step = 0; step < 10000; ++step) {
+    int key = dist(gen);
+    if (step % 2) {
+      myMap.erase(key);
+      stdMap.erase(key);
+    } else {
+      myMap[key] = step;
+      stdMap[key] = step;
+    }
+  }
+  ASSERT_EQ(myMap.size(), stdMap.size());
+  ASSERT_TRUE(myMap.isRedBlackTree());
+  auto it = myMap.begin();
+  for (const auto& entry : stdMap) {
+    ASSERT_EQ(it->first, entry.first);
+    ASSERT_EQ(it->second, entry.second);
+    ++it;
+  }
+  ASSERT_EQ(it, myMap.end());
+}
+
+TEST(s21_mapTest, EraseByIterator) {
+  s21_map<int, std::string> myMap;
+  for (int key = 0; key < 10; ++key) myMap.insert(key, std::to_string(key));
+
+  auto it = myMap.begin();
+  it = myMap.erase(it);
+  ASSERT_EQ(it->first, 1);
+
+  auto last = it;
+  for (int i = 0; i < 4; ++i) ++last;
+  it = myMap.erase(it, last);
+  ASSERT_EQ(it->first, 5);
+  ASSERT_EQ(myMap.size(), 5u);
+  ASSERT_TRUE(myMap.isRedBlackTree());
+}
+
+TEST(s21_mapTest, FindReturnsIterator) {
+  s21_map<int, std::string> myMap;
+  myMap.insert(1, "one");
+  myMap.insert(2, "two");
+
+  auto it = myMap.find(2);
+  ASSERT_NE(it, myMap.end());
+  it->second = "deux";
+  ASSERT_EQ(myMap.at(2), "deux");
+  ASSERT_EQ(myMap.find(3), myMap.end());
+
+  const auto& constMap = myMap;
+  ASSERT_EQ(constMap.find(1)->second, "one");
+  ASSERT_EQ(constMap.find(5), constMap.end());
+}
+
+TEST(s21_mapTest, HeterogeneousLookup) {
+  s21_map<std::string, int, std::less<>> myMap;
+  myMap["alpha"] = 1;
+  myMap["beta"] = 2;
+
+  std::string_view key = "beta";
+  ASSERT_TRUE(myMap.contains(key));
+  ASSERT_FALSE(myMap.contains(std::string_view("gamma")));
+  ASSERT_EQ(myMap.find(key)->second, 2);
+  ASSERT_EQ(myMap.find("delta"), myMap.end());
+}
+
+TEST(s21_mapTest, CustomCompare) {
+  s21_map<int, int, std::greater<int>> myMap;
+  for (int key : {3, 1, 4, 1, 5}) myMap.insert(key, key * 10);
+  ASSERT_EQ(myMap.size(), 4u);
+  ASSERT_EQ(myMap.begin()->first, 5);
+  ASSERT_EQ(myMap.at(1), 10);
+}
+
+TEST(s21_mapTest, OrderStatistics) {
+  s21_map<std::string, int, std::less<>, OrderStatistics> myMap;
+  for (int i = 0; i < 26; ++i) myMap.insert(std::string(1, 'a' + i), i);
+
+  ASSERT_EQ(myMap.select(0)->first, "a");
+  ASSERT_EQ(myMap.select(25)->second, 25);
+  ASSERT_EQ(myMap.rank("d"), 3u);
+  ASSERT_EQ(myMap.count_range("c", "h"), 5u);
+  ASSERT_EQ(myMap.count_range("h", "c"), 0u);
+
+  myMap.erase("a");
+  myMap.erase("e");
+  ASSERT_EQ(myMap.select(0)->first, "b");
+  ASSERT_EQ(myMap.count_range("c", "h"), 4u);
+  ASSERT_THROW(myMap.select(24), std::out_of_range);
+}
+
+TEST(s21_mapTest, ConstructFromSortedRange) {
+  std::vector<std::pair<int, std::string>> items;
+  for (int key = 0; key < 100; ++key) {
+    items.emplace_back(key, std::to_string(key));
+  }
+
+  s21_map<int, std::string> myMap(items.begin(), items.end());
+  ASSERT_EQ(myMap.size(), 100u);
+  ASSERT_TRUE(myMap.isRedBlackTree());
+  ASSERT_EQ(myMap.at(42), "42");
+
+  myMap.assign_sorted(items.begin(), items.begin() + 10);
+  ASSERT_EQ(myMap.size(), 10u);
+  ASSERT_FALSE(myMap.contains(42));
+}
+
+TEST(s21_mapTest, ConstructFromUnsortedRangeKeepsFirst) {
+  s21_map<int, std::string> myMap = {{3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}};
+  ASSERT_EQ(myMap.size(), 3u);
+  ASSERT_EQ(myMap.at(3), "c");
+  ASSERT_EQ(myMap.begin()->first, 1);
+}
+
+TEST(s21_mapTest, TimeWindowQueries) {
+  s21_map<int, std::string> events;
+  for (int time = 0; time < 100; time += 10) {
+    events.insert(time, "event" + std::to_string(time));
+  }
+
+  ASSERT_EQ(events.lower_bound(35)->first, 40);
+  ASSERT_EQ(events.upper_bound(40)->first, 50);
+  ASSERT_EQ(events.lower_bound(95), events.end());
+  auto range = events.equal_range(50);
+  ASSERT_EQ(range.first->first, 50);
+  ASSERT_EQ(range.second->first, 60);
+
+  // Окно [20, 50) можно изменять на месте
+  events.for_each_in_range(20, 50, [](std::pair<const int, std::string>& item) {
+    item.second += "!";
+  });
+  ASSERT_EQ(events.at(20), "event20!");
+  ASSERT_EQ(events.at(40), "event40!");
+  ASSERT_EQ(events.at(50), "event50");
+
+  const auto& constEvents = events;
+  ASSERT_EQ(constEvents.lower_bound(41)->first, 50);
+  std::vector<int> times;
+  constEvents.for_each_in_range(
+      0, 30, [&times](const std::pair<const int, std::string>& item) {
+        times.push_back(item.first);
+      });
+  ASSERT_EQ(times, (std::vector<int>{0, 10, 20}));
+
+  // Итератор map проходит все элементы по порядку
+  int expected = 0;
+  for (auto it = events.begin(); it != events.end(); ++it, expected += 10) {
+    ASSERT_EQ(it->first, expected);
+  }
+  ASSERT_EQ(expected, 100);
+}
+
+TEST(s21_mapTest, HintedAppendOfTimestamps) {
+  s21_map<int, std::string> series;
+  auto last = series.end();
+  for (int time = 0; time < 500; ++time) {
+    last = series.insert(series.end(), {time, std::to_string(time)});
+  }
+  ASSERT_TRUE(series.isRedBlackTree());
+  ASSERT_EQ(series.size(), 500u);
+
+  // Существующий ключ не перезаписывается
+  last = series.insert(last, {499, "again"});
+  ASSERT_EQ(last->second, "499");
+
+  auto it = series.find(series.begin(), 10);
+  for (int time = 11; time < 500; time += 7) {
+    it = series.find(it, time);
+    ASSERT_EQ(it->first, time);
+  }
+  ASSERT_EQ(series.find(it, 1000), series.end());
+}
+
+// Перенос пар между уровнями хранения: узел переходит вместе со значением
+TEST(s21_mapTest, ExtractInsertAndMerge) {
+  s21_map<int, std::string> hot = {{1, "a"}, {2, "b"}, {3, "c"}};
+  s21_map<int, std::string> cold = {{3, "old"}, {10, "j"}};
+
+  auto node = hot.extract(2);
+  ASSERT_EQ(node.value().first, 2);
+  const std::string* address = &node.value().second;
+  node.value().second = "moved";
+  auto result = cold.insert(std::move(node));
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(&cold.at(2), address);
+  ASSERT_EQ(cold.at(2), "moved");
+
+  // Ключ уже есть: пара остаётся в handle
+  node = hot.extract(hot.find(3));
+  result = cold.insert(std::move(node));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->second, "old");
+  ASSERT_FALSE(node.empty());
+  ASSERT_EQ(node.value().second, "c");
+  ASSERT_TRUE(hot.insert(std::move(node)).second);
+
+  hot.merge(cold);
+  ASSERT_EQ(hot.size(), 4u);
+  ASSERT_EQ(hot.at(2), "moved");
+  ASSERT_EQ(hot.at(3), "c");
+  ASSERT_EQ(cold.size(), 1u);
+  ASSERT_EQ(cold.at(3), "old");
+  ASSERT_TRUE(hot.isRedBlackTree());
+  ASSERT_TRUE(hot.extract(42).empty());
+}
+
+TEST(s21_mapTest, BTreeBackend) {
+  s21_map<std::string, int, std::less<std::string>, NoAugmentation,
+          BTreeBackend<>>
+      map;
+  for (int i = 0; i < 300; ++i) map[std::to_string(i)] = i;
+  ASSERT_EQ(map.size(), 300u);
+  ASSERT_EQ(map.at("42"), 42);
+  ASSERT_FALSE(map.insert("42", 0).second);
+  map.erase("42");
+  ASSERT_FALSE(map.contains("42"));
+  ASSERT_EQ(map.lower_bound("42")->first, "43");
+
+  int sum = 0;
+  map.for_each_in_range("10", "11", [&sum](auto& item) { sum += item.second; });
+  ASSERT_EQ(sum, 10 + 100 + 101 + 102 + 103 + 104 + 105 + 106 + 107 + 108 +
+                     109);
+}
+
+TEST(s21_mapTest, CompactBackend) {
+  typedef s21_map<std::string, int, std::less<std::string>, NoAugmentation,
+                  CompactRedBlackTreeBackend>
+      CompactMap;
+  CompactMap map;
+  for (int i = 0; i < 300; ++i) map[std::to_string(i)] = i;
+  ASSERT_EQ(map.size(), 300u);
+  ASSERT_TRUE(map.isRedBlackTree());
+  ASSERT_EQ(map.at("42"), 42);
+  ASSERT_FALSE(map.insert("42", 0).second);
+  map.erase("42");
+  ASSERT_FALSE(map.contains("42"));
+  ASSERT_EQ(map.lower_bound("42")->first, "43");
+
+  CompactMap copy(map);
+  map["7"] = -7;
+  ASSERT_EQ(copy.at("7"), 7);
+  ASSERT_EQ(map.at("7"), -7);
+  ASSERT_TRUE(copy.isRedBlackTree());
+}
+
+TEST(s21_mapTest, ContainsAndFindBatch) {
+  s21_map<std::string, int> map;
+  for (int i = 0; i < 500; i += 2) map[std::to_string(i)] = i;
+  std::vector<std::string> keys;
+  for (int i = 0; i < 100; ++i) keys.push_back(std::to_string(i * 7 % 503));
+  std::unique_ptr<bool[]> hits(new bool[keys.size()]);
+  map.contains_batch(keys.data(), keys.size(), hits.get());
+  std::vector<s21_map<std::string, int>::iterator> found(keys.size());
+  auto last = map.find_batch(keys.data(), keys.size(), found.begin());
+  ASSERT_TRUE(last == found.end());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(hits[i], map.contains(keys[i]));
+    if (hits[i]) {
+      ASSERT_EQ(found[i]->second, std::stoi(keys[i]));
+    } else {
+      ASSERT_TRUE(found[i] == map.end());
+    }
+  }
+}
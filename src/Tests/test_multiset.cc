@@ -146,4 +146,56 @@ TEST(RedBlackTreeTest, LeftRotationAndColorChange) {
   EXPECT_TRUE(tree.contains(10));
   EXPECT_TRUE(tree.contains(20));
   EXPECT_TRUE(tree.contains(30));
-}
\ No newline at end of file
+}
+
+TEST(s21_multisetTest, OrderStatisticsCountDuplicates) {
+  s21::s21_multiset<int, std::less<int>, OrderStatistics> multiset;
+  for (int value : {5, 1, 5, 3, 5, 9}) multiset.insert(value);
+
+  EXPECT_EQ(multiset.rank(5), 2u);
+  EXPECT_EQ(multiset.count_range(5, 6), 3u);
+  EXPECT_EQ(*multiset.select(4), 5);
+  EXPECT_EQ(*multiset.select(5), 9);
+}
+
+TEST(s21_multisetTest, SetAlgebraCountsMultiplicity) {
+  s21::s21_multiset<int> multiset = {1, 1, 1, 2, 3, 3};
+  multiset.set_intersection(s21::s21_multiset<int>{1, 1, 3, 4});
+  EXPECT_EQ(multiset, (s21::s21_multiset<int>{1, 1, 3}));
+
+  multiset.set_union(s21::s21_multiset<int>{1, 1, 1, 5});
+  EXPECT_EQ(multiset, (s21::s21_multiset<int>{1, 1, 1, 3, 5}));
+
+  multiset.set_difference(s21::s21_multiset<int>{1, 5});
+  EXPECT_EQ(multiset, (s21::s21_multiset<int>{1, 1, 3}));
+}
+
+TEST(s21_multisetTest, EqualRangeCoversDuplicates) {
+  s21::s21_multiset<int> multiset = {4, 2, 4, 4, 8};
+  auto range = multiset.equal_range(4);
+  int count = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    EXPECT_EQ(*it, 4);
+    ++count;
+  }
+  EXPECT_EQ(count, 3);
+  EXPECT_EQ(*multiset.lower_bound(3), 4);
+  EXPECT_EQ(*multiset.upper_bound(4), 8);
+
+  int visited = 0;
+  multiset.for_each_in_range(2, 5, [&visited](const int&) { ++visited; });
+  EXPECT_EQ(visited, 4);
+}
+
+TEST(s21_multisetTest, ExtractAndMerge) {
+  s21::s21_multiset<int> hot = {1, 4, 4, 6}, cold = {4, 9};
+  auto node = hot.extract(4);
+  ASSERT_EQ(node.value(), 4);
+  ASSERT_EQ(*cold.insert(std::move(node)), 4);
+  ASSERT_EQ(hot.size(), 3u);
+
+  hot.merge(cold);
+  EXPECT_TRUE(cold.empty());
+  EXPECT_EQ(hot, (s21::s21_multiset<int>{1, 4, 4, 4, 6, 9}));
+  EXPECT_TRUE(hot.extract(5).empty());
+}
@@ -1,10 +1,22 @@
 #include <gtest/gtest.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <random>
 #include <set>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "../BTree/btree.h"
+#include "../RBTree/CompactRedBlackTree.h"
 #include "../RBTree/RedBlackTree.h"
 #include "../Set/set.h"
+#include "../WorkStealing/task_scheduler.h"
 
 // Генератор случайных чисел
 std::mt19937 rng(std::random_device{}());
@@ -308,3 +320,827 @@ TEST(RedBlackTreeTest, Find) {
   EXPECT_THROW(tree.find(1), std::runtime_error);
   EXPECT_THROW(tree.find(0), std::runtime_error);
 }
+
+// Копия дерева не должна делить узлы с оригиналом
+TEST(RedBlackTreeTest, CopyIsDeep) {
+  RedBlackTree<int> tree = {5, 3, 8};
+  RedBlackTree<int> copy(tree);
+  copy.insert(10);
+  tree.erase(3);
+
+  EXPECT_TRUE(copy.contains(3));
+  EXPECT_FALSE(tree.contains(10));
+  EXPECT_TRUE(copy.isRedBlackTree());
+
+  RedBlackTree<int> assigned;
+  assigned = copy;
+  EXPECT_EQ(assigned, copy);
+  EXPECT_FALSE(assigned == tree);
+}
+
+namespace {
+
+// Бросает при копировании, когда счётчик доходит до нуля
+struct ThrowingCopy {
+  static int copies_left;
+  int value;
+  std::string payload;  // нетривиальный деструктор: утечку увидит ASan
+
+  explicit ThrowingCopy(int value)
+      : value(value), payload(64, static_cast<char>('a' + value % 26)) {}
+  ThrowingCopy(const ThrowingCopy& other)
+      : value(other.value), payload(other.payload) {
+    if (copies_left-- == 0) throw std::runtime_error("copy failed");
+  }
+  bool operator<(const ThrowingCopy& other) const {
+    return value < other.value;
+  }
+};
+int ThrowingCopy::copies_left = -1;
+
+}  // namespace
+
+// Копия повторяет форму и дополнение оригинала, а исключение из
+// конструктора элемента не оставляет утечек
+TEST(RedBlackTreeTest, CopyClonesShape) {
+  RedBlackTree<int, std::less<int>, OrderStatistics> tree;
+  for (int i = 0; i < 1000; ++i) tree.insert((i * 37) % 1000);
+  for (int i = 0; i < 1000; i += 3) tree.erase(i);
+  RedBlackTree<int, std::less<int>, OrderStatistics> copy(tree);
+  ASSERT_EQ(copy.size(), tree.size());
+  EXPECT_TRUE(copy.isRedBlackTree());
+  EXPECT_EQ(copy, tree);
+  for (size_t k = 0; k < copy.size(); k += 17) {
+    EXPECT_EQ(*copy.select(k), *tree.select(k));
+  }
+  EXPECT_EQ(copy.rank(500), tree.rank(500));
+  copy.insert(2000);
+  EXPECT_EQ(*copy.select(copy.size() - 1), 2000);
+  EXPECT_EQ(*copy.begin(), *tree.begin());
+
+  RedBlackTree<int, std::less<int>, OrderStatistics> empty, empty_copy(empty);
+  EXPECT_TRUE(empty_copy.empty());
+  EXPECT_EQ(empty_copy.begin(), empty_copy.end());
+
+  RedBlackTree<ThrowingCopy> source;
+  for (int i = 0; i < 100; ++i) source.insert(ThrowingCopy(i));
+  ThrowingCopy::copies_left = 60;
+  EXPECT_THROW(RedBlackTree<ThrowingCopy> failed(source), std::runtime_error);
+  ThrowingCopy::copies_left = -1;
+}
+
+// Перемещение забирает узлы вместе с ареной
+TEST(RedBlackTreeTest, MoveTransfersNodes) {
+  RedBlackTree<std::string> tree = {"b", "a", "c"};
+  RedBlackTree<std::string> moved(std::move(tree));
+  EXPECT_TRUE(tree.empty());
+  EXPECT_TRUE(moved.contains("a"));
+
+  RedBlackTree<std::string> assigned;
+  assigned.insert("z");
+  assigned = std::move(moved);
+  EXPECT_TRUE(moved.empty());
+  EXPECT_FALSE(assigned.contains("z"));
+  EXPECT_EQ(assigned.GetMin(), "a");
+}
+
+// Очистка и повторное использование дерева с нетривиальными данными
+TEST(RedBlackTreeTest, ClearAndReuse) {
+  RedBlackTree<std::string> tree;
+  for (int i = 0; i < 1000; ++i) tree.insert(std::to_string(i));
+  for (int i = 0; i < 1000; i += 2) tree.erase(std::to_string(i));
+  EXPECT_TRUE(tree.contains("999"));
+  EXPECT_FALSE(tree.contains("998"));
+
+  tree.clear();
+  EXPECT_TRUE(tree.empty());
+  tree.insert("again");
+  EXPECT_EQ(tree.GetMax(), "again");
+}
+
+// Размер поддерживается при вставке, удалении, очистке и обмене
+TEST(RedBlackTreeTest, SizeIsTracked) {
+  RedBlackTree<int> tree = {4, 2, 6, 1, 3};
+  EXPECT_EQ(tree.size(), 5u);
+  tree.erase(2);
+  tree.erase(42);
+  EXPECT_EQ(tree.size(), 4u);
+
+  RedBlackTree<int> other = {7};
+  tree.swap(other);
+  EXPECT_EQ(tree.size(), 1u);
+  EXPECT_EQ(other.size(), 4u);
+
+  RedBlackTree<int> moved(std::move(other));
+  EXPECT_EQ(moved.size(), 4u);
+  EXPECT_EQ(other.size(), 0u);
+
+  moved.clear();
+  EXPECT_EQ(moved.size(), 0u);
+}
+
+// Прозрачный компаратор: поиск по string_view и const char* без временной
+// std::string
+TEST(RedBlackTreeTest, TransparentLookup) {
+  RedBlackTree<std::string, std::less<>> tree;
+  for (const char* word : {"pear", "apple", "plum", "fig"}) tree.insert(word);
+
+  std::string_view probe = "plum";
+  EXPECT_TRUE(tree.contains(probe));
+  EXPECT_TRUE(tree.contains("fig"));
+  EXPECT_FALSE(tree.contains(std::string_view("grape")));
+  EXPECT_EQ(*tree.lookup(probe), "plum");
+  EXPECT_EQ(tree.lookup("kiwi"), tree.end());
+}
+
+// Пользовательский порядок и вставка без дубликатов
+TEST(RedBlackTreeTest, CustomCompareAndInsertUnique) {
+  RedBlackTree<int, std::greater<int>> tree;
+  for (int value : {5, 1, 9, 5, 3, 9, 9}) tree.insertUnique(value);
+  EXPECT_EQ(tree.size(), 4u);
+  EXPECT_TRUE(tree.isRedBlackTree());
+
+  auto duplicate = tree.insertUnique(3);
+  EXPECT_FALSE(duplicate.second);
+  EXPECT_EQ(*duplicate.first, 3);
+
+  int expected[] = {9, 5, 3, 1};
+  int i = 0;
+  for (auto it = tree.begin(); it != tree.end(); ++it) {
+    EXPECT_EQ(*it, expected[i++]);
+  }
+}
+
+// Размеры поддеревьев остаются верными после вставок, удалений и поворотов:
+// сверяем select/rank/count_range с отсортированным std::multiset
+TEST(RedBlackTreeTest, OrderStatisticsUnderChurn) {
+  std::mt19937 gen(35);
+  std::uniform_int_distribution<int> dist(0, 199);
+  RedBlackTree<int, std::less<int>, OrderStatistics> tree;
+  std::multiset<int> reference;
+  for (int step = 0; step < 3000; ++step) {
+    int value = dist(gen);
+    if (step % 3 == 2) {
+      tree.erase(value);
+      auto it = reference.find(value);
+      if (it != reference.end()) reference.erase(it);
+    } else {
+      tree.insert(value);
+      reference.insert(value);
+    }
+  }
+  ASSERT_EQ(tree.size(), reference.size());
+  ASSERT_TRUE(tree.isRedBlackTree());
+
+  size_t k = 0;
+  for (int value : reference) {
+    ASSERT_EQ(*tree.select(k), value);
+    ++k;
+  }
+  for (int probe = -1; probe <= 200; ++probe) {
+    auto first = reference.lower_bound(probe);
+    ASSERT_EQ(tree.rank(probe),
+              static_cast<size_t>(std::distance(reference.begin(), first)));
+    auto last = reference.lower_bound(probe + 10);
+    ASSERT_EQ(tree.count_range(probe, probe + 10),
+              static_cast<size_t>(std::distance(first, last)));
+  }
+  EXPECT_EQ(tree.count_range(50, 10), 0u);
+  EXPECT_THROW(tree.select(tree.size()), std::out_of_range);
+}
+
+TEST(s21_setTest, OrderStatistics) {
+  s21::s21_set<int, std::less<int>, OrderStatistics> set;
+  for (int value = 1; value <= 100; ++value) set.insert(value * 10);
+
+  // p99 без обхода от begin()
+  EXPECT_EQ(*set.select(set.size() * 99 / 100), 1000);
+  EXPECT_EQ(*set.select(0), 10);
+  EXPECT_EQ(set.rank(505), 50u);
+  EXPECT_EQ(set.count_range(100, 200), 10u);
+  set.erase(150);
+  EXPECT_EQ(set.count_range(100, 200), 9u);
+}
+
+// Сборка из упорядоченной последовательности даёт корректное красно-чёрное
+// дерево при любом числе элементов
+TEST(RedBlackTreeTest, FromSortedIsBalanced) {
+  for (int n = 0; n <= 130; ++n) {
+    std::vector<int> values(n);
+    for (int i = 0; i < n; ++i) values[i] = i / 2;
+    auto tree = RedBlackTree<int, std::less<int>, OrderStatistics>::from_sorted(
+        values.begin(), values.end());
+    ASSERT_EQ(tree.size(), static_cast<size_t>(n));
+    if (n > 0) {
+      ASSERT_TRUE(tree.isRedBlackTree());
+      ASSERT_EQ(*tree.select(n - 1), values.back());
+    }
+    int i = 0;
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it) {
+      ASSERT_EQ(*it, values[i++]);
+    }
+  }
+}
+
+// Собранное дерево продолжает нормально работать на вставках и удалениях
+TEST(RedBlackTreeTest, AssignSortedThenModify) {
+  RedBlackTree<int> tree = {7, 8, 9};
+  std::vector<int> values;
+  for (int i = 0; i < 1000; i += 2) values.push_back(i);
+  tree.assign_sorted(values.begin(), values.end());
+  ASSERT_EQ(tree.size(), values.size());
+  ASSERT_FALSE(tree.contains(7));
+
+  for (int i = 1; i < 1000; i += 4) tree.insert(i);
+  for (int i = 0; i < 1000; i += 8) tree.erase(i);
+  ASSERT_TRUE(tree.isRedBlackTree());
+  ASSERT_EQ(tree.size(), 500u - 125u + 250u);
+}
+
+// Неупорядоченный диапазон тоже принимается - вставками по одному
+TEST(RedBlackTreeTest, RangeConstructorUnsortedFallback) {
+  std::vector<int> values = {5, 3, 9, 1, 3};
+  RedBlackTree<int> tree(values.begin(), values.end());
+  ASSERT_TRUE(tree.isRedBlackTree());
+  ASSERT_EQ(tree.size(), 5u);
+  ASSERT_EQ(tree.GetMin(), 1);
+  ASSERT_EQ(tree.GetMax(), 9);
+}
+
+namespace {
+
+typedef RedBlackTree<int, std::less<int>, OrderStatistics> CountedTree;
+
+std::vector<int> randomValues(std::mt19937& gen, int count, int range) {
+  std::uniform_int_distribution<int> dist(0, range);
+  std::vector<int> values(count);
+  for (int& value : values) value = dist(gen);
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+// Проверяет дерево целиком: инварианты, размер, порядок и размеры
+// поддеревьев (через select)
+void expectTreeEquals(const CountedTree& tree,
+                      const std::vector<int>& expected) {
+  ASSERT_EQ(tree.size(), expected.size());
+  if (!expected.empty()) {
+    ASSERT_TRUE(tree.isRedBlackTree());
+  }
+  auto it = tree.cbegin();
+  for (size_t i = 0; i < expected.size(); ++i, ++it) {
+    ASSERT_EQ(*it, expected[i]);
+    ASSERT_EQ(*tree.select(i), expected[i]);
+  }
+}
+
+}  // namespace
+
+// Объединение, пересечение и разность совпадают с std::set_* и для
+// повторяющихся элементов, в том числе на деревьях очень разного размера
+TEST(RedBlackTreeTest, SetAlgebraMatchesStd) {
+  std::mt19937 gen(37);
+  const int sizes[][2] = {{0, 10}, {10, 0}, {7, 3000}, {3000, 7}, {800, 900}};
+  for (const auto& size : sizes) {
+    std::vector<int> a = randomValues(gen, size[0], 2000);
+    std::vector<int> b = randomValues(gen, size[1], 2000);
+    std::vector<int> expected;
+
+    CountedTree tree(a.begin(), a.end());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected));
+    tree.set_union(CountedTree(b.begin(), b.end()));
+    expectTreeEquals(tree, expected);
+
+    expected.clear();
+    tree = CountedTree(a.begin(), a.end());
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected));
+    tree.set_intersection(CountedTree(b.begin(), b.end()));
+    expectTreeEquals(tree, expected);
+
+    expected.clear();
+    tree = CountedTree(a.begin(), a.end());
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected));
+    tree.set_difference(CountedTree(b.begin(), b.end()));
+    expectTreeEquals(tree, expected);
+
+    // После операций дерево остаётся обычным деревом
+    for (int value = 0; value < 2000; value += 7) tree.insert(value);
+    for (int value = 0; value < 2000; value += 3) tree.erase(value);
+    if (!tree.empty()) {
+      ASSERT_TRUE(tree.isRedBlackTree());
+    }
+  }
+}
+
+TEST(RedBlackTreeTest, ParallelUnionWithScheduler) {
+  std::vector<int> evens, triples, expected;
+  for (int value = 0; value < 200000; value += 2) evens.push_back(value);
+  for (int value = 0; value < 200000; value += 3) triples.push_back(value);
+  std::set_union(evens.begin(), evens.end(), triples.begin(), triples.end(),
+                 std::back_inserter(expected));
+
+  s21::task_scheduler scheduler(4);
+  CountedTree tree(evens.begin(), evens.end());
+  tree.set_union(CountedTree(triples.begin(), triples.end()), scheduler);
+  expectTreeEquals(tree, expected);
+
+  expected.clear();
+  std::set_difference(evens.begin(), evens.end(), triples.begin(),
+                      triples.end(), std::back_inserter(expected));
+  tree = CountedTree(evens.begin(), evens.end());
+  tree.set_difference(CountedTree(triples.begin(), triples.end()), scheduler);
+  expectTreeEquals(tree, expected);
+}
+
+TEST(RedBlackTreeTest, SplitAndJoin) {
+  std::vector<int> values;
+  for (int value = 0; value < 1000; ++value) values.push_back(value / 3);
+  for (int key : {-1, 0, 17, 150, 333, 400}) {
+    RedBlackTree<int> tree(values.begin(), values.end());
+    RedBlackTree<int> upper = tree.split(key);
+    size_t below = std::lower_bound(values.begin(), values.end(), key) -
+                   values.begin();
+    ASSERT_EQ(tree.size(), below);
+    ASSERT_EQ(upper.size(), values.size() - below);
+    if (!tree.empty()) {
+      ASSERT_TRUE(tree.isRedBlackTree());
+      ASSERT_LT(tree.GetMax(), key);
+    }
+    if (!upper.empty()) {
+      ASSERT_TRUE(upper.isRedBlackTree());
+      ASSERT_GE(upper.GetMin(), key);
+    }
+
+    tree.join(std::move(upper));
+    ASSERT_EQ(tree.size(), values.size());
+    ASSERT_TRUE(tree.isRedBlackTree());
+    size_t i = 0;
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it) {
+      ASSERT_EQ(*it, values[i++]);
+    }
+  }
+
+  RedBlackTree<int> low = {1, 5}, high = {3, 9};
+  EXPECT_THROW(low.join(std::move(high)), std::invalid_argument);
+}
+
+TEST(s21_setTest, SetAlgebra) {
+  s21::s21_set<int> acl = {1, 3, 5, 7};
+  acl.set_union(s21::s21_set<int>{2, 3, 4});
+  EXPECT_EQ(acl, (s21::s21_set<int>{1, 2, 3, 4, 5, 7}));
+
+  acl.set_difference(s21::s21_set<int>{1, 7});
+  EXPECT_EQ(acl, (s21::s21_set<int>{2, 3, 4, 5}));
+
+  s21::s21_set<int> upper = acl.split(4);
+  EXPECT_EQ(acl, (s21::s21_set<int>{2, 3}));
+  EXPECT_EQ(upper, (s21::s21_set<int>{4, 5}));
+
+  acl.join(std::move(upper));
+  acl.set_intersection(s21::s21_set<int>{3, 4, 9});
+  EXPECT_EQ(acl, (s21::s21_set<int>{3, 4}));
+}
+
+// Границы и обход диапазона сверяются с std::multiset на всех ключах
+TEST(RedBlackTreeTest, BoundsAndRangeScan) {
+  std::mt19937 gen(38);
+  std::vector<int> values = randomValues(gen, 500, 300);
+  RedBlackTree<int> tree;
+  for (int value : values) tree.insert(value);
+  std::multiset<int> reference(values.begin(), values.end());
+
+  for (int key = -1; key <= 301; ++key) {
+    auto lower = tree.lower_bound(key);
+    auto expectedLower = reference.lower_bound(key);
+    if (expectedLower == reference.end()) {
+      ASSERT_EQ(lower, tree.end());
+    } else {
+      ASSERT_EQ(*lower, *expectedLower);
+    }
+    auto range = tree.equal_range(key);
+    size_t equal = 0;
+    for (auto it = range.first; it != range.second; ++it, ++equal) {
+      ASSERT_EQ(*it, key);
+    }
+    ASSERT_EQ(equal, reference.count(key));
+
+    std::vector<int> scanned;
+    tree.for_each_in_range(key, key + 25,
+                           [&scanned](int value) { scanned.push_back(value); });
+    std::vector<int> expected(expectedLower, reference.lower_bound(key + 25));
+    ASSERT_EQ(scanned, expected);
+  }
+}
+
+TEST(s21_setTest, BoundsAndRangeScan) {
+  s21::s21_set<int> set = {10, 20, 30, 40};
+  EXPECT_EQ(*set.lower_bound(20), 20);
+  EXPECT_EQ(*set.upper_bound(20), 30);
+  EXPECT_EQ(set.upper_bound(40), set.end());
+
+  auto range = set.equal_range(25);
+  EXPECT_EQ(range.first, range.second);
+  EXPECT_EQ(*range.first, 30);
+
+  int sum = 0;
+  set.for_each_in_range(15, 40, [&sum](const int& value) { sum += value; });
+  EXPECT_EQ(sum, 50);
+}
+
+// Вставка с подсказкой при любом положении hint даёт то же дерево, что и
+// обычная вставка, а поиск от подсказки - тот же узел, что и от корня
+TEST(RedBlackTreeTest, HintedInsertAndFind) {
+  std::mt19937 gen(39);
+  std::uniform_int_distribution<int> dist(0, 300);
+  CountedTree tree;
+  std::multiset<int> reference;
+  CountedTree::iterator last = tree.end();
+  for (int step = 0; step < 3000; ++step) {
+    int value = dist(gen);
+    CountedTree::iterator hint;
+    switch (step % 3) {
+      case 0:
+        hint = tree.end();
+        break;
+      case 1:
+        hint = last;
+        break;
+      default:
+        hint = tree.lower_bound(value - 5);
+    }
+    last = tree.insert(hint, value);
+    reference.insert(value);
+    ASSERT_EQ(*last, value);
+    if (step % 5 == 4) {
+      // Удаления задевают и крайние узлы, которые дерево кеширует
+      CountedTree::iterator victim = tree.lower_bound(dist(gen));
+      if (victim == tree.end()) victim = tree.begin();
+      reference.erase(reference.find(*victim));
+      tree.erase(victim);
+      last = tree.end();
+    }
+  }
+  expectTreeEquals(tree, std::vector<int>(reference.begin(), reference.end()));
+  ASSERT_EQ(*tree.begin(), tree.GetMin());
+
+  for (int key = -1; key <= 301; ++key) {
+    for (CountedTree::iterator hint :
+         {tree.begin(), tree.end(), tree.lower_bound(key),
+          tree.lower_bound(key - 40), tree.upper_bound(key + 40)}) {
+      ASSERT_EQ(tree.lookup(hint, key), tree.lookup(key));
+    }
+  }
+}
+
+// Данные почти по возрастанию: каждый элемент ложится рядом с подсказкой
+TEST(RedBlackTreeTest, HintedInsertUniqueAppends) {
+  RedBlackTree<int> tree;
+  for (int value = 0; value < 1000; ++value) {
+    // Каждый десятый элемент приходит с опозданием на одну позицию
+    int key = value % 10 == 9 ? value - 1 : value % 10 == 8 ? value + 1
+                                                             : value;
+    auto result = tree.insertUnique(tree.end(), key);
+    ASSERT_TRUE(result.second);
+    ASSERT_EQ(*result.first, key);
+  }
+  ASSERT_TRUE(tree.isRedBlackTree());
+  ASSERT_EQ(tree.size(), 1000u);
+  auto duplicate = tree.insertUnique(tree.lookup(500), 500);
+  ASSERT_FALSE(duplicate.second);
+  ASSERT_EQ(duplicate.first, tree.lookup(500));
+  duplicate = tree.insertUnique(tree.end(), 10);
+  ASSERT_FALSE(duplicate.second);
+  ASSERT_EQ(tree.size(), 1000u);
+
+  int expected = 0;
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it, ++expected) {
+    ASSERT_EQ(*it, expected);
+  }
+}
+
+TEST(s21_setTest, HintedInsertAndFind) {
+  s21::s21_set<int> set;
+  auto last = set.end();
+  for (int value = 0; value < 100; value += 2) last = set.insert(last, value);
+  last = set.insert(set.end(), 99);
+  ASSERT_EQ(*last, 99);
+  ASSERT_EQ(*set.insert(last, 98), 98);
+  ASSERT_EQ(set.size(), 51u);
+
+  auto near = set.find(set.begin(), 96);
+  ASSERT_EQ(*near, 96);
+  ASSERT_EQ(*set.find(near, 98), 98);
+  ASSERT_EQ(set.find(near, 97), set.end());
+}
+
+// Вставка перевешивает узел из handle по тому же адресу, а сам handle
+// переживает дерево, из которого его вынули
+TEST(RedBlackTreeTest, NodeHandlesRelinkWithoutCopy) {
+  CountedTree target;
+  const int* address;
+  {
+    CountedTree source = {1, 2, 3, 4, 5};
+    CountedTree::node_type handle = source.extract(3);
+    ASSERT_FALSE(handle.empty());
+    address = &handle.value();
+    ASSERT_EQ(handle.value(), 3);
+    ASSERT_EQ(source.size(), 4u);
+    ASSERT_FALSE(source.contains(3));
+    expectTreeEquals(source, {1, 2, 4, 5});
+    target.insert(std::move(handle));
+    ASSERT_TRUE(handle.empty());
+    ASSERT_TRUE(source.extract(42).empty());
+  }
+  ASSERT_EQ(&*target.lookup(3), address);
+  expectTreeEquals(target, {3});
+
+  CountedTree::node_type orphan;
+  {
+    CountedTree source = {7, 8};
+    orphan = source.extract(source.begin());
+  }
+  ASSERT_EQ(orphan.value(), 7);
+  target.insert(std::move(orphan));
+  auto duplicate = target.insertUnique(target.extract(target.lookup(7)));
+  ASSERT_TRUE(duplicate.second);
+  expectTreeEquals(target, {3, 7});
+
+  // Случайные переносы в обе стороны сохраняют оба дерева корректными
+  std::mt19937 gen(40);
+  std::vector<int> values = randomValues(gen, 2000, 500);
+  CountedTree hot(values.begin(), values.end()), cold;
+  std::multiset<int> hotReference(values.begin(), values.end()), coldReference;
+  std::uniform_int_distribution<int> dist(0, 500);
+  for (int step = 0; step < 4000; ++step) {
+    bool toCold = step % 3 != 2;
+    CountedTree& from = toCold ? hot : cold;
+    CountedTree& to = toCold ? cold : hot;
+    std::multiset<int>& fromReference = toCold ? hotReference : coldReference;
+    std::multiset<int>& toReference = toCold ? coldReference : hotReference;
+    CountedTree::node_type handle = from.extract(dist(gen));
+    if (handle.empty()) continue;
+    fromReference.erase(fromReference.find(handle.value()));
+    toReference.insert(handle.value());
+    to.insert(std::move(handle));
+  }
+  expectTreeEquals(hot, {hotReference.begin(), hotReference.end()});
+  expectTreeEquals(cold, {coldReference.begin(), coldReference.end()});
+
+  hot.merge(cold);
+  ASSERT_TRUE(cold.empty());
+  expectTreeEquals(hot, values);
+}
+
+#if defined(__GLIBC__)
+// Вынутый узел не держит блок арены исходного дерева: большие временные
+// деревья освобождаются целиком, даже если их узлы живут дальше
+TEST(RedBlackTreeTest, ExtractedNodeReleasesArenaBlock) {
+  auto heapInUse = [] {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+  };
+  std::vector<CountedTree::node_type> handles;
+  handles.reserve(200);
+  CountedTree target;
+  size_t before = heapInUse();
+  for (int round = 0; round < 200; ++round) {
+    CountedTree temporary;
+    for (int value = 0; value < 8000; ++value) {
+      temporary.insert(temporary.end(), value);
+    }
+    // Последний узел лежит в самом большом блоке арены
+    handles.push_back(temporary.extract(7999));
+  }
+  for (int round = 0; round < 100; ++round) {
+    target.insert(std::move(handles[round]));
+  }
+  // Без освобождения блоков здесь были бы десятки мегабайт
+  EXPECT_LT(heapInUse() - before, size_t{1} << 20);
+  EXPECT_EQ(target.size(), 100u);
+  EXPECT_EQ(handles.back().value(), 7999);
+}
+#endif
+
+TEST(RedBlackTreeTest, MergeUniqueLeavesDuplicates) {
+  CountedTree tree = {1, 3, 5, 7}, other = {0, 3, 4, 7, 9};
+  tree.mergeUnique(other);
+  expectTreeEquals(tree, {0, 1, 3, 4, 5, 7, 9});
+  expectTreeEquals(other, {3, 7});
+  other.insert(8);
+  tree.mergeUnique(other);
+  expectTreeEquals(tree, {0, 1, 3, 4, 5, 7, 8, 9});
+  expectTreeEquals(other, {3, 7});
+}
+
+TEST(s21_setTest, ExtractAndMerge) {
+  s21::s21_set<int> hot = {1, 2, 3}, cold = {3, 10};
+  s21::s21_set<int>::node_type node = hot.extract(2);
+  ASSERT_EQ(node.value(), 2);
+  auto result = cold.insert(std::move(node));
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(*result.first, 2);
+
+  result = cold.insert(hot.extract(hot.begin()));
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(hot.size(), 1u);
+
+  hot.merge(cold);
+  ASSERT_EQ(hot, (s21::s21_set<int>{1, 2, 3, 10}));
+  ASSERT_EQ(cold.size(), 1u);
+  ASSERT_TRUE(cold.contains(3));
+}
+
+// Мелкие узлы (3 элемента) заставляют расщеплять, сливать и перекладывать
+// узлы на каждом шаге; содержимое сверяется с std::multiset
+TEST(btreeTest, RandomInsertEraseKeepsInvariants) {
+  std::mt19937 gen(41);
+  std::uniform_int_distribution<int> dist(0, 400);
+  btree<int, std::less<int>, 16> tree;
+  std::multiset<int> reference;
+  for (int step = 0; step < 6000; ++step) {
+    int value = dist(gen);
+    if (step % 3 == 2) {
+      auto victim = tree.lower_bound(value);
+      if (victim == tree.end()) continue;
+      int erased = *victim;
+      reference.erase(reference.find(erased));
+      // erase возвращает следующий элемент, даже если узлы перестроились
+      auto next = tree.erase(victim);
+      auto expected = reference.lower_bound(erased);
+      if (expected == reference.end()) {
+        ASSERT_EQ(next, tree.end());
+      } else {
+        ASSERT_EQ(*next, *expected);
+      }
+    } else {
+      tree.insert(value);
+      reference.insert(value);
+    }
+    if (step % 500 == 0) {
+      ASSERT_TRUE(tree.isBTree());
+    }
+  }
+  ASSERT_TRUE(tree.isBTree());
+  ASSERT_EQ(tree.size(), reference.size());
+  ASSERT_TRUE(std::equal(reference.begin(), reference.end(), tree.begin()));
+
+  for (int key = -1; key <= 401; ++key) {
+    auto lower = tree.lower_bound(key);
+    auto expected = reference.lower_bound(key);
+    if (expected == reference.end()) {
+      ASSERT_EQ(lower, tree.end());
+    } else {
+      ASSERT_EQ(*lower, *expected);
+    }
+    ASSERT_EQ(tree.contains(key), reference.count(key) > 0);
+  }
+}
+
+TEST(btreeTest, BuildSortedAndCopy) {
+  for (int n : {0, 1, 2, 7, 100, 1000, 4097}) {
+    std::vector<std::string> values;
+    for (int i = 0; i < n; ++i) values.push_back(std::to_string(100000 + i));
+    auto tree = btree<std::string>::from_sorted(values.begin(), values.end());
+    ASSERT_TRUE(n == 0 || tree.isBTree());
+    btree<std::string> copy(tree);
+    ASSERT_EQ(copy, tree);
+    ASSERT_EQ(copy.size(), static_cast<size_t>(n));
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), copy.begin()));
+    copy.erase(copy.begin(), copy.lower_bound(std::to_string(100000 + n / 2)));
+    ASSERT_EQ(copy.size(), static_cast<size_t>(n - n / 2));
+  }
+}
+
+TEST(s21_setTest, BTreeBackend) {
+  typedef s21::s21_set<int, std::less<int>, NoAugmentation, BTreeBackend<64>>
+      BTreeSet;
+  BTreeSet set;
+  for (int value = 0; value < 200; ++value) set.insert((value * 37) % 200);
+  ASSERT_EQ(set.size(), 200u);
+  ASSERT_EQ(*set.lower_bound(150), 150);
+  set.erase(150);
+  ASSERT_EQ(*set.upper_bound(149), 151);
+
+  BTreeSet other = {1, 500, 501};
+  ASSERT_EQ(other.insert(set.extract(199)).second, true);
+  set.merge(other);
+  ASSERT_EQ(set.size(), 201u);
+  ASSERT_EQ(other, (BTreeSet{1}));
+}
+
+// Узел с 32-битными связями и цветом в бите индекса родителя
+TEST(CompactRedBlackTreeTest, RandomInsertEraseKeepsInvariants) {
+  std::mt19937 gen(45);
+  std::uniform_int_distribution<int> dist(0, 400);
+  CompactRedBlackTree<int> tree;
+  std::multiset<int> reference;
+  for (int step = 0; step < 6000; ++step) {
+    int value = dist(gen);
+    if (step % 3 == 2) {
+      auto victim = tree.lower_bound(value);
+      if (victim == tree.end()) continue;
+      int erased = *victim;
+      reference.erase(reference.find(erased));
+      // Удаление переносит последний узел массива, но erase всё равно
+      // возвращает следующий по порядку элемент
+      auto next = tree.erase(victim);
+      auto expected = reference.lower_bound(erased);
+      if (expected == reference.end()) {
+        ASSERT_EQ(next, tree.end());
+      } else {
+        ASSERT_EQ(*next, *expected);
+      }
+    } else {
+      tree.insert(value);
+      reference.insert(value);
+    }
+    if (step % 500 == 0) {
+      ASSERT_TRUE(tree.isRedBlackTree());
+    }
+  }
+  ASSERT_TRUE(tree.isRedBlackTree());
+  ASSERT_EQ(tree.size(), reference.size());
+  ASSERT_TRUE(std::equal(reference.begin(), reference.end(), tree.begin()));
+  for (int key = -1; key <= 401; ++key) {
+    ASSERT_EQ(tree.contains(key), reference.count(key) > 0);
+  }
+  tree.erase(tree.begin(), tree.end());
+  ASSERT_TRUE(tree.empty());
+  ASSERT_TRUE(tree.isRedBlackTree());
+  ASSERT_EQ(CompactRedBlackTree<int>::node_bytes(), 16u);
+}
+
+TEST(CompactRedBlackTreeTest, BuildSortedAndCopy) {
+  for (int n : {0, 1, 2, 3, 7, 100, 1000, 4097}) {
+    std::vector<std::string> values;
+    for (int i = 0; i < n; ++i) values.push_back(std::to_string(100000 + i));
+    auto tree = CompactRedBlackTree<std::string>::from_sorted(values.begin(),
+                                                              values.end());
+    ASSERT_TRUE(tree.isRedBlackTree());
+    CompactRedBlackTree<std::string> copy(tree);
+    ASSERT_EQ(copy, tree);
+    ASSERT_TRUE(copy.isRedBlackTree());
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), copy.begin()));
+    copy.erase(copy.begin(), copy.lower_bound(std::to_string(100000 + n / 2)));
+    ASSERT_EQ(copy.size(), static_cast<size_t>(n - n / 2));
+    ASSERT_TRUE(copy.isRedBlackTree());
+  }
+}
+
+TEST(s21_setTest, CompactBackend) {
+  typedef s21::s21_set<int, std::less<int>, NoAugmentation,
+                       CompactRedBlackTreeBackend>
+      CompactSet;
+  CompactSet set;
+  for (int value = 0; value < 200; ++value) set.insert((value * 37) % 200);
+  ASSERT_EQ(set.size(), 200u);
+  ASSERT_EQ(*set.lower_bound(150), 150);
+  set.erase(150);
+  ASSERT_EQ(*set.upper_bound(149), 151);
+
+  CompactSet other = {1, 500, 501};
+  ASSERT_EQ(other.insert(set.extract(199)).second, true);
+  set.merge(other);
+  ASSERT_EQ(set.size(), 201u);
+  ASSERT_EQ(other, (CompactSet{1}));
+}
+
+// Пакетный поиск должен совпадать с поштучным при любом числе ключей,
+// в том числе не кратном ширине пакета и на пустом дереве
+template <typename Set>
+void CheckBatchLookup() {
+  Set empty;
+  int probe = 1;
+  bool found = true;
+  empty.contains_batch(&probe, 1, &found);
+  ASSERT_FALSE(found);
+
+  Set set;
+  for (int value = 0; value < 3000; value += 3) set.insert(value);
+  std::vector<int> keys;
+  for (int i = 0; i < 1001; ++i) keys.push_back(random(-10, 3010));
+  std::unique_ptr<bool[]> hits(new bool[keys.size()]);
+  set.contains_batch(keys.data(), keys.size(), hits.get());
+  std::vector<typename Set::iterator> found_at;
+  set.find_batch(keys.data(), keys.size(), std::back_inserter(found_at));
+  ASSERT_EQ(found_at.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(hits[i], set.contains(keys[i]));
+    if (hits[i]) {
+      ASSERT_EQ(*found_at[i], keys[i]);
+    } else {
+      ASSERT_TRUE(found_at[i] == set.end());
+    }
+  }
+}
+
+TEST(s21_setTest, ContainsAndFindBatch) {
+  CheckBatchLookup<s21::s21_set<int>>();
+  CheckBatchLookup<s21::s21_set<int, std::less<int>, NoAugmentation,
+                                BTreeBackend<64>>>();
+  CheckBatchLookup<s21::s21_set<int, std::less<int>, NoAugmentation,
+                                CompactRedBlackTreeBackend>>();
+}
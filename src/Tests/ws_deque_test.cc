@@ -0,0 +1,84 @@
+#include "../WorkStealing/ws_deque.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(WsDequeTest, OwnerPushPopIsLifo) {
+  s21::ws_deque<int> dq(4);
+  for (int i = 0; i < 3; ++i) dq.push(i);
+  EXPECT_EQ(dq.size_approx(), 3u);
+
+  int value = -1;
+  EXPECT_TRUE(dq.pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(dq.pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(dq.pop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_FALSE(dq.pop(value));
+  EXPECT_TRUE(dq.empty_approx());
+}
+
+TEST(WsDequeTest, StealTakesOldest) {
+  s21::ws_deque<int> dq;
+  dq.push(1);
+  dq.push(2);
+  dq.push(3);
+
+  int value = 0;
+  EXPECT_TRUE(dq.steal(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(dq.pop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_TRUE(dq.steal(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(dq.steal(value));
+}
+
+TEST(WsDequeTest, GrowsWhenFull) {
+  s21::ws_deque<int> dq(2);
+  for (int i = 0; i < 100; ++i) dq.push(i);
+  EXPECT_GE(dq.capacity(), 100u);
+
+  int value = 0;
+  for (int i = 0; i < 50; ++i) {
+    ASSERT_TRUE(dq.steal(value));
+    EXPECT_EQ(value, i);
+  }
+  for (int i = 99; i >= 50; --i) {
+    ASSERT_TRUE(dq.pop(value));
+    EXPECT_EQ(value, i);
+  }
+}
+
+TEST(WsDequeTest, ConcurrentStealersSeeEveryItemOnce) {
+  const int kItems = 100000;
+  const int kThieves = 3;
+  s21::ws_deque<int> dq(8);
+  std::vector<std::atomic<int>> seen(kItems);
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kThieves; ++t) {
+    thieves.emplace_back([&] {
+      int value = 0;
+      while (!done.load() || !dq.empty_approx()) {
+        if (dq.steal(value)) seen[value]++;
+      }
+    });
+  }
+
+  int value = 0;
+  for (int i = 0; i < kItems; ++i) {
+    dq.push(i);
+    if (i % 3 == 0 && dq.pop(value)) seen[value]++;
+  }
+  while (dq.pop(value)) seen[value]++;
+  done = true;
+  for (auto& t : thieves) t.join();
+
+  for (int i = 0; i < kItems; ++i) ASSERT_EQ(seen[i].load(), 1) << i;
+}
@@ -0,0 +1,271 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../Queue/mpmc_queue.h"
+#include "../RBTree/Hardware.h"
+#include "ws_deque.h"
+
+namespace s21 {
+
+// Небольшой планировщик задач с кражей работы. У каждого рабочего потока
+// свой ws_deque: задачи, порождённые внутри задачи, кладутся в него и
+// выполняются в порядке LIFO (горячий кеш), а простаивающие потоки крадут
+// самые старые задачи у соседей. Задачи извне попадают в общую
+// ограниченную mpmc_queue. invoke/parallel_for реализуют fork-join:
+// ожидающий поток не спит, а выполняет чужие задачи.
+class task_scheduler {
+ public:
+  typedef std::size_t size_type;
+
+  explicit task_scheduler(
+      size_type threads = std::thread::hardware_concurrency());
+  ~task_scheduler();
+
+  task_scheduler(const task_scheduler&) = delete;
+  task_scheduler& operator=(const task_scheduler&) = delete;
+
+  size_type thread_count() const { return workers_.size(); }
+
+  // Запускает задачу асинхронно. Исключение из такой задачи
+  // перебрасывается из ближайшего wait_idle().
+  void submit(std::function<void()> task);
+  // Ждёт, пока выполнятся все отправленные задачи. Из задачи этого же
+  // планировщика - std::logic_error: задача ждала бы сама себя
+  void wait_idle();
+
+  // Выполняет f1 и f2 параллельно и возвращается, когда готовы обе
+  template <typename F1, typename F2>
+  void invoke(F1&& f1, F2&& f2);
+
+  // Вызывает fn(i) для i из [first, last), деля диапазон пополам,
+  // пока кусок больше grain
+  template <typename Index, typename Fn>
+  void parallel_for(Index first, Index last, Index grain, const Fn& fn);
+
+ private:
+  struct Task {
+    std::function<void()> fn;
+  };
+
+  struct Worker {
+    ws_deque<Task*> deque;
+    std::thread thread;
+  };
+
+  struct Context {
+    task_scheduler* owner;
+    size_type index;
+  };
+
+  static constexpr size_type kInjectionCapacity = 1024;
+  static constexpr int kIdleSpins = 64;
+
+  static Context*& current() {
+    static thread_local Context* context = nullptr;
+    return context;
+  }
+  // Планировщик, чью задачу сейчас выполняет этот поток. Задачи
+  // выполняют и ожидающие потоки, поэтому current() тут не подходит
+  static const task_scheduler*& running() {
+    static thread_local const task_scheduler* scheduler = nullptr;
+    return scheduler;
+  }
+  Worker* own_worker() const;
+
+  void spawn(Task* task);
+  bool try_take(Task*& task, size_type hint);
+  bool run_one(size_type hint);
+  void execute(Task* task);
+  void worker_loop(size_type index);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  mpmc_queue<Task*> injection_;
+
+  std::atomic<size_type> pending_;    // лежат в очередях
+  std::atomic<size_type> unfinished_;  // отправлены и ещё не завершены
+  std::atomic<size_type> sleeping_;
+  std::atomic<bool> stop_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  std::exception_ptr error_;
+};
+
+inline task_scheduler::task_scheduler(size_type threads)
+    : injection_(kInjectionCapacity),
+      pending_(0),
+      unfinished_(0),
+      sleeping_(0),
+      stop_(false) {
+  if (threads == 0) threads = 1;
+  for (size_type i = 0; i < threads; ++i)
+    workers_.push_back(std::make_unique<Worker>());
+  for (size_type i = 0; i < threads; ++i)
+    workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+}
+
+inline task_scheduler::~task_scheduler() {
+  try {
+    wait_idle();
+  } catch (...) {
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true);
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) worker->thread.join();
+}
+
+inline task_scheduler::Worker* task_scheduler::own_worker() const {
+  Context* context = current();
+  if (context && context->owner == this)
+    return workers_[context->index].get();
+  return nullptr;
+}
+
+inline void task_scheduler::submit(std::function<void()> task) {
+  unfinished_.fetch_add(1);
+  spawn(new Task{std::move(task)});
+}
+
+inline void task_scheduler::spawn(Task* task) {
+  pending_.fetch_add(1);
+  if (Worker* worker = own_worker())
+    worker->deque.push(task);
+  else
+    injection_.push(task);
+  if (sleeping_.load() != 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_one();
+  }
+}
+
+inline bool task_scheduler::try_take(Task*& task, size_type hint) {
+  if (Worker* worker = own_worker()) {
+    if (worker->deque.pop(task)) return true;
+  }
+  if (injection_.try_pop(task)) return true;
+  size_type n = workers_.size();
+  for (size_type i = 0; i < n; ++i) {
+    if (workers_[(hint + i) % n]->deque.steal(task)) return true;
+  }
+  return false;
+}
+
+inline void task_scheduler::execute(Task* task) {
+  pending_.fetch_sub(1);
+  const task_scheduler* outer = std::exchange(running(), this);
+  try {
+    task->fn();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) error_ = std::current_exception();
+  }
+  running() = outer;
+  delete task;
+  if (unfinished_.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.notify_all();
+  }
+}
+
+inline bool task_scheduler::run_one(size_type hint) {
+  Task* task = nullptr;
+  if (!try_take(task, hint)) return false;
+  execute(task);
+  return true;
+}
+
+inline void task_scheduler::worker_loop(size_type index) {
+  Context context{this, index};
+  current() = &context;
+  size_type victim = index + 1;
+  while (!stop_.load(std::memory_order_relaxed)) {
+    bool found = false;
+    for (int i = 0; i < kIdleSpins && !found; ++i) {
+      found = run_one(victim++);
+      if (!found) detail::cpu_relax();
+    }
+    if (found) continue;
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.fetch_add(1);
+    wake_.wait(lock, [this] { return stop_.load() || pending_.load() != 0; });
+    sleeping_.fetch_sub(1);
+  }
+  current() = nullptr;
+}
+
+inline void task_scheduler::wait_idle() {
+  // unfinished_ учитывает и вызывающую задачу, ноль не наступил бы никогда
+  if (running() == this) {
+    throw std::logic_error("wait_idle called from a task of this scheduler");
+  }
+  size_type hint = 0;
+  // Пока есть работа, помогаем её выполнять, а не просто ждём
+  while (unfinished_.load() != 0 && run_one(hint++)) {
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return unfinished_.load() == 0; });
+  if (error_) {
+    std::exception_ptr error = std::exchange(error_, nullptr);
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename F1, typename F2>
+void task_scheduler::invoke(F1&& f1, F2&& f2) {
+  std::atomic<bool> done(false);
+  std::exception_ptr error;
+  unfinished_.fetch_add(1);
+  spawn(new Task{[&] {
+    try {
+      f2();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    done.store(true, std::memory_order_release);
+  }});
+  std::exception_ptr own_error;
+  try {
+    f1();
+  } catch (...) {
+    own_error = std::current_exception();
+  }
+  size_type hint = own_worker() ? 1 : 0;
+  while (!done.load(std::memory_order_acquire)) {
+    if (!run_one(hint++)) std::this_thread::yield();
+  }
+  if (own_error) std::rethrow_exception(own_error);
+  if (error) std::rethrow_exception(error);
+}
+
+template <typename Index, typename Fn>
+void task_scheduler::parallel_for(Index first, Index last, Index grain,
+                                  const Fn& fn) {
+  if (grain < 1) grain = 1;
+  if (last - first <= grain) {
+    for (Index i = first; i < last; ++i) fn(i);
+    return;
+  }
+  Index middle = first + (last - first) / 2;
+  invoke([&] { parallel_for(first, middle, grain, fn); },
+         [&] { parallel_for(middle, last, grain, fn); });
+}
+
+}  // namespace s21
+
+#endif  // TASK_SCHEDULER_H
@@ -0,0 +1,150 @@
+#ifndef WS_DEQUE_H
+#define WS_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+// Дек для кражи работы (Chase-Lev, с порядками памяти по Lê et al., 2013).
+// Владелец кладёт и забирает элементы снизу (push/pop) без блокировок и,
+// как правило, без атомарных RMW; остальные потоки крадут сверху (steal)
+// одним CAS. Кольцевой буфер растёт вдвое при заполнении. Старые буферы
+// могут ещё читаться ворами, поэтому освобождаются только в деструкторе.
+// T должен быть тривиально копируемым (обычно это указатель на задачу).
+template <typename T>
+class ws_deque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "ws_deque stores T in atomics: T must be trivially copyable");
+
+ public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+
+  explicit ws_deque(size_type capacity = 64);
+  ~ws_deque();
+
+  ws_deque(const ws_deque&) = delete;
+  ws_deque& operator=(const ws_deque&) = delete;
+
+  void push(T value);    // только владелец
+  bool pop(T& value);    // только владелец
+  bool steal(T& value);  // любой поток
+
+  size_type size_approx() const;
+  bool empty_approx() const { return size_approx() == 0; }
+  size_type capacity() const {
+    return array_.load(std::memory_order_relaxed)->capacity;
+  }
+
+ private:
+  struct Array {
+    size_type capacity;
+    std::atomic<T>* slots;
+
+    explicit Array(size_type n) : capacity(n), slots(new std::atomic<T>[n]) {}
+    ~Array() { delete[] slots; }
+
+    T get(std::int64_t i) const {
+      return slots[static_cast<size_type>(i) & (capacity - 1)].load(
+          std::memory_order_relaxed);
+    }
+    void put(std::int64_t i, T value) {
+      slots[static_cast<size_type>(i) & (capacity - 1)].store(
+          value, std::memory_order_relaxed);
+    }
+  };
+
+  Array* grow(Array* old, std::int64_t top, std::int64_t bottom);
+
+  std::atomic<std::int64_t> top_;
+  std::atomic<std::int64_t> bottom_;
+  std::atomic<Array*> array_;
+  std::vector<Array*> retired_;  // только владелец
+};
+
+template <typename T>
+ws_deque<T>::ws_deque(size_type capacity) : top_(0), bottom_(0) {
+  size_type rounded = 2;
+  while (rounded < capacity) rounded <<= 1;
+  array_.store(new Array(rounded), std::memory_order_relaxed);
+}
+
+template <typename T>
+ws_deque<T>::~ws_deque() {
+  delete array_.load(std::memory_order_relaxed);
+  for (Array* a : retired_) delete a;
+}
+
+template <typename T>
+typename ws_deque<T>::Array* ws_deque<T>::grow(Array* old, std::int64_t top,
+                                               std::int64_t bottom) {
+  Array* bigger = new Array(old->capacity * 2);
+  for (std::int64_t i = top; i < bottom; ++i) bigger->put(i, old->get(i));
+  retired_.push_back(old);
+  array_.store(bigger, std::memory_order_release);
+  return bigger;
+}
+
+template <typename T>
+void ws_deque<T>::push(T value) {
+  std::int64_t b = bottom_.load(std::memory_order_relaxed);
+  std::int64_t t = top_.load(std::memory_order_acquire);
+  Array* a = array_.load(std::memory_order_relaxed);
+  if (b - t > static_cast<std::int64_t>(a->capacity) - 1) a = grow(a, t, b);
+  a->put(b, value);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool ws_deque<T>::pop(T& value) {
+  std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  Array* a = array_.load(std::memory_order_relaxed);
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::int64_t t = top_.load(std::memory_order_relaxed);
+  if (t > b) {
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return false;
+  }
+  value = a->get(b);
+  if (t == b) {
+    // Последний элемент: соревнуемся с ворами за него
+    bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return won;
+  }
+  return true;
+}
+
+template <typename T>
+bool ws_deque<T>::steal(T& value) {
+  std::int64_t t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::int64_t b = bottom_.load(std::memory_order_acquire);
+  if (t >= b) return false;
+  Array* a = array_.load(std::memory_order_acquire);
+  T candidate = a->get(t);
+  if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed))
+    return false;
+  value = candidate;
+  return true;
+}
+
+template <typename T>
+typename ws_deque<T>::size_type ws_deque<T>::size_approx() const {
+  std::int64_t b = bottom_.load(std::memory_order_relaxed);
+  std::int64_t t = top_.load(std::memory_order_relaxed);
+  return b > t ? static_cast<size_type>(b - t) : 0;
+}
+
+}  // namespace s21
+
+#endif  // WS_DEQUE_H
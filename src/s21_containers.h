@@ -3,6 +3,8 @@
 
 #include "List/list.h"
 #include "Map/map.h"
+#include "PriorityQueue/indexed_priority_queue.h"
+#include "PriorityQueue/priority_queue.h"
 #include "Queue/queue.h"
 #include "Set/set.h"
 #include "Stack/stack.h"
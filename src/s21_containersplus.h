@@ -2,6 +2,22 @@
 #define S21_CONTAINERSPLUS_H
 
 #include "Array/array.h"
+#include "BTree/btree.h"
+#include "Concurrent/concurrent_set.h"
+#include "Flat/flat_map.h"
+#include "Flat/flat_set.h"
+#include "Interval/interval_tree.h"
 #include "Multiset/multiset.h"
+#include "Persistent/persistent_map.h"
+#include "Persistent/persistent_set.h"
+#include "Queue/blocking_queue.h"
+#include "Queue/mpmc_queue.h"
+#include "RBTree/CompactRedBlackTree.h"
+#include "Snapshot/map_view.h"
+#include "Snapshot/snapshot.h"
+#include "Static/static_ordered_map.h"
+#include "Static/static_ordered_set.h"
+#include "WorkStealing/task_scheduler.h"
+#include "WorkStealing/ws_deque.h"
 
 #endif